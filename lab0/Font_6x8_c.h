@@ -0,0 +1,168 @@
+/*----------------------------------------------------------------------------
+ * Name:    Font_6x8_c.h
+ * Purpose: Font_6x8_h.h compiled by host/font_compiler.c
+ *          (112 characters of 6x8 pixels, 738 bytes instead of 896)
+ *          Do not edit, compile the font table again instead.
+ *----------------------------------------------------------------------------*/
+
+#ifndef __FONT_6X8_C_H
+#define __FONT_6X8_C_H
+
+static const GLCD_GLYPH Font_6x8_glyphs[] = {
+  { 0x00,  0,  0 },   /* 0x20: Space ' ' */
+  { 0x20,  0,  7 },   /* 0x21: '!' */
+  { 0x12,  0,  3 },   /* 0x22: '"' */
+  { 0x04,  0,  7 },   /* 0x23: '#' */
+  { 0x04,  0,  7 },   /* 0x24: '$' */
+  { 0x04,  0,  7 },   /* 0x25: '%' */
+  { 0x04,  0,  7 },   /* 0x26: '&' */
+  { 0x12,  0,  4 },   /* 0x27: ''' */
+  { 0x12,  0,  7 },   /* 0x28: '(' */
+  { 0x12,  0,  7 },   /* 0x29: ')' */
+  { 0x04,  1,  6 },   /* 0x2A: '*' */
+  { 0x04,  1,  5 },   /* 0x2B: '+' */
+  { 0x12,  4,  4 },   /* 0x2C: ',' */
+  { 0x04,  3,  1 },   /* 0x2D: '-' */
+  { 0x21,  5,  2 },   /* 0x2E: '.' */
+  { 0x04,  1,  5 },   /* 0x2F: '/' */
+  { 0x04,  0,  7 },   /* 0x30: '0' */
+  { 0x12,  0,  7 },   /* 0x31: '1' */
+  { 0x04,  0,  7 },   /* 0x32: '2' */
+  { 0x04,  0,  7 },   /* 0x33: '3' */
+  { 0x04,  0,  7 },   /* 0x34: '4' */
+  { 0x04,  0,  7 },   /* 0x35: '5' */
+  { 0x04,  0,  7 },   /* 0x36: '6' */
+  { 0x04,  0,  7 },   /* 0x37: '7' */
+  { 0x04,  0,  7 },   /* 0x38: '8' */
+  { 0x04,  0,  7 },   /* 0x39: '9' */
+  { 0x20,  2,  3 },   /* 0x3A: ':' */
+  { 0x11,  2,  5 },   /* 0x3B: ';' */
+  { 0x13,  0,  7 },   /* 0x3C: '<' */
+  { 0x04,  2,  3 },   /* 0x3D: '=' */
+  { 0x13,  0,  7 },   /* 0x3E: '>' */
+  { 0x04,  0,  7 },   /* 0x3F: '?' */
+  { 0x04,  0,  7 },   /* 0x40: '@' */
+  { 0x04,  0,  7 },   /* 0x41: 'A' */
+  { 0x04,  0,  7 },   /* 0x42: 'B' */
+  { 0x04,  0,  7 },   /* 0x43: 'C' */
+  { 0x04,  0,  7 },   /* 0x44: 'D' */
+  { 0x04,  0,  7 },   /* 0x45: 'E' */
+  { 0x04,  0,  7 },   /* 0x46: 'F' */
+  { 0x04,  0,  7 },   /* 0x47: 'G' */
+  { 0x04,  0,  7 },   /* 0x48: 'H' */
+  { 0x12,  0,  7 },   /* 0x49: 'I' */
+  { 0x04,  0,  7 },   /* 0x4A: 'J' */
+  { 0x04,  0,  7 },   /* 0x4B: 'K' */
+  { 0x04,  0,  7 },   /* 0x4C: 'L' */
+  { 0x04,  0,  7 },   /* 0x4D: 'M' */
+  { 0x04,  0,  7 },   /* 0x4E: 'N' */
+  { 0x04,  0,  7 },   /* 0x4F: 'O' */
+  { 0x04,  0,  7 },   /* 0x50: 'P' */
+  { 0x04,  0,  7 },   /* 0x51: 'Q' */
+  { 0x04,  0,  7 },   /* 0x52: 'R' */
+  { 0x04,  0,  7 },   /* 0x53: 'S' */
+  { 0x04,  0,  7 },   /* 0x54: 'T' */
+  { 0x04,  0,  7 },   /* 0x55: 'U' */
+  { 0x04,  0,  7 },   /* 0x56: 'V' */
+  { 0x04,  0,  7 },   /* 0x57: 'W' */
+  { 0x04,  0,  7 },   /* 0x58: 'X' */
+  { 0x04,  0,  7 },   /* 0x59: 'Y' */
+  { 0x04,  0,  7 },   /* 0x5A: 'Z' */
+  { 0x13,  0,  7 },   /* 0x5B: '[' */
+  { 0x04,  1,  5 },   /* 0x5C: '\' */
+  { 0x13,  0,  7 },   /* 0x5D: ']' */
+  { 0x04,  0,  3 },   /* 0x5E: '^' */
+  { 0x04,  6,  1 },   /* 0x5F: '_' */
+  { 0x12,  0,  4 },   /* 0x60: ''' */
+  { 0x04,  2,  5 },   /* 0x61: 'a' */
+  { 0x04,  0,  7 },   /* 0x62: 'b' */
+  { 0x04,  2,  5 },   /* 0x63: 'c' */
+  { 0x04,  0,  7 },   /* 0x64: 'd' */
+  { 0x04,  2,  5 },   /* 0x65: 'e' */
+  { 0x13,  0,  7 },   /* 0x66: 'f' */
+  { 0x04,  2,  6 },   /* 0x67: 'g' */
+  { 0x04,  0,  7 },   /* 0x68: 'h' */
+  { 0x12,  0,  7 },   /* 0x69: 'i' */
+  { 0x03,  0,  7 },   /* 0x6A: 'j' */
+  { 0x03,  0,  7 },   /* 0x6B: 'k' */
+  { 0x12,  0,  7 },   /* 0x6C: 'l' */
+  { 0x04,  2,  5 },   /* 0x6D: 'm' */
+  { 0x04,  2,  5 },   /* 0x6E: 'n' */
+  { 0x04,  2,  5 },   /* 0x6F: 'o' */
+  { 0x04,  2,  6 },   /* 0x70: 'p' */
+  { 0x04,  2,  6 },   /* 0x71: 'q' */
+  { 0x04,  2,  5 },   /* 0x72: 'r' */
+  { 0x04,  2,  5 },   /* 0x73: 's' */
+  { 0x04,  0,  7 },   /* 0x74: 't' */
+  { 0x04,  2,  5 },   /* 0x75: 'u' */
+  { 0x04,  2,  5 },   /* 0x76: 'v' */
+  { 0x04,  2,  5 },   /* 0x77: 'w' */
+  { 0x04,  2,  5 },   /* 0x78: 'x' */
+  { 0x04,  2,  6 },   /* 0x79: 'y' */
+  { 0x04,  2,  5 },   /* 0x7A: 'z' */
+  { 0x12,  0,  7 },   /* 0x7B: '{' */
+  { 0x20,  0,  7 },   /* 0x7C: '|' */
+  { 0x12,  0,  7 },   /* 0x7D: '}' */
+  { 0x04,  0,  3 },   /* 0x7E: '~' */
+  { 0x00,  0,  0 },   /* 0x7F: ' ' */
+  { 0x13,  2,  4 },   /* 0x80: Circle - Empty */
+  { 0x13,  2,  4 },   /* 0x81: Circle - Full */
+  { 0x13,  2,  4 },   /* 0x82: Square - Empty */
+  { 0x13,  2,  4 },   /* 0x83: Square - Full */
+  { 0x13,  2,  4 },   /* 0x84: Up - Empty */
+  { 0x13,  2,  4 },   /* 0x85: Up - Full */
+  { 0x13,  2,  4 },   /* 0x86: Down - Empty */
+  { 0x13,  2,  4 },   /* 0x87: Down - Full */
+  { 0x13,  2,  4 },   /* 0x88: Left - Empty */
+  { 0x13,  2,  4 },   /* 0x89: Left - Full */
+  { 0x13,  2,  4 },   /* 0x8A: Right - Empty */
+  { 0x13,  2,  4 },   /* 0x8B: Right - Full */
+  { 0x13,  2,  4 },   /* 0x8C: Wait - Empty */
+  { 0x13,  2,  4 },   /* 0x8D: Wait - Full */
+  { 0x13,  2,  4 },   /* 0x8E: Walk - Empty */
+  { 0x13,  2,  4 }    /* 0x8F: Walk - Full */
+};
+
+static const unsigned short Font_6x8_index[] = {
+  0, 168, 311, 577, 766, 1046, 1312, 1592,
+  1798, 2013, 2221, 2441, 2585, 2713
+};
+
+static const unsigned char Font_6x8_bits[] = {
+  0xFB, 0x6D, 0x52, 0xBE, 0xAF, 0xA9, 0x44, 0xF1, 0x5D, 0x47, 0x90, 0x73,
+  0x41, 0x05, 0x9C, 0x08, 0xA5, 0x15, 0x53, 0x6D, 0x91, 0x88, 0x92, 0xA1,
+  0x52, 0x44, 0x49, 0x57, 0x3A, 0xA4, 0x21, 0x3E, 0x42, 0x6C, 0x8F, 0xFE,
+  0x08, 0x20, 0x82, 0xE8, 0xCE, 0xB9, 0x8B, 0x93, 0x49, 0x2E, 0xE8, 0xC1,
+  0xC1, 0x0F, 0xFF, 0x04, 0x32, 0x11, 0x72, 0x18, 0xA4, 0xFD, 0x08, 0xF8,
+  0x5F, 0x08, 0x45, 0xDC, 0x10, 0x5F, 0x18, 0xBB, 0xF0, 0x82, 0x08, 0x20,
+  0xBA, 0x31, 0x74, 0x62, 0xE7, 0x46, 0x3E, 0x82, 0x0F, 0x62, 0x98, 0x42,
+  0x12, 0x48, 0xF8, 0x3E, 0x24, 0x90, 0x84, 0x2E, 0x8C, 0x18, 0x40, 0x11,
+  0xD1, 0xAF, 0x5A, 0x1F, 0x11, 0x51, 0x8F, 0xE3, 0x17, 0xC6, 0x2F, 0x8C,
+  0x5E, 0xE8, 0x84, 0x21, 0x8B, 0x9F, 0x18, 0xC6, 0x31, 0x7F, 0xC2, 0x17,
+  0x84, 0x3F, 0xF8, 0x42, 0xF0, 0x84, 0x3E, 0x88, 0x43, 0x98, 0xFA, 0x31,
+  0x8F, 0xE3, 0x18, 0xF4, 0x92, 0x5F, 0x88, 0x42, 0x10, 0x93, 0x45, 0x25,
+  0x19, 0x53, 0x10, 0x84, 0x21, 0x08, 0x7F, 0x1D, 0xD6, 0xB5, 0x8C, 0x63,
+  0x19, 0xD7, 0x31, 0x8B, 0xA3, 0x18, 0xC6, 0x2E, 0x7C, 0x62, 0xF0, 0x84,
+  0x2E, 0x8C, 0x63, 0x54, 0xD9, 0xF1, 0x8B, 0xCA, 0x98, 0xBA, 0x21, 0x74,
+  0x22, 0xEF, 0xD4, 0x84, 0x21, 0x09, 0x18, 0xC6, 0x31, 0x8B, 0xA3, 0x18,
+  0xC6, 0x2A, 0x24, 0x63, 0x1A, 0xD6, 0xAA, 0x8C, 0x54, 0x45, 0x46, 0x31,
+  0x8A, 0x88, 0x42, 0x13, 0xF0, 0x43, 0x84, 0x1F, 0xF8, 0x88, 0x88, 0xF8,
+  0x44, 0x44, 0x43, 0xE2, 0x22, 0x23, 0xC8, 0xA8, 0xFD, 0xB5, 0x0C, 0x87,
+  0x27, 0xC1, 0x0B, 0x67, 0x19, 0xB5, 0xD1, 0x0C, 0x5D, 0x08, 0x5B, 0x31,
+  0xCD, 0x9D, 0x1F, 0x85, 0xC9, 0x44, 0xE4, 0x44, 0xEC, 0xE6, 0xD0, 0x70,
+  0x42, 0xD9, 0xC6, 0x31, 0x41, 0xA4, 0xBC, 0x04, 0x44, 0x4B, 0x08, 0xCA,
+  0x9A, 0xCB, 0x49, 0x25, 0xD7, 0x5A, 0xD6, 0xAD, 0x9C, 0x63, 0x17, 0x46,
+  0x31, 0x73, 0x67, 0x36, 0x84, 0x36, 0xCE, 0x6D, 0x08, 0x36, 0x61, 0x08,
+  0x7C, 0x17, 0x41, 0xE4, 0x27, 0xC8, 0x4A, 0x22, 0x31, 0x8E, 0x6D, 0x18,
+  0xC5, 0x44, 0x8C, 0x6B, 0x55, 0x45, 0x44, 0x54, 0x63, 0x1F, 0x42, 0x2E,
+  0xFA, 0x08, 0x2F, 0xC4, 0x8A, 0x53, 0xB9, 0x4A, 0x24, 0x45, 0x54, 0x34,
+  0xCB, 0x37, 0xFB, 0x7C, 0xCF, 0xFF, 0xFF, 0xB3, 0x4F, 0xB3, 0x7F, 0xFC,
+  0xB3, 0x7F, 0xB3, 0x65, 0xDE, 0x67, 0xFE, 0x1E, 0xE9, 0x9F, 0xF9, 0xB4,
+  0xCB, 0x37, 0xFB, 0x7C, 0xCF, 0xFF, 0xFF, 0x80, 0x00, 0x00
+};
+
+static const GLCD_FONT Font_6x8 = {
+  6, 8, 0x20, 112, Font_6x8_glyphs, Font_6x8_index, Font_6x8_bits
+};
+
+#endif /* __FONT_6X8_C_H */
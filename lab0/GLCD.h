@@ -50,6 +50,28 @@
 #define Line8           ( 8*24)
 #define Line9           ( 9*24)
 
+/*------------------------------------------------------------------------------
+  Compiled fonts (made from the Font_*_h.h tables by host/font_compiler.c)
+  Only the box around the set pixels of each character is kept, one bit per
+  pixel, row after row, first bit = most significant; bit i of a row of the
+  box is column left+i of the character.
+ *----------------------------------------------------------------------------*/
+
+typedef struct {
+  unsigned char  box;                   /* Left column << 4 | box width - 1   */
+  unsigned char  top;                   /* First row of the box               */
+  unsigned char  rows;                  /* Rows of the box, 0 if blank        */
+} GLCD_GLYPH;
+
+typedef struct {
+  unsigned char         w, h;           /* Character size (w at most 16)      */
+  unsigned char         first;          /* First character in the font        */
+  unsigned char         num;            /* Number of characters               */
+  const GLCD_GLYPH     *glyph;          /* Box of each character              */
+  const unsigned short *index;          /* First bit of every 8th character   */
+  const unsigned char  *bits;           /* Boxes, 2 spare bytes at the end    */
+} GLCD_FONT;
+
 extern void GLCD_Init           (void);
 extern void GLCD_WindowMax      (void);
 extern void GLCD_PutPixel       (unsigned int x, unsigned int y);
@@ -64,5 +86,11 @@ extern void GLCD_Bargraph       (unsigned int x, unsigned int y, unsigned int w,
 extern void GLCD_Bitmap         (unsigned int x, unsigned int y, unsigned int w, unsigned int h, unsigned char *bitmap);
 extern void GLCD_Bmp            (unsigned int x, unsigned int y, unsigned int w, unsigned int h, unsigned char *bmp);
 extern void GLCD_ScrollVertical (unsigned int dy);
+extern void GLCD_SetDoneCallback(void (*done)(void));
+extern int  GLCD_Busy           (void);
+extern void GLCD_WaitDone       (void);
+extern void GLCD_TextClear      (unsigned short color);
+extern void GLCD_TextString     (unsigned int ln, unsigned int col, unsigned char *s);
+extern unsigned int GLCD_TextFlush (void);
 
 #endif /* _GLCD_H */
@@ -12,8 +12,8 @@
 
 #include <lpc17xx.h>
 #include "GLCD.h"
-#include "Font_6x8_h.h"
-#include "Font_16x24_h.h"
+#include "Font_6x8_c.h"
+#include "Font_16x24_c.h"
 
 /************************** Orientation  configuration ************************/
 
@@ -35,9 +35,13 @@
 
 /* SPI_SR - bit definitions                                                   */
 #define TFE         0x01
+#define TNF         0x02
 #define RNE         0x04
 #define BSY         0x10
 
+/* SSP_CR0 - data size select bits (frame size in bits - 1)                   */
+#define DSS         0x0F
+
 /*------------------------- Speed dependant settings -------------------------*/
 
 /* If processor works on high frequency delay has to be increased, it can be 
@@ -55,6 +59,66 @@
 #endif
 #define BPP         16                  /* Bits per pixel                     */
 #define BYPP        ((BPP+7)/8)         /* Bytes per pixel                    */
+#define TEXT_COLS   (WIDTH/16)          /* Columns of 16x24 characters        */
+#define TEXT_LINES  (HEIGHT/24)         /* Lines of 16x24 characters          */
+
+/*---------------------------- DMA configuration -----------------------------*/
+
+/* If GLCD_DMA = 1, GLCD_Clear, GLCD_Bitmap and GLCD_Bmp hand the pixels to
+   the GPDMA controller and return while they are being sent; the next GLCD
+   function waits for the transfer to finish. If GLCD_DMA = 0, the CPU sends
+   every pixel itself.                                                        */
+#ifndef GLCD_DMA
+#define GLCD_DMA    1
+#endif
+
+#define DMA_CH      LPC_GPDMACH7        /* GPDMA channel used for SSP1 Tx     */
+#define DMA_CH_BIT  (1 << 7)            /* Bit of the channel in DMACInt...   */
+#define DMA_SSP1_TX 2                   /* GPDMA request line of SSP1 Tx      */
+#define DMA_CHUNK   4080                /* Pixels per descriptor (max 4095)   */
+#define DMA_LLI_NUM ((WIDTH*HEIGHT+DMA_CHUNK-1)/DMA_CHUNK)
+
+/* The GPDMA cannot reach the local SRAM at 0x10000000, so the descriptors
+   and the fill color are kept at the start of the AHB SRAM (IRAM2, which is
+   in the project's memory layout), and bitmaps in the local SRAM are sent by
+   the CPU                                                                    */
+#define DMA_RAM     0x2007C000
+#define DMA_REACH(p) ((unsigned int)(p) < 0x10000000 || (unsigned int)(p) >= DMA_RAM)
+
+/* DMACCControl - bit definitions                                             */
+#define DMA_SB4     (1 << 12)           /* Source burst size 4                */
+#define DMA_DB4     (1 << 15)           /* Destination burst size 4           */
+#define DMA_SW16    (1 << 18)           /* Source width 16 bits               */
+#define DMA_DW16    (1 << 21)           /* Destination width 16 bits          */
+#define DMA_SI      (1 << 26)           /* Source increment                   */
+#define DMA_TCI     (1UL << 31)         /* Terminal count interrupt           */
+
+/* DMACCConfig - bit definitions                                              */
+#define DMA_E       (1 << 0)            /* Channel enable                     */
+#define DMA_M2P     (1 << 11)           /* Memory to peripheral               */
+#define DMA_IE      (1 << 14)           /* Error interrupt mask               */
+#define DMA_ITC     (1 << 15)           /* Terminal count interrupt mask      */
+
+/* GRAM entry mode set by GLCD_Init, restored after a reversed transfer      */
+#if (HORIZONTAL == 1)
+#define ENTRY_MODE  0x1038
+#else
+#define ENTRY_MODE  0x1030
+#endif
+
+/*------------------------- Glyph cache configuration ------------------------*/
+
+/* The 16x24 font characters are drawn from runs of background and text
+   pixels, worked out from the font the first time each character is drawn
+   and kept in a cache of GLCD_GLYPHS bytes (about 44 bytes per character,
+   4.9 KB for the whole font). A character that no longer fits is drawn
+   from the font bit by bit. If GLCD_GLYPHS = 0, there is no cache.          */
+#ifndef GLCD_GLYPHS
+#define GLCD_GLYPHS 2048
+#endif
+
+#define GLYPH_NUM   (sizeof(Font_16x24_glyphs)/sizeof(Font_16x24_glyphs[0]))
+#define GLYPH_NONE  0xFFFF              /* Character does not fit the cache   */
 
 /*--------------- Graphic LCD interface hardware definitions -----------------*/
 
@@ -72,6 +136,52 @@
 /******************************************************************************/
 static volatile unsigned short TextColor = Black, BackColor = White;
 
+/* Cell of the 16x24 character grid; c = 0 if the cell is not known to hold
+   a character (nothing has been put there, or it has been drawn over)        */
+typedef struct {
+  unsigned short fg;                    /* Foreground color (bg for a space)  */
+  unsigned short bg;                    /* Background color                   */
+  unsigned char  c;                     /* Character                          */
+} TEXT_CELL;
+
+static TEXT_CELL TextShown [TEXT_LINES][TEXT_COLS];   /* What is on display   */
+static TEXT_CELL TextWanted[TEXT_LINES][TEXT_COLS];   /* What should be       */
+
+#define TEXT_SAME(a, b) ((a)->c == (b)->c && (a)->fg == (b)->fg && (a)->bg == (b)->bg)
+
+#if (GLCD_GLYPHS > 0)
+/* Runs of each cached character, alternately background and text pixels,
+   starting with background; the runs of a character add up to 16*24. The
+   runs of character idx start at GlyphRuns[GlyphAt[idx]-1]; GlyphAt[idx] is
+   0 if they have not been built yet                                          */
+static unsigned char  GlyphRuns[GLCD_GLYPHS];
+static unsigned short GlyphAt[GLYPH_NUM];
+static unsigned int   GlyphUsed;              /* Bytes of GlyphRuns in use    */
+#endif
+
+/* Called when a GLCD_Clear, GLCD_Bitmap or GLCD_Bmp transfer has finished   */
+static void (*volatile DoneCallback)(void);
+
+#if (GLCD_DMA == 1)
+/* GPDMA linked list item                                                     */
+typedef struct {
+  unsigned int src;                     /* Source address                     */
+  unsigned int dst;                     /* Destination address                */
+  unsigned int lli;                     /* Next item, or 0 for the last one   */
+  unsigned int ctrl;                    /* DMACCControl for this item         */
+} DMA_LLI;
+
+static struct {
+  DMA_LLI                 lli[DMA_LLI_NUM];  /* Descriptors of the transfer   */
+  volatile unsigned short fill;              /* Source of GLCD_Clear          */
+} DmaRam __attribute__((at(DMA_RAM), zero_init));
+
+static volatile int DmaBusy;            /* 1 while a transfer is in progress  */
+static volatile int DmaEntry;           /* Entry mode to restore after it     */
+
+static void dma_wait (void);
+#endif
+
 
 /************************ Local auxiliary functions ***************************/
 
@@ -110,6 +220,9 @@ static __inline unsigned char spi_send (unsigned char byte) {
 
 static __inline void wr_cmd (unsigned char cmd) {
 
+#if (GLCD_DMA == 1)
+  dma_wait();                           /* SSP1 is busy until DMA is done     */
+#endif
   LCD_CS(0)
   spi_send(SPI_START | SPI_WR | SPI_INDEX);   /* Write : RS = 0, RW = 0       */
   spi_send(0);
@@ -144,6 +257,8 @@ static __inline void wr_dat_start (void) {
 
   LCD_CS(0)
   spi_send(SPI_START | SPI_WR | SPI_DATA);    /* Write : RS = 1, RW = 0       */
+  /* Pixels are sent as 16 bit frames (D8..D15 first)                         */
+  LPC_SSP1->CR0 = (LPC_SSP1->CR0 & ~DSS) | (16-1);
 }
 
 
@@ -154,22 +269,95 @@ static __inline void wr_dat_start (void) {
 *******************************************************************************/
 
 static __inline void wr_dat_stop (void) {
-
+  unsigned short dummy;
+
+  while (LPC_SSP1->SR & BSY);           /* Wait for the Tx FIFO to drain      */
+  while (LPC_SSP1->SR & RNE)            /* Drop what was received meanwhile   */
+    dummy = LPC_SSP1->DR;
+  (void)dummy;
+  LPC_SSP1->ICR = 0x01;                 /* Clear receive overrun              */
+  LPC_SSP1->CR0 = (LPC_SSP1->CR0 & ~DSS) | (8-1);
   LCD_CS(1)
 }
 
 
 /*******************************************************************************
-* Data writing to the LCD controller                                           *
+* Data writing to the LCD controller (between wr_dat_start and wr_dat_stop);   *
+* only waits for room in the Tx FIFO, so up to 8 pixels are queued while the   *
+* CPU works out the next ones, and the frames received meanwhile are dropped   *
+* by wr_dat_stop                                                               *
 *   Parameter:    dat:    data to be written                                   *
 *   Return:                                                                    *
 *******************************************************************************/
 
 static __inline void wr_dat_only (unsigned short dat) {
 
-  spi_send((dat >>   8));                     /* Write D8..D15                */
-  spi_send((dat & 0xFF));                     /* Write D0..D7                 */
+  while (!(LPC_SSP1->SR & TNF));        /* Wait for room in the Tx FIFO       */
+  LPC_SSP1->DR = dat;                   /* Write D8..D15, D0..D7              */
+}
+
+
+/*******************************************************************************
+* Data writing of the same value a number of times to the LCD controller       *
+*   Parameter:    dat:    data to be written                                   *
+*                 cnt:    number of times                                      *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void wr_dat_fill (unsigned short dat, unsigned int cnt) {
+
+  while (cnt--)
+    wr_dat_only(dat);
+}
+
+
+/*******************************************************************************
+* Data writing of one row of a character to the LCD controller: the row is     *
+* expanded into pixel words first, so the loop feeding the Tx FIFO does not    *
+* have to test bits                                                            *
+*   Parameter:    bits:   row of character bitmap (bit i = i-th pixel)         *
+*                 cw:     character width in pixels (max 16)                   *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void wr_dat_row (unsigned int bits, unsigned int cw) {
+  unsigned short row[16], text = TextColor, back = BackColor;
+  unsigned int   i;
+
+  for (i = 0; i < cw; i++) {
+#if (HORIZONTAL == 1)
+    row[i] = (bits & (1 << (cw-1-i))) ? text : back;
+#else
+    row[i] = (bits & (1 << i)) ? text : back;
+#endif
+  }
+  for (i = 0; i < cw; i++)
+    wr_dat_only(row[i]);
+}
+
+
+#if (GLCD_GLYPHS > 0)
+/*******************************************************************************
+* Data writing of a cached character to the LCD controller: each run is sent   *
+* as one fill, without looking at the font                                     *
+*   Parameter:    runs:   runs of the character, starting with background      *
+*                 cnt:    number of pixels of the character                    *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void wr_dat_runs (const unsigned char *runs, unsigned int cnt) {
+  unsigned short text = TextColor, back = BackColor;
+
+  while (cnt) {
+    wr_dat_fill(back, *runs);
+    cnt -= *runs++;
+    if (cnt == 0)
+      break;
+    wr_dat_fill(text, *runs);
+    cnt -= *runs++;
+  }
 }
+#endif
 
 
 /*******************************************************************************
@@ -218,6 +406,268 @@ static unsigned short rd_reg (unsigned char reg) {
 }
 
 
+/*******************************************************************************
+* Fill a character cell                                                        *
+*   Parameter:    cell:   cell to fill                                         *
+*                 c:      ascii character                                      *
+*                 fg:     foreground color                                     *
+*                 bg:     background color                                     *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void text_cell (TEXT_CELL *cell, unsigned char c, unsigned short fg, unsigned short bg) {
+
+  cell->c  = c;
+  cell->fg = (c == ' ') ? bg : fg;      /* A space looks the same in any fg   */
+  cell->bg = bg;
+}
+
+
+/*******************************************************************************
+* Forget the character cells under an area that is drawn over                  *
+*   Parameter:    x:      horizontal position                                  *
+*                 y:      vertical position                                    *
+*                 w:      width of area                                        *
+*                 h:      height of area                                       *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void text_forget (unsigned int x, unsigned int y, unsigned int w, unsigned int h) {
+  unsigned int ln, col;
+
+  if (w == 0 || h == 0)
+    return;
+  for (ln = y/24; ln <= (y+h-1)/24 && ln < TEXT_LINES; ln++) {
+    for (col = x/16; col <= (x+w-1)/16 && col < TEXT_COLS; col++) {
+      TextShown [ln][col].c = 0;
+      TextWanted[ln][col].c = 0;
+    }
+  }
+}
+
+
+/*******************************************************************************
+* Find where the box of a character starts in the bits of a compiled font      *
+*   Parameter:    font:   font                                                 *
+*                 idx:    character index in the font                          *
+*   Return:               first bit of the box                                 *
+*******************************************************************************/
+
+static unsigned int font_bit (const GLCD_FONT *font, unsigned int idx) {
+  const GLCD_GLYPH *g   = &font->glyph[idx & ~7];
+  unsigned int      bit = font->index[idx / 8];
+
+  for (; g < &font->glyph[idx]; g++)    /* Skip the boxes before it           */
+    bit += ((g->box & 0x0F) + 1) * g->rows;
+  return (bit);
+}
+
+
+/*******************************************************************************
+* Read a row of a character of a compiled font                                 *
+*   Parameter:    font:   font                                                 *
+*                 g:      box of the character                                 *
+*                 bit:    first bit of the box                                 *
+*                 j:      row                                                  *
+*   Return:               row of character bitmap (bit i = i-th pixel)         *
+*******************************************************************************/
+
+static unsigned int font_row (const GLCD_FONT *font, const GLCD_GLYPH *g, unsigned int bit, unsigned int j) {
+  const unsigned char *p;
+  unsigned int         w = (g->box & 0x0F) + 1, v;
+
+  if (j < g->top || j >= g->top + g->rows)
+    return (0);
+  bit += (j - g->top) * w;
+  p    = &font->bits[bit >> 3];         /* The row is within these 3 bytes    */
+  v    = (p[0] << 16) | (p[1] << 8) | p[2];
+  return (((v >> (24 - (bit & 7) - w)) & ((1 << w) - 1)) << (g->box >> 4));
+}
+
+
+#if (GLCD_GLYPHS > 0)
+/*******************************************************************************
+* Work out the runs of a 16x24 font character in the order its pixels are      *
+* sent; a run longer than 255 pixels is split by an empty run of the other     *
+* color                                                                        *
+*   Parameter:    idx:    character index in Font_16x24                        *
+*                 runs:   where to put the runs, or 0 to only count them       *
+*   Return:               number of runs                                       *
+*******************************************************************************/
+
+static unsigned int glyph_encode (unsigned int idx, unsigned char *runs) {
+  const GLCD_GLYPH *g     = &Font_16x24.glyph[idx];
+  unsigned int      start = font_bit(&Font_16x24, idx);
+  unsigned int      i, j, row, bit, on = 0, run = 0, cnt = 0;
+
+  for (j = 0; j < 24; j++) {
+    row = font_row(&Font_16x24, g, start, j);
+    for (i = 0; i < 16; i++) {
+#if (HORIZONTAL == 1)
+      bit = (row >> (15-i)) & 1;
+#else
+      bit = (row >> i) & 1;
+#endif
+      if (bit == on && run == 255) {
+        if (runs) {
+          runs[cnt]   = 255;
+          runs[cnt+1] = 0;
+        }
+        cnt += 2;
+        run  = 0;
+      }
+      if (bit != on) {
+        if (runs)
+          runs[cnt] = run;
+        cnt++;
+        run = 0;
+        on  = bit;
+      }
+      run++;
+    }
+  }
+  if (runs)
+    runs[cnt] = run;
+  return (cnt + 1);
+}
+
+
+/*******************************************************************************
+* Find the runs of a 16x24 font character, building them the first time        *
+*   Parameter:    idx:    character index in Font_16x24                        *
+*   Return:               runs of the character, or 0 if it is not cached      *
+*******************************************************************************/
+
+static const unsigned char *glyph_runs (unsigned int idx) {
+  unsigned int cnt;
+
+  if (GlyphAt[idx] == GLYPH_NONE)
+    return (0);
+  if (GlyphAt[idx] == 0) {
+    cnt = glyph_encode(idx, 0);
+    if (cnt > GLCD_GLYPHS - GlyphUsed) {
+      GlyphAt[idx] = GLYPH_NONE;        /* Cache is full, use the font        */
+      return (0);
+    }
+    glyph_encode(idx, &GlyphRuns[GlyphUsed]);
+    GlyphAt[idx] = GlyphUsed + 1;
+    GlyphUsed   += cnt;
+  }
+  return (&GlyphRuns[GlyphAt[idx] - 1]);
+}
+#endif
+
+
+#if (GLCD_DMA == 1)
+/*******************************************************************************
+* Finish a DMA transfer: let SSP1 send what is left in its FIFO, release CS    *
+* and call the completion callback                                             *
+*   Parameter:                                                                 *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void dma_finish (void) {
+
+  LPC_SSP1->DMACR = 0;
+  wr_dat_stop();
+  DmaBusy = 0;
+
+  if (DmaEntry) {
+    wr_reg(0x03, DmaEntry);
+    DmaEntry = 0;
+  }
+  if (DoneCallback)
+    DoneCallback();
+}
+
+
+/*******************************************************************************
+* Wait for the DMA transfer in progress (if any) to finish                     *
+*   Parameter:                                                                 *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void dma_wait (void) {
+
+  /* The channel disables itself after the last descriptor; finish the
+     transfer here if the DMA interrupt has not done so (it may be masked)    */
+  while (DmaBusy) {
+    if ((LPC_GPDMA->DMACEnbldChns & DMA_CH_BIT) == 0) {
+      NVIC_DisableIRQ(DMA_IRQn);
+      if (DmaBusy) {
+        LPC_GPDMA->DMACIntTCClear = DMA_CH_BIT;
+        LPC_GPDMA->DMACIntErrClr  = DMA_CH_BIT;
+        dma_finish();
+      }
+      NVIC_EnableIRQ(DMA_IRQn);
+    }
+  }
+}
+
+
+/*******************************************************************************
+* Write GRAM in a different order for the next DMA transfer                    *
+*   Parameter:    entry:  entry mode (I/D and AM bits)                         *
+*                 h:      horizontal GRAM address to start at                  *
+*                 v:      vertical GRAM address to start at                    *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void dma_entry_mode (unsigned short entry, unsigned int h, unsigned int v) {
+
+  wr_reg(0x03, entry);
+  wr_reg(0x20, h);
+  wr_reg(0x21, v);
+  DmaEntry = ENTRY_MODE;
+}
+
+
+/*******************************************************************************
+* Start sending pixels with DMA (after wr_cmd(0x22) and wr_dat_start())        *
+*   Parameter:    src:    first pixel                                          *
+*                 cnt:    number of pixels (1 .. WIDTH*HEIGHT)                 *
+*                 inc:    1 to send src[0..cnt-1], 0 to send src[0] cnt times  *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void dma_start (const volatile unsigned short *src, unsigned int cnt, int inc) {
+  DMA_LLI      *lli = DmaRam.lli;
+  unsigned int  n;
+
+  /* Split the transfer into linked descriptors of up to DMA_CHUNK pixels,
+     interrupting after the last one                                         */
+  for (;;) {
+    n    = (cnt > DMA_CHUNK) ? DMA_CHUNK : cnt;
+    cnt -= n;
+    lli->src  = (unsigned int)src;
+    lli->dst  = (unsigned int)&LPC_SSP1->DR;
+    lli->lli  = cnt ? (unsigned int)(lli+1) : 0;
+    lli->ctrl = n | DMA_SB4 | DMA_DB4 | DMA_SW16 | DMA_DW16 |
+                (inc ? DMA_SI : 0) | (cnt ? 0 : DMA_TCI);
+    if (cnt == 0)
+      break;
+    if (inc)
+      src += n;
+    lli++;
+  }
+  __DSB();                              /* Descriptors written before start   */
+
+  /* SSP1 requests the DMA when its Tx FIFO is half empty                     */
+  DmaBusy = 1;
+  LPC_SSP1->DMACR = 0x02;               /* Tx DMA enable                      */
+
+  lli = DmaRam.lli;
+  LPC_GPDMA->DMACIntTCClear = DMA_CH_BIT;
+  LPC_GPDMA->DMACIntErrClr  = DMA_CH_BIT;
+  DMA_CH->DMACCSrcAddr  = lli->src;
+  DMA_CH->DMACCDestAddr = lli->dst;
+  DMA_CH->DMACCLLI      = lli->lli;
+  DMA_CH->DMACCControl  = lli->ctrl;
+  DMA_CH->DMACCConfig   = DMA_E | (DMA_SSP1_TX << 6) | DMA_M2P | DMA_IE | DMA_ITC;
+}
+#endif
+
+
 /************************ Exported functions **********************************/
 
 /*******************************************************************************
@@ -250,6 +700,13 @@ void GLCD_Init (void) {
   LPC_SSP1->CPSR       = 0x02;
   LPC_SSP1->CR1        = 0x02;
 
+#if (GLCD_DMA == 1)
+  /* Enable the GPDMA controller for pixel transfers                          */
+  LPC_SC->PCONP       |= 0x20000000;
+  LPC_GPDMA->DMACConfig = 0x01;
+  NVIC_EnableIRQ(DMA_IRQn);
+#endif
+
   delay(5);                             /* Delay 50 ms                        */
   driverCode = rd_reg(0x00);
 
@@ -403,6 +860,7 @@ void GLCD_WindowMax (void) {
 
 void GLCD_PutPixel (unsigned int x, unsigned int y) {
 
+  text_forget(x, y, 1, 1);
 #if (HORIZONTAL == 1)
   wr_reg(0x20, y);
   wr_reg(0x21, WIDTH-1-x);
@@ -446,14 +904,27 @@ void GLCD_SetBackColor (unsigned short color) {
 *******************************************************************************/
 
 void GLCD_Clear (unsigned short color) {
-  unsigned int i;
+  unsigned int ln, col;
+
+  for (ln = 0; ln < TEXT_LINES; ln++) {
+    for (col = 0; col < TEXT_COLS; col++) {
+      text_cell(&TextShown[ln][col], ' ', color, color);
+      TextWanted[ln][col] = TextShown[ln][col];
+    }
+  }
 
   GLCD_WindowMax();
   wr_cmd(0x22);
   wr_dat_start();
-  for(i = 0; i < (WIDTH*HEIGHT); i++)
-    wr_dat_only(color);
+#if (GLCD_DMA == 1)
+  DmaRam.fill = color;
+  dma_start(&DmaRam.fill, WIDTH*HEIGHT, 0);
+#else
+  wr_dat_fill(color, WIDTH*HEIGHT);
   wr_dat_stop();
+  if (DoneCallback)
+    DoneCallback();
+#endif
 }
 
 
@@ -468,8 +939,10 @@ void GLCD_Clear (unsigned short color) {
 *******************************************************************************/
 
 void GLCD_DrawChar_U8 (unsigned int x, unsigned int y, unsigned int cw, unsigned int ch, unsigned char *c) {
-  int idx = 0, i, j;
+  int idx = 0;
+  unsigned int j;
 
+  text_forget(x, y, cw, ch);
 #if (HORIZONTAL == 1)
   x = WIDTH-x-cw;
   GLCD_SetWindow(y, x, ch, cw);
@@ -479,17 +952,7 @@ void GLCD_DrawChar_U8 (unsigned int x, unsigned int y, unsigned int cw, unsigned
   wr_cmd(0x22);
   wr_dat_start();
   for (j = 0; j < ch; j++) {
-#if (HORIZONTAL == 1)
-    for (i = cw-1; i >= 0; i--) {
-#else
-    for (i = 0; i <= cw-1; i++) {
-#endif
-      if((c[idx] & (1 << i)) == 0x00) {
-        wr_dat_only(BackColor);
-      } else {
-        wr_dat_only(TextColor);
-      }
-    }
+    wr_dat_row(c[idx], cw);
     c++;
   }
   wr_dat_stop();
@@ -507,8 +970,10 @@ void GLCD_DrawChar_U8 (unsigned int x, unsigned int y, unsigned int cw, unsigned
 *******************************************************************************/
 
 void GLCD_DrawChar_U16 (unsigned int x, unsigned int y, unsigned int cw, unsigned int ch, unsigned short *c) {
-  int idx = 0, i, j;
+  int idx = 0;
+  unsigned int j;
 
+  text_forget(x, y, cw, ch);
 #if (HORIZONTAL == 1)
   x = WIDTH-x-cw;
   GLCD_SetWindow(y, x, ch, cw);
@@ -518,19 +983,59 @@ void GLCD_DrawChar_U16 (unsigned int x, unsigned int y, unsigned int cw, unsigne
   wr_cmd(0x22);
   wr_dat_start();
   for (j = 0; j < ch; j++) {
+    wr_dat_row(c[idx], cw);
+    c++;
+  }
+  wr_dat_stop();
+}
+
+
+/*******************************************************************************
+* Draw character of a compiled font on given position; each row is read out    *
+* of the font as it is sent (characters of the 16x24 font are sent from the    *
+* glyph cache instead, once they are in it)                                    *
+*   Parameter:      x:        horizontal position                              *
+*                   y:        vertical position                                *
+*                   font:     font                                             *
+*                   c:        ascii character (the first character of the font *
+*                             is drawn if it is not in the font)               *
+*   Return:                                                                    *
+*******************************************************************************/
+
+static void font_draw (unsigned int x, unsigned int y, const GLCD_FONT *font, unsigned char c) {
+  const GLCD_GLYPH    *g;
+  unsigned int         idx = c - font->first, bit, j;
+#if (GLCD_GLYPHS > 0)
+  const unsigned char *runs = 0;
+#endif
+
+  if (idx >= font->num)
+    idx = 0;
+  g   = &font->glyph[idx];
+#if (GLCD_GLYPHS > 0)
+  if (font == &Font_16x24)
+    runs = glyph_runs(idx);
+#endif
+
+  text_forget(x, y, font->w, font->h);
 #if (HORIZONTAL == 1)
-    for (i = cw-1; i >= 0; i--) {
+  x = WIDTH-x-font->w;
+  GLCD_SetWindow(y, x, font->h, font->w);
 #else
-    for (i = 0; i <= cw-1; i++) {
+  GLCD_SetWindow(x, y, font->w, font->h);
 #endif
-      if((c[idx] & (1 << i)) == 0x00) {
-        wr_dat_only(BackColor);
-      } else {
-        wr_dat_only(TextColor);
-      }
-    }
-    c++;
+  wr_cmd(0x22);
+  wr_dat_start();
+#if (GLCD_GLYPHS > 0)
+  if (runs) {
+    wr_dat_runs(runs, font->w * font->h);
+    wr_dat_stop();
+    return;
   }
+#endif
+  bit = font_bit(font, idx);
+  for (j = 0; j < font->h; j++)
+    wr_dat_row(font_row(font, g, bit, j), font->w);
   wr_dat_stop();
 }
 
@@ -545,14 +1050,23 @@ void GLCD_DrawChar_U16 (unsigned int x, unsigned int y, unsigned int cw, unsigne
 *******************************************************************************/
 
 void GLCD_DisplayChar (unsigned int ln, unsigned int col, unsigned char fi, unsigned char c) {
+  TEXT_CELL cell;
 
-  c -= 32;
   switch (fi) {
     case 0:  /* Font 6 x 8 */
-      GLCD_DrawChar_U8 (col *  6, ln *  8,  6,  8, (unsigned char  *)&Font_6x8_h  [c * 8]);
+      font_draw(col *  6, ln *  8, &Font_6x8, c);
       break;
     case 1:  /* Font 16 x 24 */
-      GLCD_DrawChar_U16(col * 16, ln * 24, 16, 24, (unsigned short *)&Font_16x24_h[c * 24]);
+      if (ln >= TEXT_LINES || col >= TEXT_COLS) {
+        font_draw(col * 16, ln * 24, &Font_16x24, c);
+        break;
+      }
+      /* Only draw the character if the cell does not already show it         */
+      text_cell(&cell, c, TextColor, BackColor);
+      if (!TEXT_SAME(&cell, &TextShown[ln][col]))
+        font_draw(col * 16, ln * 24, &Font_16x24, c);
+      TextShown [ln][col] = cell;
+      TextWanted[ln][col] = cell;
       break;
   }
 }
@@ -613,9 +1127,12 @@ void GLCD_ClearLn (unsigned int ln, unsigned char fi) {
 *******************************************************************************/
 
 void GLCD_Bargraph (unsigned int x, unsigned int y, unsigned int w, unsigned int h, unsigned int val) {
-  int i,j;
+  unsigned int i;
 
   val = (val * w) >> 10;                /* Scale value                        */
+  if (val > w)
+    val = w;
+  text_forget(x, y, w, h);
 #if (HORIZONTAL == 1)
   x = WIDTH-x-w;
   GLCD_SetWindow(y, x, h, w);
@@ -624,18 +1141,14 @@ void GLCD_Bargraph (unsigned int x, unsigned int y, unsigned int w, unsigned int
 #endif
   wr_cmd(0x22);
   wr_dat_start();
-  for (i = 0; i < h; i++) {
+  for (i = 0; i < h; i++) {             /* Each row is two runs of one color  */
 #if (HORIZONTAL == 1)
-    for (j = w-1; j >= 0; j--) {
+    wr_dat_fill(BackColor, w-val);
+    wr_dat_fill(TextColor, val);
 #else
-    for (j = 0; j <= w-1; j++) {
+    wr_dat_fill(TextColor, val);
+    wr_dat_fill(BackColor, w-val);
 #endif
-      if(j >= val) {
-        wr_dat_only(BackColor);
-      } else {
-        wr_dat_only(TextColor);
-      }
-    }
   }
   wr_dat_stop();
 }
@@ -657,11 +1170,23 @@ void GLCD_Bitmap (unsigned int x, unsigned int y, unsigned int w, unsigned int h
   unsigned int    i, j;
   unsigned short *bitmap_ptr = (unsigned short *)bitmap;
 
+  text_forget(x, y, w, h);
 #if (HORIZONTAL == 1)
   x = WIDTH-x-w;
   GLCD_SetWindow(y, x, h, w);
 #else
   GLCD_SetWindow(x, y, w, h);
+#endif
+#if (GLCD_DMA == 1)
+  if (DMA_REACH(bitmap) && w*h != 0 && w*h <= WIDTH*HEIGHT) {
+#if (HORIZONTAL == 0)
+    dma_entry_mode(0x1020, x+w-1, y);   /* Rows right to left                 */
+#endif
+    wr_cmd(0x22);
+    wr_dat_start();
+    dma_start(bitmap_ptr, w*h, 1);
+    return;
+  }
 #endif
   wr_cmd(0x22);
   wr_dat_start();
@@ -679,6 +1204,8 @@ void GLCD_Bitmap (unsigned int x, unsigned int y, unsigned int w, unsigned int h
 #endif
   }
   wr_dat_stop();
+  if (DoneCallback)
+    DoneCallback();
 }
 
 
@@ -698,11 +1225,27 @@ void GLCD_Bmp (unsigned int x, unsigned int y, unsigned int w, unsigned int h, u
   unsigned int    i, j;
   unsigned short *bitmap_ptr = (unsigned short *)bmp;
 
+  text_forget(x, y, w, h);
 #if (HORIZONTAL == 1)
   x = WIDTH-x-w;
   GLCD_SetWindow(y, x, h, w);
 #else
   GLCD_SetWindow(x, y, w, h);
+#endif
+#if (GLCD_DMA == 1)
+  /* The bmp is stored bottom up; DMA only counts up, so GRAM is written
+     backwards instead                                                        */
+  if (DMA_REACH(bmp) && w*h != 0 && w*h <= WIDTH*HEIGHT) {
+#if (HORIZONTAL == 1)
+    dma_entry_mode(0x1008, y+h-1, x+w-1); /* Whole window backwards           */
+#else
+    dma_entry_mode(0x1010, x, y+h-1);   /* Rows bottom to top                 */
+#endif
+    wr_cmd(0x22);
+    wr_dat_start();
+    dma_start(bitmap_ptr, w*h, 1);
+    return;
+  }
 #endif
   wr_cmd(0x22);
   wr_dat_start();
@@ -723,6 +1266,8 @@ void GLCD_Bmp (unsigned int x, unsigned int y, unsigned int w, unsigned int h, u
   }
 #endif
   wr_dat_stop();
+  if (DoneCallback)
+    DoneCallback();
 }
 
 
@@ -742,7 +1287,138 @@ void GLCD_ScrollVertical (unsigned int dy) {
 
   wr_reg(0x6A, y);
   wr_reg(0x61, 3);
+  text_forget(0, 0, WIDTH, HEIGHT);     /* Every character has moved          */
+#endif
+}
+
+
+/*******************************************************************************
+* Set every character cell to a space (16x24 font), without drawing anything   *
+* until GLCD_TextFlush                                                         *
+*   Parameter:      color:    background color                                 *
+*   Return:                                                                    *
+*******************************************************************************/
+
+void GLCD_TextClear (unsigned short color) {
+  unsigned int ln, col;
+
+  for (ln = 0; ln < TEXT_LINES; ln++) {
+    for (col = 0; col < TEXT_COLS; col++) {
+      text_cell(&TextWanted[ln][col], ' ', color, color);
+    }
+  }
+}
+
+
+/*******************************************************************************
+* Put string in the character cells on given line (16x24 font, current text    *
+* and back colors), without drawing anything until GLCD_TextFlush              *
+*   Parameter:      ln:       line number                                      *
+*                   col:      column number                                    *
+*                   s:        pointer to string                                *
+*   Return:                                                                    *
+*******************************************************************************/
+
+void GLCD_TextString (unsigned int ln, unsigned int col, unsigned char *s) {
+
+  if (ln >= TEXT_LINES)
+    return;
+  while (*s && col < TEXT_COLS) {
+    text_cell(&TextWanted[ln][col++], *s++, TextColor, BackColor);
+  }
+}
+
+
+/*******************************************************************************
+* Draw the character cells that were changed by GLCD_TextClear and             *
+* GLCD_TextString and do not already show what they should; a cell is its own  *
+* window, so unchanged cells cost nothing                                      *
+*   Parameter:                                                                 *
+*   Return:                 number of cells drawn                              *
+*******************************************************************************/
+
+unsigned int GLCD_TextFlush (void) {
+  unsigned short text = TextColor, back = BackColor;
+  unsigned int   ln, col, cnt = 0;
+  TEXT_CELL      cell;
+
+  for (ln = 0; ln < TEXT_LINES; ln++) {
+    for (col = 0; col < TEXT_COLS; col++) {
+      cell = TextWanted[ln][col];
+      if (cell.c == 0 || TEXT_SAME(&cell, &TextShown[ln][col]))
+        continue;
+      TextColor = cell.fg;
+      BackColor = cell.bg;
+      GLCD_DisplayChar(ln, col, 1, cell.c);
+      cnt++;
+    }
+  }
+  TextColor = text;
+  BackColor = back;
+  return (cnt);
+}
+
+
+/*******************************************************************************
+* Set function called when a GLCD_Clear, GLCD_Bitmap or GLCD_Bmp transfer has  *
+* finished (from the DMA interrupt, or from the next GLCD function if that     *
+* gets there first); the bitmap may be changed again from then on              *
+*   Parameter:      done:     completion function, or 0 for none               *
+*   Return:                                                                    *
+*******************************************************************************/
+
+void GLCD_SetDoneCallback (void (*done)(void)) {
+
+  DoneCallback = done;
+}
+
+
+/*******************************************************************************
+* Check if a DMA transfer to the display is still in progress                  *
+*   Parameter:                                                                 *
+*   Return:               1 if busy, 0 if not                                  *
+*******************************************************************************/
+
+int GLCD_Busy (void) {
+
+#if (GLCD_DMA == 1)
+  return (DmaBusy);
+#else
+  return (0);
+#endif
+}
+
+
+/*******************************************************************************
+* Wait for the DMA transfer to the display (if any) to finish                  *
+*   Parameter:                                                                 *
+*   Return:                                                                    *
+*******************************************************************************/
+
+void GLCD_WaitDone (void) {
+
+#if (GLCD_DMA == 1)
+  dma_wait();
 #endif
 }
 
+
+#if (GLCD_DMA == 1)
+/*******************************************************************************
+* GPDMA interrupt handler: finish the transfer to the display                  *
+*   Parameter:                                                                 *
+*   Return:                                                                    *
+*******************************************************************************/
+
+void DMA_IRQHandler (void) {
+
+  if ((LPC_GPDMA->DMACIntTCStat | LPC_GPDMA->DMACIntErrStat) & DMA_CH_BIT) {
+    LPC_GPDMA->DMACIntTCClear = DMA_CH_BIT;
+    LPC_GPDMA->DMACIntErrClr  = DMA_CH_BIT;
+    if (DmaBusy)
+      dma_finish();
+  }
+}
+#endif
+
 /******************************************************************************/
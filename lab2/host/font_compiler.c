@@ -0,0 +1,364 @@
+/*
+ * Host-side font compiler. Turns one of the Keil font tables (Font_6x8_h.h,
+ * Font_16x24_h.h: one word per pixel row, bit i = column i) into the compact
+ * GLCD_FONT format the display driver draws from (see GLCD.h).
+ *
+ * Each character is cut down to the box around its set pixels, and only the
+ * box is stored, one bit per pixel, row after row, with no padding between
+ * characters. A table gives the box of each character in 3 bytes, and a
+ * second table gives where every 8th character starts in the bits, so the
+ * driver finds a character by adding up the boxes of at most 7 before it.
+ *
+ * Build and run (from lab2, for the 16x24 font):
+ *   gcc -O2 host/font_compiler.c -o font_compiler
+ *   ./font_compiler thermostat/Font_16x24_h.h 16 24 Font_16x24 > thermostat/Font_16x24_c.h
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Most characters, and most rows per character, the compiler handles. A
+ * character is at most 16 columns wide, as the box width is kept in 4 bits.
+ */
+#define MAX_GLYPHS           256
+#define MAX_ROWS             64
+#define MAX_COLUMNS          16
+
+/*
+ * Characters per entry of the start table.
+ */
+#define INDEX_STEP           8
+
+/*
+ * NAME:          glyph
+ *
+ * DESCRIPTION:   A character read from the font table.
+ *
+ * MEMBERS:
+ *   unsigned int rows[ MAX_ROWS ]
+ *     - Pixel rows, bit i = column i.
+ *   unsigned int left, width, top, height
+ *     - Box around the set pixels (height 0 if there are none).
+ *   char comment[ 64 ]
+ *     - Comment in front of the character in the font table.
+ */
+struct glyph
+{
+    unsigned int rows[ MAX_ROWS ];
+    unsigned int left;
+    unsigned int width;
+    unsigned int top;
+    unsigned int height;
+    char comment[ 64 ];
+};
+
+static struct glyph glyphs[ MAX_GLYPHS ];
+static unsigned char bits[ MAX_GLYPHS * MAX_ROWS * MAX_COLUMNS / 8 + 2 ];
+static unsigned long bit_count;
+
+/*
+ * NAME:          read_font
+ *
+ * DESCRIPTION:   Read the rows of every character from a font table. The
+ *                numbers between the first { and the following } are the
+ *                rows; the last comment before the first row of a character
+ *                is kept for the output.
+ *
+ * PARAMETERS:
+ *  const char *text
+ *    - Font table source.
+ *  unsigned int height
+ *    - Rows per character.
+ *
+ * RETURNS:
+ *  unsigned int
+ *    - Number of characters read.
+ */
+static unsigned int read_font( const char *text, unsigned int height )
+{
+    char comment[ 64 ] = "";
+    const char *p = strchr( text, '{' );
+    const char *end;
+    unsigned long values = 0;
+    size_t length;
+
+    while ( p != NULL && *p != '\0' && *p != '}' )
+    {
+        if ( p[ 0 ] == '/' && p[ 1 ] == '*' )
+        {
+            // Keep the text of the comment, trimmed, in case a character
+            // follows it.
+            for ( p += 2; *p == ' '; ++p )
+            {
+            }
+
+            if ( ( end = strstr( p, "*/" ) ) == NULL )
+            {
+                break;
+            }
+
+            for ( length = end - p; length > 0 && p[ length - 1 ] == ' '; --length )
+            {
+            }
+
+            if ( length > sizeof( comment ) - 1 )
+            {
+                length = sizeof( comment ) - 1;
+            }
+
+            memcpy( comment, p, length );
+            comment[ length ] = '\0';
+            p = end + 2;
+        }
+        else if ( *p >= '0' && *p <= '9' )
+        {
+            if ( values / height >= MAX_GLYPHS )
+            {
+                fprintf( stderr, "more than %d characters\n", MAX_GLYPHS );
+                exit( 1 );
+            }
+
+            if ( values % height == 0 )
+            {
+                strcpy( glyphs[ values / height ].comment, comment );
+            }
+
+            glyphs[ values / height ].rows[ values % height ] = ( unsigned int )strtoul( p, ( char ** )&end, 0 );
+            ++values;
+            p = end;
+        }
+        else
+        {
+            ++p;
+        }
+    }
+
+    if ( values % height != 0 )
+    {
+        fprintf( stderr, "%lu rows is not a whole number of characters\n", values );
+        exit( 1 );
+    }
+
+    return values / height;
+}
+
+/*
+ * NAME:          find_box
+ *
+ * DESCRIPTION:   Find the box around the set pixels of a character.
+ *
+ * PARAMETERS:
+ *  struct glyph *g
+ *    - Character.
+ *  unsigned int width, height
+ *    - Size of the character.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void find_box( struct glyph *g, unsigned int width, unsigned int height )
+{
+    unsigned int columns = 0;
+    unsigned int j;
+    unsigned int i;
+
+    g->left = g->width = g->top = g->height = 0;
+
+    for ( j = 0; j < height; ++j )
+    {
+        if ( g->rows[ j ] & ~( ( 1u << width ) - 1 ) )
+        {
+            fprintf( stderr, "%s: row %u is wider than %u\n", g->comment, j, width );
+            exit( 1 );
+        }
+
+        if ( g->rows[ j ] != 0 )
+        {
+            if ( g->height == 0 )
+            {
+                g->top = j;
+            }
+
+            g->height = j - g->top + 1;
+            columns |= g->rows[ j ];
+        }
+    }
+
+    if ( columns == 0 )
+    {
+        return;
+    }
+
+    for ( i = 0; !( columns & ( 1u << i ) ); ++i )
+    {
+    }
+
+    g->left = i;
+
+    for ( i = width - 1; !( columns & ( 1u << i ) ); --i )
+    {
+    }
+
+    g->width = i - g->left + 1;
+}
+
+/*
+ * NAME:          put_bits
+ *
+ * DESCRIPTION:   Append a field to the bits, most significant bit first.
+ *
+ * PARAMETERS:
+ *  unsigned int value
+ *    - Field.
+ *  unsigned int count
+ *    - Bits in the field.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void put_bits( unsigned int value, unsigned int count )
+{
+    while ( count-- )
+    {
+        if ( ( value >> count ) & 1 )
+        {
+            bits[ bit_count / 8 ] |= 0x80 >> ( bit_count % 8 );
+        }
+
+        ++bit_count;
+    }
+}
+
+int main( int argc, char **argv )
+{
+    static char text[ 1 << 20 ];
+    FILE *in;
+    size_t length;
+    unsigned int width;
+    unsigned int height;
+    unsigned int first;
+    unsigned int count;
+    unsigned long raw_bytes;
+    unsigned long bytes;
+    unsigned int k;
+    unsigned int j;
+    const char *name;
+    const char *source;
+    char guard[ 64 ];
+
+    if ( argc < 5 || argc > 6 )
+    {
+        fprintf( stderr, "usage: %s font.h width height name [first character]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    width = ( unsigned int )strtoul( argv[ 2 ], NULL, 0 );
+    height = ( unsigned int )strtoul( argv[ 3 ], NULL, 0 );
+    name = argv[ 4 ];
+    first = argc == 6 ? ( unsigned int )strtoul( argv[ 5 ], NULL, 0 ) : ' ';
+
+    if ( width == 0 || width > MAX_COLUMNS || height == 0 || height > MAX_ROWS )
+    {
+        fprintf( stderr, "characters must be 1 to %d by 1 to %d pixels\n", MAX_COLUMNS, MAX_ROWS );
+        return 1;
+    }
+
+    if ( ( in = fopen( argv[ 1 ], "rb" ) ) == NULL )
+    {
+        perror( argv[ 1 ] );
+        return 1;
+    }
+
+    length = fread( text, 1, sizeof( text ) - 1, in );
+    fclose( in );
+    text[ length ] = '\0';
+
+    count = read_font( text, height );
+
+    // The header names the font table without its directory, and its guard
+    // is the font name in capitals.
+    source = strrchr( argv[ 1 ], '/' ) ? strrchr( argv[ 1 ], '/' ) + 1 : argv[ 1 ];
+
+    for ( k = 0; name[ k ] != '\0' && k < sizeof( guard ) - 1; ++k )
+    {
+        guard[ k ] = ( char )toupper( ( unsigned char )name[ k ] );
+    }
+
+    guard[ k ] = '\0';
+
+    if ( count == 0 || first + count > 256 )
+    {
+        fprintf( stderr, "%u characters from 0x%02X do not fit a character set\n", count, first );
+        return 1;
+    }
+
+    for ( k = 0; k < count; ++k )
+    {
+        find_box( &glyphs[ k ], width, height );
+
+        for ( j = glyphs[ k ].top; j < glyphs[ k ].top + glyphs[ k ].height; ++j )
+        {
+            put_bits( glyphs[ k ].rows[ j ] >> glyphs[ k ].left, glyphs[ k ].width );
+        }
+    }
+
+    if ( bit_count > 0xFFFF )
+    {
+        fprintf( stderr, "%lu bits do not fit the 16 bit start table\n", bit_count );
+        return 1;
+    }
+
+    // The driver reads 3 bytes at a time, so 2 more bytes follow the last bit.
+    bytes = ( bit_count + 7 ) / 8 + 2;
+    raw_bytes = ( unsigned long )count * height * ( width > 8 ? 2 : 1 );
+
+    printf( "/*----------------------------------------------------------------------------\n" );
+    printf( " * Name:    %s_c.h\n", name );
+    printf( " * Purpose: %s compiled by host/font_compiler.c\n", source );
+    printf( " *          (%u characters of %ux%u pixels, %lu bytes instead of %lu)\n", count, width, height,
+            bytes + count * 3 + ( count + INDEX_STEP - 1 ) / INDEX_STEP * 2 + 16, raw_bytes );
+    printf( " *          Do not edit, compile the font table again instead.\n" );
+    printf( " *----------------------------------------------------------------------------*/\n\n" );
+    printf( "#ifndef __%s_C_H\n#define __%s_C_H\n\n", guard, guard );
+
+    printf( "static const GLCD_GLYPH %s_glyphs[] = {\n", name );
+
+    for ( k = 0; k < count; ++k )
+    {
+        struct glyph *g = &glyphs[ k ];
+
+        printf( "  { 0x%02X, %2u, %2u }%s   /* %s */\n", g->height ? ( g->left << 4 ) | ( g->width - 1 ) : 0,
+                g->top, g->height, k + 1 < count ? "," : " ", g->comment );
+    }
+
+    printf( "};\n\n" );
+    printf( "static const unsigned short %s_index[] = {", name );
+
+    for ( k = 0, bit_count = 0; k < count; ++k )
+    {
+        if ( k % INDEX_STEP == 0 )
+        {
+            printf( "%s%lu", k == 0 ? "\n  " : k % ( INDEX_STEP * 8 ) == 0 ? ",\n  " : ", ", bit_count );
+        }
+
+        bit_count += glyphs[ k ].width * glyphs[ k ].height;
+    }
+
+    printf( "\n};\n\n" );
+    printf( "static const unsigned char %s_bits[] = {", name );
+
+    for ( k = 0; k < bytes; ++k )
+    {
+        printf( "%s0x%02X", k == 0 ? "\n  " : k % 12 == 0 ? ",\n  " : ", ", bits[ k ] );
+    }
+
+    printf( "\n};\n\n" );
+    printf( "static const GLCD_FONT %s = {\n", name );
+    printf( "  %u, %u, 0x%02X, %u, %s_glyphs, %s_index, %s_bits\n", width, height, first, count, name, name, name );
+    printf( "};\n\n" );
+    printf( "#endif /* __%s_C_H */\n", guard );
+
+    return 0;
+}
@@ -0,0 +1,545 @@
+/*
+ * Host-side benchmark of the GLCD pixel path (GLCD_SPI_LPC1700.c), against a
+ * cycle-counting model of SSP1 and the LCD controller.
+ *
+ * The model counts CPU cycles at 100 MHz. Every access to an SSP1 or GPIO
+ * register costs REG_CYCLES, and nothing else the driver does is counted, so
+ * the figures are a best case for the CPU side and only show where the time
+ * goes on the bus. SSP1 has the 8 frame Tx and Rx FIFOs of the real one and
+ * shifts a bit every SCK_CYCLES (12.5 Mbit/s, as set up by GLCD_Init). Frames
+ * that come out of SSP1 are decoded as the LCD controller would decode them,
+ * into a copy of its GRAM.
+ *
+ * For each kind of drawing the benchmark reports the pixels written to GRAM
+ * per second and how much of the time the serial link was busy. It also
+ * checks the driver does not lose frames (writing a full Tx FIFO, raising CS
+ * or changing the frame size before SSP1 is idle), and prints a checksum of
+ * the GRAM, so two versions of the driver can be checked to draw the same
+ * thing.
+ *
+ * Build (from lab2, for the driver in thermostat):
+ *   g++ -O2 -Ihost -Ithermostat -DGLCD_DMA=0 -x c++ thermostat/GLCD_SPI_LPC1700.c \
+ *       -x none host/glcd_benchmark.cpp -o glcd_benchmark
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "lpc17xx.h"
+#include "GLCD.h"
+
+/*
+ * CPU clock, CPU cycles per SSP1 or GPIO register access, and CPU cycles per
+ * bit on the serial link.
+ */
+#define CPU_HZ               100000000ULL
+#define REG_CYCLES           4
+#define SCK_CYCLES           8
+
+/*
+ * Frames each SSP1 FIFO holds.
+ */
+#define FIFO_FRAMES          8
+
+/*
+ * SSP1 status register bits, and the LCD chip select pin.
+ */
+#define SR_TFE               0x01
+#define SR_TNF               0x02
+#define SR_RNE               0x04
+#define SR_RFF               0x08
+#define SR_BSY               0x10
+#define PIN_CS               ( 1 << 6 )
+
+LPC_SSP_TypeDef host_ssp1;
+LPC_GPIO_TypeDef host_gpio0;
+LPC_GPIO_TypeDef host_gpio4;
+LPC_SC_TypeDef host_sc;
+LPC_PINCON_TypeDef host_pincon;
+
+/*
+ * NAME:          ssp
+ *
+ * DESCRIPTION:   State of SSP1.
+ *
+ * MEMBERS:
+ *   unsigned int tx[ FIFO_FRAMES ], tx_bits[ FIFO_FRAMES ]
+ *     - Frames waiting in the Tx FIFO, and their sizes in bits.
+ *   unsigned int tx_head, tx_count
+ *     - Oldest frame in the Tx FIFO, and number of frames in it.
+ *   unsigned int rx_count
+ *     - Frames in the Rx FIFO (what is received is not kept).
+ *   int shifting
+ *     - 1 while a frame is being shifted out.
+ *   unsigned int shift_frame, shift_bits
+ *     - Frame being shifted out, and its size in bits.
+ *   unsigned long long shift_end
+ *     - Time the last frame started finishes.
+ */
+static struct
+{
+    unsigned int tx[ FIFO_FRAMES ];
+    unsigned int tx_bits[ FIFO_FRAMES ];
+    unsigned int tx_head;
+    unsigned int tx_count;
+    unsigned int rx_count;
+    int shifting;
+    unsigned int shift_frame;
+    unsigned int shift_bits;
+    unsigned long long shift_end;
+} ssp;
+
+/*
+ * NAME:          lcd
+ *
+ * DESCRIPTION:   State of the LCD controller.
+ *
+ * MEMBERS:
+ *   int selected
+ *     - 1 while CS is low.
+ *   unsigned int bytes, start, high
+ *     - Bytes received since CS went low, the start byte, and the high byte
+ *       of the data word being received.
+ *   unsigned int index
+ *     - Register selected by the last index write.
+ *   unsigned short regs[ 256 ]
+ *     - Registers.
+ *   unsigned short gram[ 320 ][ 240 ]
+ *     - Display memory, [ vertical ][ horizontal ] as the controller sees it.
+ */
+static struct
+{
+    int selected;
+    unsigned int bytes;
+    unsigned int start;
+    unsigned int high;
+    unsigned int index;
+    unsigned short regs[ 256 ];
+    unsigned short gram[ 320 ][ 240 ];
+} lcd;
+
+/*
+ * Model clock, time the link was busy, pixels written to GRAM, and driver
+ * mistakes that would lose or corrupt frames on the real hardware.
+ */
+static unsigned long long now;
+static unsigned long long link_cycles;
+static unsigned long pixels;
+static unsigned long errors;
+
+/*
+ * NAME:          error
+ *
+ * DESCRIPTION:   Report a driver mistake.
+ *
+ * PARAMETERS:
+ *  const char *what
+ *    - What went wrong.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void error( const char *what )
+{
+    if ( errors++ < 10 )
+    {
+        fprintf( stderr, "at cycle %llu: %s\n", now, what );
+    }
+}
+
+/*
+ * NAME:          lcd_gram_write
+ *
+ * DESCRIPTION:   Write a pixel at the address counter, and move the counter
+ *                inside the window as the entry mode register says.
+ *
+ * PARAMETERS:
+ *  unsigned short pixel
+ *    - Pixel to write.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void lcd_gram_write( unsigned short pixel )
+{
+    unsigned int h = lcd.regs[ 0x20 ];
+    unsigned int v = lcd.regs[ 0x21 ];
+    unsigned int entry = lcd.regs[ 0x03 ];
+    int h_up = ( entry >> 4 ) & 1;
+    int v_up = ( entry >> 5 ) & 1;
+    int h_end = h == ( h_up ? lcd.regs[ 0x51 ] : lcd.regs[ 0x50 ] );
+    int v_end = v == ( v_up ? lcd.regs[ 0x53 ] : lcd.regs[ 0x52 ] );
+    unsigned int h_first = h_up ? lcd.regs[ 0x50 ] : lcd.regs[ 0x51 ];
+    unsigned int v_first = v_up ? lcd.regs[ 0x52 ] : lcd.regs[ 0x53 ];
+
+    if ( v < 320 && h < 240 )
+    {
+        lcd.gram[ v ][ h ] = pixel;
+    }
+
+    ++pixels;
+
+    // AM = 0 moves along a line first, AM = 1 down a column first.
+    if ( !( entry & 0x08 ) )
+    {
+        h = h_end ? h_first : ( h_up ? h + 1 : h - 1 );
+        v = !h_end ? v : v_end ? v_first : ( v_up ? v + 1 : v - 1 );
+    }
+    else
+    {
+        v = v_end ? v_first : ( v_up ? v + 1 : v - 1 );
+        h = !v_end ? h : h_end ? h_first : ( h_up ? h + 1 : h - 1 );
+    }
+
+    lcd.regs[ 0x20 ] = h;
+    lcd.regs[ 0x21 ] = v;
+}
+
+/*
+ * NAME:          lcd_byte
+ *
+ * DESCRIPTION:   Take a byte off the serial link. The first byte after CS
+ *                goes low says whether an index or data follows; data is in
+ *                16 bit words, high byte first.
+ *
+ * PARAMETERS:
+ *  unsigned int byte
+ *    - Byte received.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void lcd_byte( unsigned int byte )
+{
+    if ( !lcd.selected )
+    {
+        error( "byte sent with CS high" );
+        return;
+    }
+
+    if ( lcd.bytes++ == 0 )
+    {
+        lcd.start = byte;
+
+        if ( ( byte & 0xFC ) != 0x70 )
+        {
+            error( "bad start byte" );
+        }
+
+        return;
+    }
+
+    // Reads only shift dummy bytes out.
+    if ( lcd.start & 0x01 )
+    {
+        return;
+    }
+
+    if ( lcd.bytes % 2 == 0 )
+    {
+        lcd.high = byte;
+        return;
+    }
+
+    if ( !( lcd.start & 0x02 ) )
+    {
+        lcd.index = byte;
+    }
+    else if ( lcd.index == 0x22 )
+    {
+        lcd_gram_write( ( lcd.high << 8 ) | byte );
+    }
+    else
+    {
+        lcd.regs[ lcd.index ] = ( lcd.high << 8 ) | byte;
+    }
+}
+
+/*
+ * NAME:          ssp_run
+ *
+ * DESCRIPTION:   Bring SSP1 up to the current time: finish the frames whose
+ *                last bit has gone, and start the next ones from the Tx FIFO.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void ssp_run( void )
+{
+    unsigned int bits;
+
+    for ( ;; )
+    {
+        if ( ssp.shifting )
+        {
+            if ( ssp.shift_end > now )
+            {
+                return;
+            }
+
+            ssp.shifting = 0;
+
+            if ( ssp.shift_bits == 16 )
+            {
+                lcd_byte( ssp.shift_frame >> 8 );
+            }
+
+            lcd_byte( ssp.shift_frame & 0xFF );
+
+            // Nothing checks for receive overrun, so it is not counted.
+            if ( ssp.rx_count < FIFO_FRAMES )
+            {
+                ++ssp.rx_count;
+            }
+        }
+
+        if ( ssp.tx_count == 0 )
+        {
+            return;
+        }
+
+        // Back to back frames follow each other straight away; a frame that
+        // was written to an idle SSP1 was started when it was written.
+        bits = ssp.tx_bits[ ssp.tx_head ];
+        ssp.shift_frame = ssp.tx[ ssp.tx_head ];
+        ssp.shift_bits = bits;
+        ssp.shift_end += bits * SCK_CYCLES;
+        ssp.shifting = 1;
+        ssp.tx_head = ( ssp.tx_head + 1 ) % FIFO_FRAMES;
+        --ssp.tx_count;
+        link_cycles += bits * SCK_CYCLES;
+    }
+}
+
+/*
+ * NAME:          ssp_busy
+ *
+ * DESCRIPTION:   Whether SSP1 has a frame to send or is sending one.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if busy, 0 if idle.
+ */
+static int ssp_busy( void )
+{
+    return ssp.shifting || ssp.tx_count != 0;
+}
+
+/*
+ * See lpc17xx.h for comments.
+ */
+unsigned int reg_read( REG *reg )
+{
+    unsigned int value;
+
+    now += REG_CYCLES;
+    ssp_run();
+
+    if ( reg == &host_ssp1.SR )
+    {
+        value = ssp.tx_count == 0 ? SR_TFE : 0;
+        value |= ssp.tx_count < FIFO_FRAMES ? SR_TNF : 0;
+        value |= ssp.rx_count != 0 ? SR_RNE : 0;
+        value |= ssp.rx_count == FIFO_FRAMES ? SR_RFF : 0;
+        value |= ssp_busy() ? SR_BSY : 0;
+        return value;
+    }
+
+    if ( reg == &host_ssp1.DR )
+    {
+        if ( ssp.rx_count != 0 )
+        {
+            --ssp.rx_count;
+        }
+
+        return 0;
+    }
+
+    return reg->value;
+}
+
+/*
+ * See lpc17xx.h for comments.
+ */
+void reg_write( REG *reg, unsigned int value )
+{
+    now += REG_CYCLES;
+    ssp_run();
+
+    if ( reg == &host_ssp1.DR )
+    {
+        if ( ssp.tx_count == FIFO_FRAMES )
+        {
+            error( "frame written to a full Tx FIFO" );
+            return;
+        }
+
+        if ( !ssp_busy() )
+        {
+            ssp.shift_end = now;
+        }
+
+        ssp.tx[ ( ssp.tx_head + ssp.tx_count ) % FIFO_FRAMES ] = value & 0xFFFF;
+        ssp.tx_bits[ ( ssp.tx_head + ssp.tx_count ) % FIFO_FRAMES ] = ( host_ssp1.CR0.value & 0x0F ) + 1;
+        ++ssp.tx_count;
+        ssp_run();
+        return;
+    }
+
+    if ( reg == &host_ssp1.CR0 && ssp_busy() && ( ( value ^ reg->value ) & 0x0F ) != 0 )
+    {
+        error( "frame size changed while SSP1 is busy" );
+    }
+
+    if ( reg == &host_gpio0.FIOCLR && ( value & PIN_CS ) )
+    {
+        lcd.selected = 1;
+        lcd.bytes = 0;
+    }
+
+    if ( reg == &host_gpio0.FIOSET && ( value & PIN_CS ) )
+    {
+        if ( ssp_busy() )
+        {
+            error( "CS raised while SSP1 is busy" );
+        }
+
+        lcd.selected = 0;
+    }
+
+    if ( reg != &host_gpio0.FIOCLR && reg != &host_gpio0.FIOSET && reg != &host_ssp1.ICR )
+    {
+        reg->value = value;
+    }
+}
+
+/*
+ * Text drawn by the benchmark. The two strings differ in every column, so the
+ * 16x24 font path draws every character each time instead of finding it is
+ * already on the screen.
+ */
+static unsigned char text_a[] = "The quick brown fox jumps over the lazy dog 0123456789";
+static unsigned char text_b[] = "PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS! ~@#$%^&*()_+";
+
+/*
+ * Bitmap drawn by the benchmark, 16 bit pixels.
+ */
+static unsigned char image[ 160 * 120 * 2 ];
+
+static void draw_clear( void )
+{
+    GLCD_Clear( White );
+    GLCD_Clear( Black );
+}
+
+static void draw_text_16x24( void )
+{
+    unsigned int ln;
+
+    for ( ln = 0; ln < 10; ++ln )
+    {
+        GLCD_DisplayString( ln, 0, 1, ( ln & 1 ) ? text_b : text_a );
+    }
+
+    for ( ln = 0; ln < 10; ++ln )
+    {
+        GLCD_DisplayString( ln, 0, 1, ( ln & 1 ) ? text_a : text_b );
+    }
+}
+
+static void draw_text_6x8( void )
+{
+    unsigned int ln;
+
+    for ( ln = 0; ln < 30; ++ln )
+    {
+        GLCD_DisplayString( ln, 0, 0, ( ln & 1 ) ? text_b : text_a );
+    }
+}
+
+static void draw_bargraph( void )
+{
+    unsigned int val;
+
+    for ( val = 0; val <= 1024; val += 64 )
+    {
+        GLCD_Bargraph( 0, 216, 320, 24, val );
+    }
+}
+
+static void draw_bitmap( void )
+{
+    GLCD_Bitmap( 0, 0, 160, 120, image );
+    GLCD_Bitmap( 160, 120, 160, 120, image );
+}
+
+/*
+ * NAME:          benchmarks
+ *
+ * DESCRIPTION:   Kinds of drawing to time, in the order they are run.
+ */
+static const struct
+{
+    const char *name;
+    void ( *draw )( void );
+} benchmarks[] = {
+    { "GLCD_Clear", draw_clear },
+    { "16x24 text", draw_text_16x24 },
+    { "6x8 text", draw_text_6x8 },
+    { "GLCD_Bargraph", draw_bargraph },
+    { "GLCD_Bitmap", draw_bitmap }
+};
+
+int main( void )
+{
+    unsigned long long start;
+    unsigned long long start_link;
+    unsigned long start_pixels;
+    unsigned long long cycles;
+    unsigned long checksum = 2166136261UL;
+    unsigned int i;
+    unsigned int v;
+    unsigned int h;
+
+    for ( i = 0; i < sizeof( image ); ++i )
+    {
+        image[ i ] = ( unsigned char )( i * 7 + ( i >> 9 ) );
+    }
+
+    GLCD_Init();
+    GLCD_SetTextColor( Yellow );
+    GLCD_SetBackColor( Blue );
+
+    printf( "%-14s %10s %10s %12s %10s\n", "drawing", "pixels", "us", "pixels/s", "link busy" );
+
+    for ( i = 0; i < sizeof( benchmarks ) / sizeof( benchmarks[ 0 ] ); ++i )
+    {
+        start = now;
+        start_link = link_cycles;
+        start_pixels = pixels;
+
+        benchmarks[ i ].draw();
+
+        cycles = now - start;
+        printf( "%-14s %10lu %10.0f %12.0f %9.1f%%\n", benchmarks[ i ].name, pixels - start_pixels,
+                cycles * 1e6 / CPU_HZ, ( pixels - start_pixels ) * ( double )CPU_HZ / cycles,
+                ( link_cycles - start_link ) * 100.0 / cycles );
+    }
+
+    for ( v = 0; v < 320; ++v )
+    {
+        for ( h = 0; h < 240; ++h )
+        {
+            checksum = ( checksum ^ lcd.gram[ v ][ h ] ) * 16777619UL & 0xFFFFFFFFUL;
+        }
+    }
+
+    printf( "GRAM checksum %08lx, %lu driver errors\n", checksum, errors );
+
+    return errors != 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * Host stand-in for the Keil lpc17xx.h, for building GLCD_SPI_LPC1700.c on a
+ * PC against the SSP1 model in glcd_benchmark.cpp. Only the registers the
+ * display driver touches are here.
+ *
+ * It is C++ so that a register access can call into the model: every read
+ * and write of a REG goes through reg_read and reg_write, which advance the
+ * model's clock and move frames through SSP1 and into the LCD controller.
+ */
+#ifndef __LPC17XX_HOST__
+#define __LPC17XX_HOST__
+
+struct REG;
+
+unsigned int reg_read( REG *reg );
+void reg_write( REG *reg, unsigned int value );
+
+/*
+ * NAME:          REG
+ *
+ * DESCRIPTION:   A peripheral register. Reads and writes are passed to the
+ *                model, which keeps the plain value of the register in value.
+ */
+struct REG
+{
+    unsigned int value;
+
+    REG &operator=( unsigned int v ) { reg_write( this, v ); return *this; }
+    REG &operator|=( unsigned int v ) { reg_write( this, reg_read( this ) | v ); return *this; }
+    REG &operator&=( unsigned int v ) { reg_write( this, reg_read( this ) & v ); return *this; }
+    operator unsigned int() { return reg_read( this ); }
+};
+
+struct LPC_SSP_TypeDef { REG CR0, CR1, DR, SR, CPSR, IMSC, RIS, MIS, ICR, DMACR; };
+struct LPC_GPIO_TypeDef { REG FIODIR, FIOMASK, FIOPIN, FIOSET, FIOCLR; };
+struct LPC_SC_TypeDef { REG PCONP, PCLKSEL0, PCLKSEL1; };
+struct LPC_PINCON_TypeDef { REG PINSEL0, PINSEL9; };
+
+extern LPC_SSP_TypeDef host_ssp1;
+extern LPC_GPIO_TypeDef host_gpio0;
+extern LPC_GPIO_TypeDef host_gpio4;
+extern LPC_SC_TypeDef host_sc;
+extern LPC_PINCON_TypeDef host_pincon;
+
+#define LPC_SSP1      ( &host_ssp1 )
+#define LPC_GPIO0     ( &host_gpio0 )
+#define LPC_GPIO4     ( &host_gpio4 )
+#define LPC_SC        ( &host_sc )
+#define LPC_PINCON    ( &host_pincon )
+
+#endif // __LPC17XX_HOST__
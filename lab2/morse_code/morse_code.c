@@ -171,21 +171,24 @@ void morse_code_state_transition(int previous_state, int event, int current_stat
 
     turn_on_leds(leds_to_turn_on);
 
+    // Only the characters that differ from what is on the screen are
+    // redrawn, instead of clearing the whole screen first.
+    GLCD_TextClear(White);
+
     if (current_state == MORSE_CODE_STAGE_7_STATE) {
-        GLCD_Clear(White);
-        GLCD_DisplayString(0, 0, 1, CORRECT_TEXT);
+        GLCD_TextString(0, 0, CORRECT_TEXT);
     } else {
         switch (event) {
             case MORSE_CODE_DOT_EVENT:
-                GLCD_Clear(White);
-                GLCD_DisplayString(0, 0, 1, DOT_TEXT);
+                GLCD_TextString(0, 0, DOT_TEXT);
                 break;
             case MORSE_CODE_DASH_EVENT:
-                GLCD_Clear(White);
-                GLCD_DisplayString(0, 0, 1, DASH_TEXT);
+                GLCD_TextString(0, 0, DASH_TEXT);
                 break;
         }
     }
+
+    GLCD_TextFlush();
 }
 
 /*
@@ -0,0 +1,310 @@
+/*----------------------------------------------------------------------------
+ * Name:    Font_16x24_c.h
+ * Purpose: Font_16x24_h.h compiled by host/font_compiler.c
+ *          (112 characters of 16x24 pixels, 2443 bytes instead of 5376)
+ *          Do not edit, compile the font table again instead.
+ *----------------------------------------------------------------------------*/
+
+#ifndef __FONT_16X24_C_H
+#define __FONT_16X24_C_H
+
+static const GLCD_GLYPH Font_16x24_glyphs[] = {
+  { 0x00,  0,  0 },   /* 0x20: Space ' ' */
+  { 0x71,  1, 17 },   /* 0x21: '!' */
+  { 0x25,  2,  6 },   /* 0x22: '"' */
+  { 0x1B,  6, 17 },   /* 0x23: '#' */
+  { 0x2A,  1, 20 },   /* 0x24: '$' */
+  { 0x0E,  3, 18 },   /* 0x25: '%' */
+  { 0x1D,  1, 17 },   /* 0x26: '&' */
+  { 0x21,  2,  6 },   /* 0x27: ''' */
+  { 0x45,  1, 22 },   /* 0x28: '(' */
+  { 0x55,  1, 22 },   /* 0x29: ')' */
+  { 0x37,  6,  7 },   /* 0x2A: '*' */
+  { 0x2B,  6, 12 },   /* 0x2B: '+' */
+  { 0x71, 17,  5 },   /* 0x2C: ',' */
+  { 0x55, 12,  2 },   /* 0x2D: '-' */
+  { 0x61, 17,  2 },   /* 0x2E: '.' */
+  { 0x56,  1, 17 },   /* 0x2F: '/' */
+  { 0x2A,  1, 17 },   /* 0x30: '0' */
+  { 0x35,  1, 17 },   /* 0x31: '1' */
+  { 0x2A,  1, 17 },   /* 0x32: '2' */
+  { 0x2A,  1, 17 },   /* 0x33: '3' */
+  { 0x2B,  1, 17 },   /* 0x34: '4' */
+  { 0x2A,  1, 17 },   /* 0x35: '5' */
+  { 0x2A,  1, 17 },   /* 0x36: '6' */
+  { 0x2A,  1, 17 },   /* 0x37: '7' */
+  { 0x2A,  1, 17 },   /* 0x38: '8' */
+  { 0x2A,  1, 17 },   /* 0x39: '9' */
+  { 0x71,  6, 12 },   /* 0x3A: ':' */
+  { 0x71,  6, 15 },   /* 0x3B: ';' */
+  { 0x39,  8, 11 },   /* 0x3C: '<' */
+  { 0x39,  8,  5 },   /* 0x3D: '=' */
+  { 0x39,  8, 11 },   /* 0x3E: '>' */
+  { 0x2A,  1, 17 },   /* 0x3F: '?' */
+  { 0x0E,  2, 16 },   /* 0x40: '@' */
+  { 0x1E,  1, 17 },   /* 0x41: 'A' */
+  { 0x2B,  1, 17 },   /* 0x42: 'B' */
+  { 0x1D,  1, 17 },   /* 0x43: 'C' */
+  { 0x1C,  1, 17 },   /* 0x44: 'D' */
+  { 0x2B,  1, 17 },   /* 0x45: 'E' */
+  { 0x3A,  1, 17 },   /* 0x46: 'F' */
+  { 0x0F,  1, 17 },   /* 0x47: 'G' */
+  { 0x2B,  1, 17 },   /* 0x48: 'H' */
+  { 0x71,  1, 17 },   /* 0x49: 'I' */
+  { 0x37,  1, 17 },   /* 0x4A: 'J' */
+  { 0x1D,  1, 17 },   /* 0x4B: 'K' */
+  { 0x39,  1, 17 },   /* 0x4C: 'L' */
+  { 0x1E,  1, 17 },   /* 0x4D: 'M' */
+  { 0x2B,  1, 17 },   /* 0x4E: 'N' */
+  { 0x0F,  1, 17 },   /* 0x4F: 'O' */
+  { 0x2B,  1, 17 },   /* 0x50: 'P' */
+  { 0x0F,  1, 18 },   /* 0x51: 'Q' */
+  { 0x1D,  1, 17 },   /* 0x52: 'R' */
+  { 0x1C,  1, 17 },   /* 0x53: 'S' */
+  { 0x1D,  1, 17 },   /* 0x54: 'T' */
+  { 0x2B,  1, 17 },   /* 0x55: 'U' */
+  { 0x0E,  1, 17 },   /* 0x56: 'V' */
+  { 0x0E,  1, 17 },   /* 0x57: 'W' */
+  { 0x0F,  1, 17 },   /* 0x58: 'X' */
+  { 0x0F,  1, 17 },   /* 0x59: 'Y' */
+  { 0x1D,  1, 17 },   /* 0x5A: 'Z' */
+  { 0x54,  1, 22 },   /* 0x5B: '[' */
+  { 0x46,  1, 17 },   /* 0x5C: '\' */
+  { 0x54,  1, 22 },   /* 0x5D: ']' */
+  { 0x38,  2,  9 },   /* 0x5E: '^' */
+  { 0x0F, 17,  2 },   /* 0x5F: '_' */
+  { 0x21,  1,  6 },   /* 0x60: ''' */
+  { 0x2A,  6, 12 },   /* 0x61: 'a' */
+  { 0x39,  1, 17 },   /* 0x62: 'b' */
+  { 0x38,  6, 12 },   /* 0x63: 'c' */
+  { 0x39,  1, 17 },   /* 0x64: 'd' */
+  { 0x39,  6, 12 },   /* 0x65: 'e' */
+  { 0x47,  1, 17 },   /* 0x66: 'f' */
+  { 0x29,  6, 17 },   /* 0x67: 'g' */
+  { 0x39,  1, 17 },   /* 0x68: 'h' */
+  { 0x61,  1, 17 },   /* 0x69: 'i' */
+  { 0x34,  1, 22 },   /* 0x6A: 'j' */
+  { 0x29,  1, 17 },   /* 0x6B: 'k' */
+  { 0x61,  1, 17 },   /* 0x6C: 'l' */
+  { 0x0F,  6, 12 },   /* 0x6D: 'm' */
+  { 0x39,  6, 12 },   /* 0x6E: 'n' */
+  { 0x39,  6, 12 },   /* 0x6F: 'o' */
+  { 0x39,  6, 17 },   /* 0x70: 'p' */
+  { 0x39,  6, 17 },   /* 0x71: 'q' */
+  { 0x46,  6, 12 },   /* 0x72: 'r' */
+  { 0x38,  6, 12 },   /* 0x73: 's' */
+  { 0x46,  2, 16 },   /* 0x74: 't' */
+  { 0x39,  6, 12 },   /* 0x75: 'u' */
+  { 0x2A,  6, 12 },   /* 0x76: 'v' */
+  { 0x0E,  6, 12 },   /* 0x77: 'w' */
+  { 0x2B,  6, 12 },   /* 0x78: 'x' */
+  { 0x3A,  6, 17 },   /* 0x79: 'y' */
+  { 0x2A,  6, 12 },   /* 0x7A: 'z' */
+  { 0x45,  1, 21 },   /* 0x7B: '{' */
+  { 0x71,  1, 22 },   /* 0x7C: '|' */
+  { 0x55,  1, 21 },   /* 0x7D: '}' */
+  { 0x39,  8,  3 },   /* 0x7E: '~' */
+  { 0x00,  0,  0 },   /* 0x7F: ' ' */
+  { 0x1D,  5, 15 },   /* 0x80: Circle - Empty */
+  { 0x1D,  5, 15 },   /* 0x81: Circle - Full */
+  { 0x39,  7, 10 },   /* 0x82: Square - Empty */
+  { 0x39,  7, 10 },   /* 0x83: Square - Full */
+  { 0x39, 12,  8 },   /* 0x84: Up - Empty */
+  { 0x39, 12,  8 },   /* 0x85: Up - Full */
+  { 0x39,  4,  8 },   /* 0x86: Down - Empty */
+  { 0x39,  4,  8 },   /* 0x87: Down - Full */
+  { 0x17,  7, 10 },   /* 0x88: Left - Empty */
+  { 0x17,  7, 10 },   /* 0x89: Left - Full */
+  { 0x77,  7, 10 },   /* 0x8A: Right - Empty */
+  { 0x77,  7, 10 },   /* 0x8B: Right - Full */
+  { 0x38,  1, 22 },   /* 0x8C: Wait - Empty */
+  { 0x38,  1, 22 },   /* 0x8D: Wait - Full */
+  { 0x1D,  1, 21 },   /* 0x8E: Walk - Empty */
+  { 0x1D,  1, 21 }    /* 0x8F: Walk - Full */
+};
+
+static const unsigned short Font_16x24_index[] = {
+  0, 1014, 1623, 3051, 3936, 5757, 7270, 9173,
+  10407, 11425, 12375, 13451, 14240, 15180
+};
+
+static const unsigned char Font_16x24_bits[] = {
+  0xFF, 0xFF, 0xFF, 0xC3, 0xF3, 0xCF, 0x3C, 0xF3, 0xCD, 0x8C, 0x18, 0xC1,
+  0x8C, 0x0C, 0x60, 0xC6, 0x3F, 0xFF, 0xFF, 0xCC, 0x60, 0xE7, 0x06, 0x33,
+  0xFF, 0xFF, 0xFC, 0x63, 0x06, 0x30, 0x31, 0x83, 0x18, 0x31, 0x81, 0x00,
+  0xF8, 0x7F, 0xCE, 0x9F, 0x91, 0xE2, 0x30, 0x46, 0x09, 0x83, 0xF1, 0xF8,
+  0x74, 0x1C, 0x83, 0x11, 0xE2, 0x3C, 0x4E, 0xCB, 0x9F, 0xE0, 0xF8, 0x04,
+  0x00, 0x80, 0xC0, 0x70, 0xC1, 0xB1, 0x82, 0x21, 0x84, 0x43, 0x08, 0x83,
+  0x11, 0x06, 0x22, 0x06, 0x6C, 0x0C, 0x73, 0x8C, 0x0D, 0x98, 0x11, 0x18,
+  0x22, 0x30, 0x44, 0x30, 0x88, 0x61, 0x10, 0x63, 0x60, 0xC3, 0x80, 0xC0,
+  0x3C, 0x01, 0xF8, 0x0E, 0x70, 0x30, 0xC0, 0xC3, 0x01, 0x98, 0x03, 0xE0,
+  0x07, 0x80, 0x1F, 0x18, 0xCE, 0x66, 0x1C, 0xF0, 0x33, 0x80, 0xCE, 0x03,
+  0x7E, 0x0F, 0x9F, 0xE4, 0x3E, 0x3F, 0xFE, 0x0C, 0x18, 0x30, 0xC1, 0x86,
+  0x0C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x18, 0x63, 0x0C, 0x63, 0x08, 0x01,
+  0x0C, 0x63, 0x0C, 0x61, 0x8C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x06, 0x18,
+  0x30, 0xC1, 0x83, 0x04, 0x60, 0x63, 0x6F, 0xFC, 0xF1, 0x9B, 0x9C, 0x18,
+  0x01, 0x80, 0x18, 0x01, 0x80, 0x18, 0x3F, 0xFF, 0xFF, 0xC1, 0x80, 0x18,
+  0x01, 0x80, 0x18, 0x01, 0x83, 0xE9, 0xFF, 0xFF, 0xC1, 0x81, 0x83, 0x06,
+  0x06, 0x0C, 0x18, 0x38, 0x30, 0x60, 0xC0, 0xC1, 0x83, 0x03, 0x06, 0x3E,
+  0x0F, 0xE3, 0x8E, 0x60, 0xD8, 0x0F, 0x01, 0xE0, 0x3C, 0x07, 0x80, 0xF0,
+  0x1E, 0x03, 0xC0, 0x78, 0x0D, 0x83, 0x38, 0xE3, 0xF8, 0x3E, 0x20, 0xC3,
+  0x8F, 0xB3, 0xC7, 0x0C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x0C, 0x30, 0x1F,
+  0x0F, 0xF9, 0x83, 0x60, 0x3C, 0x07, 0x80, 0x30, 0x03, 0x00, 0x30, 0x03,
+  0x00, 0x30, 0x03, 0x00, 0x30, 0x03, 0x00, 0x37, 0xFF, 0xFF, 0xE1, 0xE0,
+  0xFF, 0x38, 0x66, 0x06, 0xC0, 0xD8, 0x01, 0x80, 0x1E, 0x07, 0xC1, 0x80,
+  0x60, 0x0C, 0x01, 0x80, 0xF0, 0x1B, 0x06, 0x3F, 0xC3, 0xE0, 0xC0, 0x0E,
+  0x00, 0xF0, 0x0F, 0x00, 0xD8, 0x0C, 0xC0, 0xC6, 0x0C, 0x60, 0xC3, 0x0C,
+  0x18, 0xC0, 0xFF, 0xFF, 0xFF, 0xCC, 0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x1F,
+  0xF3, 0xFE, 0x00, 0xC0, 0x18, 0x01, 0x8F, 0xB3, 0xFE, 0xE1, 0xF8, 0x06,
+  0x00, 0xC0, 0x18, 0x03, 0x01, 0xB0, 0x77, 0x0C, 0x7F, 0x87, 0xC1, 0xF0,
+  0x7F, 0x9C, 0x3B, 0x03, 0x00, 0x60, 0x06, 0x3C, 0xDF, 0xDB, 0x8F, 0xE0,
+  0xF8, 0x0F, 0x01, 0xE0, 0x3E, 0x0C, 0xE3, 0x8F, 0xE0, 0xF8, 0xFF, 0xFF,
+  0xFD, 0x80, 0x18, 0x03, 0x00, 0x30, 0x07, 0x00, 0x60, 0x0E, 0x00, 0xC0,
+  0x1C, 0x01, 0x80, 0x30, 0x07, 0x00, 0x60, 0x0C, 0x01, 0x83, 0xE0, 0xFE,
+  0x38, 0xE6, 0x0C, 0xC1, 0x98, 0x31, 0x8E, 0x3F, 0x87, 0xF1, 0x83, 0x60,
+  0x3C, 0x07, 0x80, 0xF0, 0x1B, 0x0E, 0x7F, 0xC3, 0xE0, 0x7C, 0x1F, 0xC7,
+  0x1C, 0xC1, 0xF0, 0x1E, 0x03, 0xC0, 0x7C, 0x1F, 0xC7, 0x6F, 0xEC, 0xF1,
+  0x80, 0x18, 0x03, 0x00, 0x70, 0xE7, 0xF8, 0x3E, 0x78, 0x00, 0x07, 0xF8,
+  0x00, 0x07, 0xD3, 0x00, 0x70, 0x0F, 0x80, 0xF8, 0x0F, 0x80, 0x60, 0xF8,
+  0xF8, 0xF8, 0x70, 0x10, 0x07, 0xFE, 0x00, 0x00, 0x00, 0x07, 0xFE, 0x00,
+  0x80, 0xE1, 0xF1, 0xF1, 0xF0, 0x60, 0x1F, 0x01, 0xF0, 0x1F, 0x00, 0xE0,
+  0x08, 0xF8, 0x7F, 0xCC, 0x1B, 0x01, 0xE0, 0x3C, 0x00, 0xC0, 0x0C, 0x00,
+  0xC0, 0x0C, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x00, 0x00, 0x01, 0x80, 0x30,
+  0x0F, 0xC0, 0x60, 0x61, 0x00, 0x22, 0x9C, 0x29, 0x44, 0x51, 0x04, 0x62,
+  0x04, 0xC4, 0x09, 0x88, 0x12, 0x88, 0x24, 0x98, 0x88, 0xCE, 0x28, 0x00,
+  0x48, 0x01, 0x0C, 0x0C, 0x07, 0xE0, 0x03, 0x80, 0x07, 0x00, 0x1B, 0x00,
+  0x36, 0x00, 0x6C, 0x01, 0x8C, 0x03, 0x18, 0x0C, 0x18, 0x18, 0x30, 0x30,
+  0x60, 0xFF, 0xE1, 0xFF, 0xC7, 0x01, 0xCC, 0x01, 0x98, 0x03, 0x60, 0x03,
+  0xC0, 0x06, 0x1F, 0xE7, 0xFE, 0x60, 0x6C, 0x06, 0xC0, 0x6C, 0x06, 0x60,
+  0x63, 0xFE, 0x7F, 0xEC, 0x07, 0x80, 0x78, 0x07, 0x80, 0x78, 0x06, 0xC0,
+  0x6F, 0xFE, 0x3F, 0xE1, 0xF0, 0x1F, 0xF0, 0xE0, 0xE3, 0x01, 0xDC, 0x03,
+  0x60, 0x06, 0x00, 0x18, 0x00, 0x60, 0x01, 0x80, 0x06, 0x00, 0x18, 0x00,
+  0x78, 0x01, 0xF0, 0x0C, 0xC0, 0x71, 0xFF, 0x01, 0xF8, 0x07, 0xFC, 0xFF,
+  0xE7, 0x03, 0x60, 0x1B, 0x00, 0xF0, 0x07, 0x80, 0x3C, 0x01, 0xE0, 0x0F,
+  0x00, 0x78, 0x03, 0xC0, 0x1B, 0x00, 0xD8, 0x06, 0x70, 0x33, 0xFF, 0x87,
+  0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xDF,
+  0xFD, 0xFF, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06,
+  0xFF, 0xDF, 0xF8, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00,
+  0xC0, 0x18, 0x7F, 0x01, 0xFF, 0xC3, 0xC1, 0xE3, 0x00, 0x77, 0x00, 0x36,
+  0x00, 0x38, 0x00, 0x18, 0x00, 0x1F, 0xF0, 0x1F, 0xF0, 0x1E, 0x00, 0x1E,
+  0x00, 0x3E, 0x00, 0x36, 0x00, 0x77, 0x81, 0xE1, 0xFF, 0xC0, 0x7F, 0x06,
+  0x01, 0xE0, 0x1E, 0x01, 0xE0, 0x1E, 0x01, 0xE0, 0x1E, 0x01, 0xFF, 0xFF,
+  0xFF, 0xE0, 0x1E, 0x01, 0xE0, 0x1E, 0x01, 0xE0, 0x1E, 0x01, 0xE0, 0x1E,
+  0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+  0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x78, 0x7C, 0xEF, 0xC7, 0x8C, 0x01,
+  0x98, 0x06, 0x30, 0x18, 0x60, 0x60, 0xC1, 0x81, 0x86, 0x03, 0x18, 0x06,
+  0x60, 0x1D, 0x80, 0xDE, 0x06, 0x38, 0x30, 0x61, 0x81, 0x8C, 0x06, 0x60,
+  0x1B, 0x00, 0x78, 0x01, 0x80, 0x60, 0x18, 0x06, 0x01, 0x80, 0x60, 0x18,
+  0x06, 0x01, 0x80, 0x60, 0x18, 0x06, 0x01, 0x80, 0x60, 0x18, 0x07, 0xFF,
+  0xFF, 0xFC, 0x01, 0xFC, 0x07, 0xF8, 0x0F, 0xF0, 0x1F, 0xB0, 0x6F, 0x60,
+  0xDE, 0xC1, 0xBD, 0x83, 0x79, 0x8C, 0xF3, 0x19, 0xE6, 0x33, 0xC6, 0xC7,
+  0x8D, 0x8F, 0x1B, 0x1E, 0x36, 0x3C, 0x38, 0x78, 0x70, 0xF0, 0x0F, 0x01,
+  0xF0, 0x3F, 0x03, 0xF0, 0x6F, 0x06, 0xF0, 0xCF, 0x0C, 0xF1, 0x8F, 0x30,
+  0xF3, 0x0F, 0x60, 0xF6, 0x0F, 0xC0, 0xFC, 0x0F, 0x80, 0xF0, 0x0C, 0x1F,
+  0x80, 0x7F, 0xE0, 0xE0, 0x71, 0xC0, 0x39, 0x80, 0x1B, 0x00, 0x0F, 0x00,
+  0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0D, 0x80,
+  0x19, 0xC0, 0x38, 0xE0, 0x70, 0x7F, 0xE0, 0x1F, 0x80, 0xFF, 0xDF, 0xFF,
+  0x80, 0xF0, 0x0F, 0x00, 0xF0, 0x0F, 0x00, 0xD8, 0x0D, 0xFF, 0xC7, 0xFC,
+  0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xC1, 0xF8,
+  0x07, 0xFE, 0x0E, 0x07, 0x1C, 0x03, 0x98, 0x01, 0xB8, 0x00, 0xF0, 0x00,
+  0xF0, 0x00, 0xF0, 0x00, 0xF0, 0x00, 0xF0, 0x00, 0xF8, 0x01, 0xD8, 0xC1,
+  0x8F, 0xC3, 0x8F, 0x07, 0x0F, 0xFE, 0x3D, 0xF8, 0x30, 0x00, 0x07, 0xFF,
+  0x3F, 0xFD, 0xC0, 0x36, 0x00, 0xD8, 0x03, 0x60, 0x0D, 0xC0, 0x33, 0xFF,
+  0xC3, 0xFF, 0x06, 0x0C, 0x30, 0x31, 0x80, 0xCC, 0x03, 0x30, 0x0D, 0x80,
+  0x36, 0x00, 0xF0, 0x03, 0x0F, 0x81, 0xFF, 0x0C, 0x1C, 0xC0, 0x66, 0x03,
+  0x00, 0x18, 0x01, 0xC1, 0xFC, 0x3F, 0x83, 0xC0, 0x38, 0x01, 0x80, 0x3C,
+  0x01, 0xE0, 0x1D, 0xC1, 0xC7, 0xFC, 0x1F, 0x87, 0xFF, 0xFF, 0xFF, 0x81,
+  0x80, 0x06, 0x00, 0x18, 0x00, 0x60, 0x01, 0x80, 0x06, 0x00, 0x18, 0x00,
+  0x60, 0x01, 0x80, 0x06, 0x00, 0x18, 0x00, 0x60, 0x01, 0x80, 0x06, 0x00,
+  0x18, 0x18, 0x07, 0x80, 0x78, 0x07, 0x80, 0x78, 0x07, 0x80, 0x78, 0x07,
+  0x80, 0x78, 0x07, 0x80, 0x78, 0x07, 0x80, 0x78, 0x07, 0x80, 0x6C, 0x0C,
+  0xFF, 0xC3, 0xF1, 0x80, 0x0D, 0x80, 0x33, 0x00, 0x66, 0x00, 0xC6, 0x03,
+  0x0C, 0x06, 0x18, 0x0C, 0x18, 0x30, 0x30, 0x60, 0x71, 0xC0, 0x63, 0x00,
+  0xC6, 0x01, 0xDC, 0x01, 0xB0, 0x03, 0x60, 0x03, 0x80, 0x07, 0x03, 0x00,
+  0x1E, 0x1C, 0x3C, 0x38, 0x78, 0x70, 0xD9, 0xB3, 0x33, 0x66, 0x66, 0xCC,
+  0xCD, 0x99, 0x9B, 0x33, 0x36, 0x63, 0x6D, 0x86, 0xDB, 0x0D, 0xB6, 0x1A,
+  0x2C, 0x3C, 0x78, 0x38, 0xE0, 0x71, 0xC7, 0x00, 0x7B, 0x80, 0x61, 0x80,
+  0xC0, 0xC1, 0x80, 0x63, 0x80, 0x73, 0x00, 0x3E, 0x00, 0x1C, 0x00, 0x1C,
+  0x00, 0x1E, 0x00, 0x37, 0x00, 0x63, 0x80, 0xE1, 0x80, 0xC0, 0xC1, 0x80,
+  0x63, 0x00, 0x77, 0x00, 0x3E, 0x00, 0x1B, 0x00, 0x31, 0x80, 0x61, 0xC0,
+  0xE0, 0xC1, 0xC0, 0x61, 0x80, 0x33, 0x00, 0x3F, 0x00, 0x1E, 0x00, 0x0C,
+  0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C,
+  0x00, 0x0C, 0x07, 0xFF, 0xDF, 0xFF, 0x60, 0x00, 0xC0, 0x01, 0x80, 0x03,
+  0x00, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00, 0xC0,
+  0x01, 0x80, 0x03, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0xC6, 0x31,
+  0x8C, 0x63, 0x18, 0xC6, 0x31, 0x8C, 0x63, 0x18, 0xC7, 0xFF, 0x83, 0x06,
+  0x18, 0x30, 0x61, 0x83, 0x06, 0x1C, 0x30, 0x60, 0xC3, 0x06, 0x0C, 0x30,
+  0x60, 0xFF, 0xF1, 0x8C, 0x63, 0x18, 0xC6, 0x31, 0x8C, 0x63, 0x18, 0xC6,
+  0x31, 0x8F, 0xFC, 0x70, 0x38, 0x36, 0x1B, 0x0D, 0x8C, 0x66, 0x36, 0x0F,
+  0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE3, 0xF0, 0xFF, 0x30, 0x76, 0x06,
+  0xF0, 0x1F, 0xE3, 0x3E, 0x60, 0x6C, 0x0D, 0xE3, 0xBF, 0xEC, 0x78, 0x01,
+  0x80, 0x60, 0x18, 0x06, 0x01, 0x8F, 0x6F, 0xFB, 0x0F, 0x81, 0xE0, 0x78,
+  0x1E, 0x07, 0x81, 0xE0, 0x6C, 0x3B, 0xFE, 0x3D, 0x9E, 0x1F, 0xDC, 0x6C,
+  0x18, 0x0C, 0x06, 0x03, 0x01, 0xE0, 0xF8, 0xCF, 0xE3, 0xC6, 0x01, 0x80,
+  0x60, 0x18, 0x06, 0x01, 0xBC, 0x7F, 0xDC, 0x36, 0x07, 0x81, 0xE0, 0x78,
+  0x1E, 0x07, 0x81, 0xF0, 0xDF, 0xF6, 0xF0, 0x3C, 0x3F, 0xCC, 0x36, 0x07,
+  0xFF, 0xFF, 0xE0, 0x18, 0x07, 0x83, 0xF0, 0xCF, 0xF1, 0xF1, 0xF1, 0xF8,
+  0x18, 0x18, 0x18, 0xFE, 0xFE, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+  0x18, 0x18, 0x19, 0xBC, 0x7F, 0xDC, 0x36, 0x07, 0x81, 0xE0, 0x78, 0x1E,
+  0x07, 0x81, 0xF0, 0xDF, 0xF6, 0xF1, 0x80, 0x60, 0x6C, 0x3B, 0xFC, 0x3E,
+  0x00, 0x60, 0x18, 0x06, 0x01, 0x80, 0x67, 0xDB, 0xFF, 0xC3, 0xE0, 0x78,
+  0x1E, 0x07, 0x81, 0xE0, 0x78, 0x1E, 0x07, 0x81, 0xE0, 0x7E, 0x07, 0xFF,
+  0xFF, 0xFE, 0x30, 0x00, 0x03, 0x18, 0xC6, 0x31, 0x8C, 0x63, 0x18, 0xC6,
+  0x31, 0x8C, 0x7D, 0xE0, 0x18, 0x06, 0x01, 0x80, 0x60, 0x1E, 0x06, 0xC1,
+  0x98, 0x63, 0x18, 0x66, 0x0D, 0x87, 0xE3, 0x39, 0xC6, 0x61, 0xB0, 0x78,
+  0x1F, 0xFF, 0xFF, 0xFF, 0xFE, 0x78, 0xF8, 0xFD, 0xFF, 0xC7, 0x8F, 0x83,
+  0x07, 0x83, 0x07, 0x83, 0x07, 0x83, 0x07, 0x83, 0x07, 0x83, 0x07, 0x83,
+  0x07, 0x83, 0x07, 0x83, 0x06, 0x79, 0xBF, 0xFC, 0x3E, 0x07, 0x81, 0xE0,
+  0x78, 0x1E, 0x07, 0x81, 0xE0, 0x78, 0x1E, 0x06, 0x3C, 0x3F, 0xCC, 0x36,
+  0x07, 0x81, 0xE0, 0x78, 0x1E, 0x07, 0x81, 0xB0, 0xCF, 0xF0, 0xF0, 0x3D,
+  0xBF, 0xEC, 0x3E, 0x07, 0x81, 0xE0, 0x78, 0x1E, 0x07, 0x81, 0xB0, 0xEF,
+  0xF8, 0xF6, 0x01, 0x80, 0x60, 0x18, 0x06, 0x01, 0xEF, 0x1F, 0xF7, 0x0D,
+  0x81, 0xE0, 0x78, 0x1E, 0x07, 0x81, 0xE0, 0x7C, 0x37, 0xFD, 0xBC, 0x60,
+  0x18, 0x06, 0x01, 0x80, 0x60, 0x1E, 0xDF, 0x87, 0x06, 0x0C, 0x18, 0x30,
+  0x60, 0xC1, 0x83, 0x06, 0x7C, 0x3F, 0x71, 0xF0, 0x60, 0x73, 0xF3, 0xE3,
+  0x01, 0x83, 0xE3, 0xBF, 0x8F, 0x82, 0x06, 0x0C, 0x19, 0xFF, 0xF8, 0xC1,
+  0x83, 0x06, 0x0C, 0x18, 0x30, 0x67, 0xCF, 0x18, 0x1E, 0x07, 0x81, 0xE0,
+  0x78, 0x1E, 0x07, 0x81, 0xE0, 0x78, 0x1F, 0x0F, 0xFF, 0x67, 0x98, 0x0D,
+  0x83, 0x30, 0x66, 0x0C, 0x63, 0x0C, 0x61, 0x8C, 0x1B, 0x03, 0x60, 0x6C,
+  0x07, 0x00, 0xE1, 0x07, 0x06, 0x0E, 0x0E, 0x1C, 0x3C, 0x6C, 0x78, 0xD8,
+  0xF1, 0xB1, 0xB6, 0x36, 0x6C, 0x6C, 0xD8, 0xD8, 0xE0, 0xE1, 0xC1, 0xC3,
+  0x83, 0x9C, 0x0E, 0xE1, 0xC6, 0x18, 0x33, 0x01, 0xE0, 0x1E, 0x01, 0xE0,
+  0x1E, 0x03, 0x30, 0x61, 0x8E, 0x1D, 0xC0, 0xF8, 0x0D, 0x83, 0x30, 0x66,
+  0x1C, 0x63, 0x0C, 0x61, 0x9C, 0x1B, 0x03, 0x60, 0x38, 0x07, 0x00, 0xE0,
+  0x0C, 0x01, 0x80, 0x38, 0x03, 0xC0, 0x3B, 0xFF, 0xFF, 0xF6, 0x00, 0x60,
+  0x06, 0x00, 0x60, 0x06, 0x00, 0x60, 0x06, 0x00, 0x6F, 0xFF, 0xFF, 0xF0,
+  0x60, 0xC3, 0x0C, 0x30, 0xC3, 0x06, 0x18, 0x31, 0x84, 0x30, 0xC3, 0x0C,
+  0x30, 0xC6, 0x30, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0xC6, 0x38, 0xC3,
+  0x0C, 0x30, 0xC6, 0x18, 0xC1, 0x82, 0x0C, 0x30, 0xC3, 0x0C, 0x30, 0x60,
+  0xE1, 0xEF, 0xFD, 0xE1, 0x07, 0x80, 0x61, 0x82, 0x01, 0x10, 0x02, 0x40,
+  0x0A, 0x00, 0x18, 0x00, 0x60, 0x01, 0x80, 0x06, 0x00, 0x14, 0x00, 0x90,
+  0x02, 0x20, 0x10, 0x61, 0x80, 0x78, 0x01, 0xE0, 0x1F, 0xE0, 0xFF, 0xC7,
+  0xFF, 0x9F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFD,
+  0xFF, 0xE7, 0xFF, 0x8F, 0xFC, 0x1F, 0xE0, 0x1E, 0x03, 0xF1, 0xFE, 0xC0,
+  0xF0, 0x3C, 0x0F, 0x03, 0xC0, 0xF0, 0x37, 0xF8, 0xFC, 0x3F, 0x1F, 0xEF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x8F, 0xC0, 0xC0, 0x78,
+  0x33, 0x18, 0x6C, 0x0F, 0x03, 0xFF, 0xFF, 0xF0, 0xC0, 0x78, 0x3F, 0x1F,
+  0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xF0, 0x36, 0x18,
+  0xCC, 0x1E, 0x03, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF7, 0xF8, 0xFC, 0x1E,
+  0x03, 0x0F, 0x0F, 0x8C, 0xCC, 0x6C, 0x3C, 0x3C, 0x6C, 0xCF, 0x8F, 0x0F,
+  0x0F, 0x8F, 0xCF, 0xEF, 0xFF, 0xFF, 0xEF, 0xCF, 0x8F, 0x00, 0xF1, 0xF3,
+  0x36, 0x3C, 0x3C, 0x36, 0x33, 0x31, 0xF0, 0xF0, 0xF1, 0xF3, 0xF7, 0xFF,
+  0xFF, 0xF7, 0xF3, 0xF1, 0xF0, 0xF1, 0xC1, 0x10, 0x88, 0x28, 0x63, 0x40,
+  0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x22, 0x11, 0x08, 0x84, 0x42,
+  0x21, 0x10, 0x88, 0x44, 0x22, 0x11, 0x07, 0x07, 0xC3, 0xE0, 0xE1, 0xFD,
+  0xBB, 0xDD, 0xEE, 0xF7, 0x7B, 0xBD, 0xDE, 0xEC, 0xD8, 0x6C, 0x36, 0x1B,
+  0x0D, 0x86, 0xC3, 0x61, 0xB0, 0xD8, 0x6C, 0x03, 0x80, 0x11, 0x00, 0x44,
+  0x00, 0xA0, 0x0C, 0x60, 0x40, 0x41, 0x01, 0x04, 0x04, 0x20, 0x09, 0x00,
+  0x14, 0x00, 0x40, 0xA0, 0x04, 0x40, 0x11, 0x00, 0x82, 0x04, 0x04, 0x10,
+  0x10, 0x80, 0x22, 0x00, 0x90, 0x02, 0x80, 0x08, 0x0E, 0x00, 0x7C, 0x01,
+  0xF0, 0x03, 0x80, 0x3F, 0x81, 0xBB, 0x06, 0xEC, 0x1B, 0xB0, 0xCE, 0x66,
+  0x38, 0xF0, 0xE1, 0x03, 0x80, 0x1B, 0x00, 0x6C, 0x03, 0x38, 0x18, 0x70,
+  0x60, 0xC3, 0x01, 0x8C, 0x06, 0x60, 0x1B, 0x00, 0x60, 0x00, 0x00
+};
+
+static const GLCD_FONT Font_16x24 = {
+  16, 24, 0x20, 112, Font_16x24_glyphs, Font_16x24_index, Font_16x24_bits
+};
+
+#endif /* __FONT_16X24_C_H */
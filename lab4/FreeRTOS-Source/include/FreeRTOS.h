@@ -185,6 +185,18 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configUSE_TIMERS 0
 #endif
 
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SIZE
+	#define configTIMER_WHEEL_SIZE 32
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH
+	#define configTIMER_COMMAND_BATCH 4
+#endif
+
 #ifndef configUSE_COUNTING_SEMAPHORES
 	#define configUSE_COUNTING_SEMAPHORES 0
 #endif
@@ -193,6 +205,38 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configUSE_ALTERNATIVE_API 0
 #endif
 
+#ifndef configUSE_BLOCK_POOLS
+	#define configUSE_BLOCK_POOLS 0
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 0
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE 0
+#endif
+
+#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+	#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+#endif
+
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
+	#error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#endif
+
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
+#endif
+
+#ifndef configPRE_SLEEP_PROCESSING
+	#define configPRE_SLEEP_PROCESSING( xExpectedIdleTime )
+#endif
+
+#ifndef configPOST_SLEEP_PROCESSING
+	#define configPOST_SLEEP_PROCESSING( xExpectedIdleTime )
+#endif
+
 #ifndef portCRITICAL_NESTING_IN_TCB
 	#define portCRITICAL_NESTING_IN_TCB 0
 #endif
@@ -236,6 +280,14 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 		#error If configUSE_TIMERS is set to 1 then configTIMER_TASK_STACK_DEPTH must also be defined.
 	#endif /* configTIMER_TASK_STACK_DEPTH */
 
+	#if ( configUSE_TIMER_WHEEL == 1 ) && ( ( configTIMER_WHEEL_SIZE & ( configTIMER_WHEEL_SIZE - 1 ) ) != 0 )
+		#error configTIMER_WHEEL_SIZE must be a power of 2.
+	#endif
+
+	#if ( configTIMER_COMMAND_BATCH < 1 )
+		#error configTIMER_COMMAND_BATCH must be at least 1.
+	#endif
+
 #endif /* configUSE_TIMERS */
 
 #ifndef INCLUDE_xTaskGetSchedulerState
@@ -460,10 +512,38 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )
 #endif
 
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+	#define traceTASK_NOTIFY_TAKE_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+	#define traceTASK_NOTIFY_WAIT_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY
+	#define traceTASK_NOTIFY( pxTaskToNotify )
+#endif
+
+#ifndef traceTASK_NOTIFY_FROM_ISR
+	#define traceTASK_NOTIFY_FROM_ISR( pxTaskToNotify )
+#endif
+
 #ifndef traceTASK_INCREMENT_TICK
 	#define traceTASK_INCREMENT_TICK( xTickCount )
 #endif
 
+#ifndef traceINCREASE_TICK_COUNT
+	#define traceINCREASE_TICK_COUNT( xTicksToJump )
+#endif
+
+#ifndef traceLOW_POWER_IDLE_BEGIN
+	#define traceLOW_POWER_IDLE_BEGIN()
+#endif
+
+#ifndef traceLOW_POWER_IDLE_END
+	#define traceLOW_POWER_IDLE_END()
+#endif
+
 #ifndef traceTIMER_CREATE
 	#define traceTIMER_CREATE( pxNewTimer )
 #endif
@@ -526,5 +606,116 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define vPortFreeAligned( pvBlockToFree ) vPortFree( pvBlockToFree )
 #endif
 
+/* Set configSUPPORT_STATIC_ALLOCATION to 1 to be able to create tasks, queues,
+semaphores and timers in memory provided by the application
+(xTaskCreateStatic() and friends), and configSUPPORT_DYNAMIC_ALLOCATION to 0
+to build the kernel without any calls to pvPortMalloc(), so no heap
+implementation needs to be linked. */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+	#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
+	#error At least one of configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION must be set to 1.
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* The structures below have the same size and alignment as the kernel's
+	own TCB, queue and timer structures, which are private to tasks.c, queue.c
+	and timers.c.  They are only there so the application can allocate the
+	memory for a kernel object statically, and their members must not be
+	used.  Each source file checks at compile time that the sizes match. */
+	typedef struct xSTATIC_LIST_ITEM
+	{
+		portTickType xDummy1;
+		void *pvDummy2[ 4 ];
+	} xStaticListItem;
+
+	typedef struct xSTATIC_MINI_LIST_ITEM
+	{
+		portTickType xDummy1;
+		void *pvDummy2[ 2 ];
+	} xStaticMiniListItem;
+
+	typedef struct xSTATIC_LIST
+	{
+		unsigned portBASE_TYPE uxDummy1;
+		void *pvDummy2;
+		xStaticMiniListItem xDummy3;
+	} xStaticList;
+
+	/* Memory for a task's TCB, see xTaskCreateStatic(). */
+	typedef struct xSTATIC_TCB
+	{
+		void *pxDummy1;
+		#if ( portUSING_MPU_WRAPPERS == 1 )
+			xMPU_SETTINGS xDummy2;
+		#endif
+		xStaticListItem xDummy3[ 2 ];
+		unsigned portBASE_TYPE uxDummy5;
+		void *pxDummy6;
+		signed char ucDummy7[ configMAX_TASK_NAME_LEN ];
+		#if ( portSTACK_GROWTH > 0 )
+			void *pxDummy8;
+		#endif
+		#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+			unsigned portBASE_TYPE uxDummy9;
+		#endif
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			unsigned portBASE_TYPE uxDummy10[ 2 ];
+		#endif
+		#if ( configUSE_MUTEXES == 1 )
+			unsigned portBASE_TYPE uxDummy12;
+		#endif
+		#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+			void *pxDummy14;
+		#endif
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			unsigned long ulDummy16[ 3 ];
+		#endif
+		#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+			unsigned long ulDummy18;
+			unsigned char ucDummy19;
+		#endif
+		#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			unsigned char ucDummy17;
+		#endif
+	} xStaticTask;
+
+	/* Memory for a queue or semaphore, see xQueueCreateStatic(). */
+	typedef struct xSTATIC_QUEUE
+	{
+		void *pvDummy1[ 4 ];
+		xStaticList xDummy2[ 2 ];
+		unsigned portBASE_TYPE uxDummy3[ 3 ];
+		signed portBASE_TYPE xDummy4[ 2 ];
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			unsigned char ucDummy5[ 2 ];
+		#endif
+		#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			unsigned char ucDummy6;
+		#endif
+	} xStaticQueue;
+
+	/* Memory for a software timer, see xTimerCreateStatic(). */
+	typedef struct xSTATIC_TIMER
+	{
+		void *pvDummy1;
+		xStaticListItem xDummy2;
+		portTickType xDummy3;
+		unsigned portBASE_TYPE uxDummy4;
+		void *pvDummy5[ 2 ];
+		#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			unsigned char ucDummy6;
+		#endif
+	} xStaticTimer;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 #endif /* INC_FREERTOS_H */
 
@@ -370,6 +370,26 @@ void vPortFree( void *pv ) PRIVILEGED_FUNCTION;
 void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Heap statistics, only provided by heap_tlsf.c.  The free byte counts do not
+ * include block headers.
+ */
+typedef struct xHEAP_STATS
+{
+	size_t xAvailableHeapSpaceInBytes;		/*< Free bytes in the general heap. */
+	size_t xAvailablePoolSpaceInBytes;		/*< Free bytes in the fixed-size pools. */
+	size_t xSizeOfLargestFreeBlockInBytes;	/*< Largest free block in the general heap. */
+	size_t xNumberOfFreeBlocks;				/*< Free blocks in the general heap. */
+	size_t xMinimumEverFreeBytesRemaining;	/*< Lowest the total free bytes have been. */
+	size_t xNumberOfSuccessfulAllocations;
+	size_t xNumberOfSuccessfulFrees;
+	size_t xNumberOfPoolAllocations;		/*< Allocations served by a pool. */
+	size_t xNumberOfPoolMisses;				/*< Allocations that fitted a pool which had no free blocks. */
+} xHeapStats;
+
+size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
+void vPortGetHeapStats( xHeapStats *pxHeapStats ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
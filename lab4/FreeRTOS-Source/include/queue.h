@@ -97,6 +97,7 @@ typedef void * xQueueHandle;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( 4U )
+#define queueQUEUE_TYPE_BLOCK_POOL			( 5U )
 
 /**
  * queue. h
@@ -154,7 +155,59 @@ typedef void * xQueueHandle;
  * \defgroup xQueueCreate xQueueCreate
  * \ingroup QueueManagement
  */
-#define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+							  unsigned portBASE_TYPE uxQueueLength,
+							  unsigned portBASE_TYPE uxItemSize,
+							  unsigned char *pucQueueStorage,
+							  xStaticQueue *pxQueueBuffer
+						  );
+ * </pre>
+ *
+ * Creates a new queue instance in memory supplied by the application, without
+ * using the heap.  Both buffers must stay valid for as long as the queue is
+ * used.  Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @param pucQueueStorage Storage for the items: an array of at least
+ * uxQueueLength * uxItemSize bytes, aligned for the item type.  NULL if
+ * uxItemSize is 0.
+ *
+ * @param pxQueueBuffer Memory to hold the queue structure itself.
+ *
+ * @return A handle to the new queue.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH 10
+
+ static unsigned long ulQueueStorage[ QUEUE_LENGTH ];
+ static xStaticQueue xQueueBuffer;
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue1;
+
+	// Create a queue capable of containing 10 unsigned long values.
+	xQueue1 = xQueueCreateStatic( QUEUE_LENGTH, sizeof( unsigned long ), ( unsigned char * ) ulQueueStorage, &xQueueBuffer );
+
+	// ... Rest of task code.
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
 
 /**
  * queue. h
@@ -1240,6 +1293,10 @@ signed portBASE_TYPE xQueueCRReceive( xQueueHandle pxQueue, void *pvBuffer, port
  */
 xQueueHandle xQueueCreateMutex( unsigned char ucQueueType );
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount );
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue );
+	xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue );
+#endif
 void* xQueueGetMutexHolder( xQueueHandle xSemaphore );
 
 /*
@@ -1249,6 +1306,162 @@ void* xQueueGetMutexHolder( xQueueHandle xSemaphore );
 portBASE_TYPE xQueueTakeMutexRecursive( xQueueHandle pxMutex, portTickType xBlockTime );
 portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
 
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateBlockPool(
+							  unsigned portBASE_TYPE uxBlockCount,
+							  unsigned portBASE_TYPE uxBlockSize
+						  );
+ * </pre>
+ *
+ * Creates a pool of uxBlockCount fixed size blocks for passing large items
+ * between tasks without copying them.  A block is taken from the pool with
+ * pvQueueTakeBlock(), filled in, and its address sent on a pointer queue (see
+ * xQueueCreatePointerQueue()) with xQueueSendPointer().  The receiver owns the
+ * block from then on, and gives it back to the pool with xQueueGiveBlock()
+ * once it is done with it.  Only the pointer is copied, so the queue's
+ * critical sections take the same time whatever the size of the item.
+ *
+ * The pool is itself a queue of pointers to the free blocks, so taking a
+ * block can block until one is given back, and every operation has an ISR
+ * safe version.  The blocks and the free list are allocated together, and
+ * are both freed by vQueueDelete().  Only available when configUSE_BLOCK_POOLS
+ * is set to 1 in FreeRTOSConfig.h.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @param uxBlockSize The size of each block in bytes.  It is rounded up to a
+ * multiple of portBYTE_ALIGNMENT so every block is aligned.
+ *
+ * @return A handle to the new pool, or NULL if it could not be allocated.
+ *
+ * Example usage:
+   <pre>
+ struct AFrame
+ {
+	unsigned short usSamples[ 128 ];
+ };
+
+ xQueueHandle xFramePool, xFrameQueue;
+
+ void vSetup( void )
+ {
+	xFramePool = xQueueCreateBlockPool( 4, sizeof( struct AFrame ) );
+	xFrameQueue = xQueueCreatePointerQueue( 4 );
+ }
+
+ void vProducerTask( void *pvParameters )
+ {
+ struct AFrame *pxFrame;
+
+	for( ;; )
+	{
+		// Wait for a free block, fill it in and pass it on.
+		pxFrame = ( struct AFrame * ) pvQueueTakeBlock( xFramePool, portMAX_DELAY );
+		vSampleFrame( pxFrame );
+		xQueueSendPointer( xFrameQueue, pxFrame, portMAX_DELAY );
+	}
+ }
+
+ void vConsumerTask( void *pvParameters )
+ {
+ struct AFrame *pxFrame;
+
+	for( ;; )
+	{
+		pxFrame = ( struct AFrame * ) pvQueueReceivePointer( xFrameQueue, portMAX_DELAY );
+		vProcessFrame( pxFrame );
+
+		// The block belongs to this task until it is given back.
+		xQueueGiveBlock( xFramePool, pxFrame );
+	}
+ }
+ </pre>
+ * \defgroup xQueueCreateBlockPool xQueueCreateBlockPool
+ * \ingroup QueueManagement
+ */
+xQueueHandle xQueueCreateBlockPool( unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize );
+
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateBlockPoolStatic(
+							  unsigned portBASE_TYPE uxBlockCount,
+							  unsigned portBASE_TYPE uxBlockSize,
+							  unsigned char *pucBlockStorage,
+							  void **ppvFreeBlocks,
+							  xStaticQueue *pxPoolBuffer
+						  );
+ * </pre>
+ *
+ * Creates a block pool, as xQueueCreateBlockPool(), in memory supplied by the
+ * application.  Only available when configSUPPORT_STATIC_ALLOCATION is also
+ * set to 1.
+ *
+ * @param pucBlockStorage The blocks: uxBlockCount * uxBlockSize bytes.  Block
+ * n starts n * uxBlockSize bytes in.  Unlike xQueueCreateBlockPool(), the
+ * block size is not rounded up, so uxBlockSize has to be a multiple of
+ * portBYTE_ALIGNMENT.
+ *
+ * @param ppvFreeBlocks An array of uxBlockCount pointers for the free list.
+ *
+ * @param pxPoolBuffer Memory to hold the queue structure of the free list.
+ *
+ * Example usage:
+   <pre>
+ static struct AFrame xFrames[ 4 ];
+ static void *pvFreeFrames[ 4 ];
+ static xStaticQueue xFramePoolBuffer;
+
+	xFramePool = xQueueCreateBlockPoolStatic( 4, sizeof( struct AFrame ), ( unsigned char * ) xFrames, pvFreeFrames, &xFramePoolBuffer );
+ </pre>
+ * \defgroup xQueueCreateBlockPoolStatic xQueueCreateBlockPoolStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueCreateBlockPoolStatic( unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize, unsigned char *pucBlockStorage, void **ppvFreeBlocks, xStaticQueue *pxStaticQueue );
+#endif
+
+/*
+ * A pointer queue holds pointers (to blocks from a pool) rather than copies
+ * of the items.  It is an ordinary queue with an item size of sizeof( void * ),
+ * so it can also be used with the other queue functions.  The static version
+ * takes an array of uxQueueLength pointers for storage.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xQueueCreatePointerQueue( uxQueueLength ) xQueueGenericCreate( ( uxQueueLength ), sizeof( void * ), queueQUEUE_TYPE_BASE )
+#endif
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xQueueCreatePointerQueueStatic( uxQueueLength, ppvQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), sizeof( void * ), ( unsigned char * ) ( ppvQueueStorage ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
+#endif
+
+/*
+ * Post a pointer to the back of a pointer queue, or receive one from its
+ * front, as xQueueSend(), xQueueSendFromISR(), xQueueReceive() and
+ * xQueueReceiveFromISR() do for items.  The receive functions return the
+ * pointer, or NULL if the queue stayed empty for xTicksToWait ticks.
+ */
+signed portBASE_TYPE xQueueSendPointer( xQueueHandle pxQueue, void *pvPointer, portTickType xTicksToWait );
+signed portBASE_TYPE xQueueSendPointerFromISR( xQueueHandle pxQueue, void *pvPointer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+void *pvQueueReceivePointer( xQueueHandle pxQueue, portTickType xTicksToWait );
+void *pvQueueReceivePointerFromISR( xQueueHandle pxQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*
+ * Take a free block from a pool, waiting up to xTicksToWait ticks for one to
+ * be given back if the pool is empty (NULL is returned if none was).  A block
+ * must only be given back to the pool it came from, and only once; giving one
+ * back never blocks, as the pool always has room for all of its blocks.
+ */
+#define pvQueueTakeBlock( xPool, xTicksToWait ) pvQueueReceivePointer( ( xPool ), ( xTicksToWait ) )
+#define pvQueueTakeBlockFromISR( xPool, pxHigherPriorityTaskWoken ) pvQueueReceivePointerFromISR( ( xPool ), ( pxHigherPriorityTaskWoken ) )
+#define xQueueGiveBlock( xPool, pvBlock ) xQueueSendPointer( ( xPool ), ( pvBlock ), ( portTickType ) 0U )
+#define xQueueGiveBlockFromISR( xPool, pvBlock, pxHigherPriorityTaskWoken ) xQueueSendPointerFromISR( ( xPool ), ( pvBlock ), ( pxHigherPriorityTaskWoken ) )
+
+#endif /* configUSE_BLOCK_POOLS */
+
 /*
  * Reset a queue back to its original empty state.  pdPASS is returned if the
  * queue is successfully reset.  pdFAIL is returned if the queue could not be
@@ -1287,8 +1500,17 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType );
 
+/*
+ * Generic version of the static queue creation function, see
+ * xQueueCreateStatic().
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType );
+#endif
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( xQueueHandle pxQueue, portTickType xTicksToWait );
+unsigned portBASE_TYPE uxQueueReceiveBatchRestricted( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems );
 portBASE_TYPE xQueueGenericReset( xQueueHandle pxQueue, portBASE_TYPE xNewQueue );
 
 
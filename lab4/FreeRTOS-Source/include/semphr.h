@@ -127,6 +127,23 @@ typedef xQueueHandle xSemaphoreHandle;
 		}																																		\
 	}
 
+/**
+ * semphr. h
+ * <pre>vSemaphoreCreateBinaryStatic( xSemaphoreHandle xSemaphore, xStaticQueue *pxSemaphoreBuffer )</pre>
+ *
+ * Like vSemaphoreCreateBinary(), but the semaphore is created in
+ * pxSemaphoreBuffer rather than on the heap.  Only available when
+ * configSUPPORT_STATIC_ALLOCATION is set to 1 in FreeRTOSConfig.h.
+ *
+ * \defgroup vSemaphoreCreateBinaryStatic vSemaphoreCreateBinaryStatic
+ * \ingroup Semaphores
+ */
+#define vSemaphoreCreateBinaryStatic( xSemaphore, pxSemaphoreBuffer )																			\
+	{																																			\
+		( xSemaphore ) = xQueueGenericCreateStatic( ( unsigned portBASE_TYPE ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxSemaphoreBuffer ), queueQUEUE_TYPE_BINARY_SEMAPHORE );	\
+		xSemaphoreGive( ( xSemaphore ) );																										\
+	}
+
 /**
  * semphr. h
  * <pre>xSemaphoreTake( 
@@ -635,6 +652,18 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateMutex() xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateMutexStatic( xStaticQueue *pxMutexBuffer )</pre>
+ *
+ * Like xSemaphoreCreateMutex(), but the mutex is created in pxMutexBuffer
+ * rather than on the heap.
+ *
+ * \defgroup xSemaphoreCreateMutexStatic xSemaphoreCreateMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
+
 
 /**
  * semphr. h
@@ -690,6 +719,18 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateRecursiveMutex() xQueueCreateMutex( queueQUEUE_TYPE_RECURSIVE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateRecursiveMutexStatic( xStaticQueue *pxMutexBuffer )</pre>
+ *
+ * Like xSemaphoreCreateRecursiveMutex(), but the mutex is created in
+ * pxMutexBuffer rather than on the heap.
+ *
+ * \defgroup xSemaphoreCreateRecursiveMutexStatic xSemaphoreCreateRecursiveMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateRecursiveMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( pxMutexBuffer ) )
+
 /**
  * semphr. h
  * <pre>xSemaphoreHandle xSemaphoreCreateCounting( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount )</pre>
@@ -753,6 +794,18 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateCounting( uxMaxCount, uxInitialCount ) xQueueCreateCountingSemaphore( ( uxMaxCount ), ( uxInitialCount ) )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateCountingStatic( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxSemaphoreBuffer )</pre>
+ *
+ * Like xSemaphoreCreateCounting(), but the semaphore is created in
+ * pxSemaphoreBuffer rather than on the heap.
+ *
+ * \defgroup xSemaphoreCreateCountingStatic xSemaphoreCreateCountingStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer ) xQueueCreateCountingSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
+
 /**
  * semphr. h
  * <pre>void vSemaphoreDelete( xSemaphoreHandle xSemaphore );</pre>
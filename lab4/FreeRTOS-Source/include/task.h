@@ -141,6 +141,33 @@ typedef enum
 	eDeleted		/* The task being queried has been deleted, but its TCB has not yet been freed. */
 } eTaskState;
 
+/* Actions that can be performed when xTaskNotify() is called. */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notification value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
+/* Possible return values for eTaskConfirmSleepModeStatus(). */
+typedef enum
+{
+	eAbortSleep = 0,		/* A task has been made ready or a context switch pended since the idle task decided to sleep, so abort entering a sleep mode. */
+	eStandardSleep			/* Enter a sleep mode that will not last any longer than the expected idle time. */
+} eSleepModeStatus;
+
+/* Run time statistics of one task, as returned by vTaskGetTaskRunTimeStats()
+and uxTaskGetRunTimeSnapshot().  Times are in run time counter units. */
+typedef struct xTASK_RUN_TIME_STATS
+{
+	xTaskHandle xHandle;			/* The task the statistics are for. */
+	unsigned long ulRunTime;		/* Total time the task has been running for. */
+	unsigned long ulSwitchInCount;	/* Number of times the task has been switched in after another task ran. */
+	unsigned long ulLongestRun;		/* Longest time the task has run for before another task was switched in. */
+} xTaskRunTimeStats;
+
 /*
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -291,7 +318,62 @@ typedef enum
  * \defgroup xTaskCreate xTaskCreate
  * \ingroup Tasks
  */
-#define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
+#endif
+
+/**
+ * task. h
+ *<pre>
+ portBASE_TYPE xTaskCreateStatic(
+							  pdTASK_CODE pvTaskCode,
+							  const char * const pcName,
+							  unsigned short usStackDepth,
+							  void *pvParameters,
+							  unsigned portBASE_TYPE uxPriority,
+							  xTaskHandle *pvCreatedTask,
+							  portSTACK_TYPE *puxStackBuffer,
+							  xStaticTask *pxTaskBuffer
+						  );</pre>
+ *
+ * Create a new task and add it to the list of tasks that are ready to run,
+ * without using the heap.  The stack and the task control block are supplied
+ * by the application, normally as file scope variables, and must stay valid
+ * for the lifetime of the task.  Only available when
+ * configSUPPORT_STATIC_ALLOCATION is set to 1 in FreeRTOSConfig.h.
+ *
+ * The parameters are the same as for xTaskCreate(), plus:
+ *
+ * @param puxStackBuffer An array of at least usStackDepth portSTACK_TYPE
+ * variables to use as the task stack.
+ *
+ * @param pxTaskBuffer Memory to hold the task control block.  xStaticTask is
+ * the same size as the task control block, but its members are not meant to
+ * be used by the application.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, otherwise an error code defined in the file errors. h
+ *
+ * Example usage:
+   <pre>
+ #define STACK_SIZE 200
+
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+ static xStaticTask xTaskBuffer;
+
+ void vOtherFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle, xStack, &xTaskBuffer );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	signed portBASE_TYPE xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * task. h
@@ -360,7 +442,9 @@ xTaskHandle xHandle;
  * \defgroup xTaskCreateRestricted xTaskCreateRestricted
  * \ingroup Tasks
  */
-#define xTaskCreateRestricted( x, pxCreatedTask ) xTaskGenericCreate( ((x)->pvTaskCode), ((x)->pcName), ((x)->usStackDepth), ((x)->pvParameters), ((x)->uxPriority), (pxCreatedTask), ((x)->puxStackBuffer), ((x)->xRegions) )
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xTaskCreateRestricted( x, pxCreatedTask ) xTaskGenericCreate( ((x)->pvTaskCode), ((x)->pcName), ((x)->usStackDepth), ((x)->pvParameters), ((x)->uxPriority), (pxCreatedTask), ((x)->puxStackBuffer), ((x)->xRegions) )
+#endif
 
 /**
  * task. h
@@ -791,6 +875,158 @@ void vTaskResume( xTaskHandle pxTaskToResume ) PRIVILEGED_FUNCTION;
  */
 portBASE_TYPE xTaskResumeFromISR( xTaskHandle pxTaskToResume ) PRIVILEGED_FUNCTION;
 
+/*-----------------------------------------------------------
+ * TASK NOTIFICATIONS
+ *----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );</pre>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be defined as 1 for this function to be
+ * available.
+ *
+ * Each task has a 32-bit notification value, initialised to zero when the
+ * task is created.  A notification is an event sent directly to a task, with
+ * no intermediate queue or semaphore object, that can unblock the task and
+ * optionally update its notification value.  A task waits for a notification
+ * with xTaskNotifyWait() or ulTaskNotifyTake().
+ *
+ * Used this way a notification replaces a binary or counting semaphore, an
+ * event group or a single item mailbox, without the RAM of a queue control
+ * block and without any event list to walk, so it is faster as well as
+ * smaller.  The limitation is that only one task, the one being notified,
+ * can wait on it.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Data that can be sent with the notification.  How it is
+ * used depends on eAction.
+ *
+ * @param eAction How the notification value is updated:
+ * eNoAction leaves it unchanged, eSetBits ORs ulValue into it, eIncrement
+ * increments it (ulValue is not used), eSetValueWithOverwrite sets it to
+ * ulValue, and eSetValueWithoutOverwrite sets it to ulValue only if the
+ * task has no notification pending.
+ *
+ * @return pdFAIL if eAction was eSetValueWithoutOverwrite and the value could
+ * not be written, otherwise pdPASS.
+ *
+ * \defgroup xTaskNotify xTaskNotify
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyAndQuery( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotifyValue );</pre>
+ *
+ * As xTaskNotify(), but *pulPreviousNotifyValue is set to the task's
+ * notification value before it was updated.
+ *
+ * \defgroup xTaskNotifyAndQuery xTaskNotifyAndQuery
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xTaskNotify() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the notification
+ * unblocked a task with a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.  Can be NULL.
+ *
+ * \defgroup xTaskNotifyFromISR xTaskNotifyFromISR
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );</pre>
+ *
+ * Wait, optionally in the Blocked state, for the calling task to receive a
+ * notification.  If a notification is already pending the function returns
+ * immediately.
+ *
+ * @param ulBitsToClearOnEntry Bits cleared in the notification value on entry,
+ * if no notification was pending.  0xffffffff resets the value to 0.
+ *
+ * @param ulBitsToClearOnExit Bits cleared in the notification value before
+ * the function exits, if a notification was received.
+ *
+ * @param pulNotificationValue Where to pass out the notification value, before
+ * ulBitsToClearOnExit is applied.  Can be NULL.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ * portMAX_DELAY waits without a timeout if INCLUDE_vTaskSuspend is 1.
+ *
+ * @return pdTRUE if a notification was received (or was already pending),
+ * pdFALSE if the call timed out.
+ *
+ * \defgroup xTaskNotifyWait xTaskNotifyWait
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify );</pre>
+ *
+ * Increment the task's notification value, for when the notification is used
+ * as a light weight counting or binary semaphore.  The task takes it with
+ * ulTaskNotifyTake().
+ *
+ * \defgroup xTaskNotifyGive xTaskNotifyGive
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0UL ), eIncrement, NULL )
+
+/**
+ * task. h
+ * <pre>void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xTaskNotifyGive() that can be called from an interrupt service
+ * routine.  See xTaskNotifyFromISR() for pxHigherPriorityTaskWoken.
+ *
+ * \defgroup vTaskNotifyGiveFromISR vTaskNotifyGiveFromISR
+ * \ingroup TaskNotifications
+ */
+void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</pre>
+ *
+ * Wait, optionally in the Blocked state, for the calling task's notification
+ * value to be non-zero, treating it as the count of a semaphore.
+ *
+ * @param xClearCountOnExit If pdFALSE the value is decremented before the
+ * function exits, like taking a counting semaphore.  Otherwise it is cleared
+ * to zero, like taking a binary semaphore.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ * portMAX_DELAY waits without a timeout if INCLUDE_vTaskSuspend is 1.
+ *
+ * @return The notification value before it was decremented or cleared, so
+ * zero if the call timed out.
+ *
+ * \defgroup ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
 /*-----------------------------------------------------------
  * SCHEDULER CONTROL
  *----------------------------------------------------------*/
@@ -1113,6 +1349,60 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  */
 void vTaskGetRunTimeStats( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>void vTaskGetTaskRunTimeStats( xTaskHandle xTask, xTaskRunTimeStats *pxStats );</PRE>
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Reads the run time statistics of a single task without formatting them,
+ * so it is cheap enough to be used while the application is running (for
+ * example by a scheduler that charges tasks for the time they actually ran).
+ * Interrupts are only disabled while the counters are copied.
+ *
+ * If xTask is the running task, the time it has been running for since it
+ * was last switched in is included in the returned values.
+ *
+ * @param xTask The handle of the task to read the statistics of.  Passing
+ * NULL reads the statistics of the calling task.
+ *
+ * @param pxStats The structure the statistics are written to.
+ *
+ * \page vTaskGetTaskRunTimeStats vTaskGetTaskRunTimeStats
+ * \ingroup TaskUtils
+ */
+void vTaskGetTaskRunTimeStats( xTaskHandle xTask, xTaskRunTimeStats *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned portBASE_TYPE uxTaskGetRunTimeSnapshot( xTaskRunTimeStats *pxStatsArray, unsigned portBASE_TYPE uxArraySize, unsigned long *pulTotalRunTime );</PRE>
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Binary version of vTaskGetRunTimeStats().  Fills an array with one
+ * xTaskRunTimeStats structure per task, so the statistics of every task can
+ * be sent off the target (or compared between two snapshots) without the
+ * cost of sprintf().  The scheduler is suspended, rather than interrupts
+ * disabled, while the task lists are walked.
+ *
+ * @param pxStatsArray The array the statistics are written to.
+ *
+ * @param uxArraySize The number of structures pxStatsArray can hold.  Tasks
+ * that do not fit are left out.  uxTaskGetNumberOfTasks() gives the size
+ * needed.
+ *
+ * @param pulTotalRunTime If not NULL, set to the run time counter value the
+ * snapshot was taken at.
+ *
+ * @return The number of structures written to pxStatsArray.
+ *
+ * \page uxTaskGetRunTimeSnapshot uxTaskGetRunTimeSnapshot
+ * \ingroup TaskUtils
+ */
+unsigned portBASE_TYPE uxTaskGetRunTimeSnapshot( xTaskRunTimeStats *pxStatsArray, unsigned portBASE_TYPE uxArraySize, unsigned long *pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
 /**
  * task.h
  * <PRE>unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask );</PRE>
@@ -1307,7 +1597,19 @@ void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUN
  * Generic version of the task creation function which is in turn called by the
  * xTaskCreate() and xTaskCreateRestricted() macros.
  */
-signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Called by the kernel, when configSUPPORT_STATIC_ALLOCATION is 1, to get the
+ * memory for the idle task.  The application must provide it, and set
+ * *pusIdleTaskStackSize to the number of portSTACK_TYPE variables in the
+ * stack (normally configMINIMAL_STACK_SIZE).
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	void vApplicationGetIdleTaskMemory( xStaticTask **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer, unsigned short *pusIdleTaskStackSize );
+#endif
 
 /*
  * Get the uxTCBNumber assigned to the task referenced by the xTask parameter.
@@ -1320,6 +1622,26 @@ unsigned portBASE_TYPE uxTaskGetTaskNumber( xTaskHandle xTask );
  */
 void vTaskSetTaskNumber( xTaskHandle xTask, unsigned portBASE_TYPE uxHandle );
 
+/*
+ * Only available when configUSE_TICKLESS_IDLE is set to 1.
+ * If tickless mode is being used, or a low power mode is implemented, then
+ * the tick interrupt will not execute during idle periods.  When this is the
+ * case, the tick count value maintained by the scheduler needs to be kept up
+ * to date with the actual execution time by being skipped forward by the
+ * length of time the tick interrupt was suppressed.  Called by the port, with
+ * the scheduler suspended, from portSUPPRESS_TICKS_AND_SLEEP().
+ */
+void vTaskStepTick( portTickType xTicksToJump ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configUSE_TICKLESS_IDLE is set to 1.
+ * Called by the port, with interrupts disabled, just before it enters a sleep
+ * mode, to check that nothing has happened since the idle task decided to
+ * sleep that needs a task to run.  Returns eAbortSleep if the sleep should be
+ * abandoned.
+ */
+eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
+
 
 #ifdef __cplusplus
 }
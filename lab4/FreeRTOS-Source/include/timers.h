@@ -230,7 +230,33 @@ typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
  *     for( ;; );
  * }
  */
-xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * xTimerHandle xTimerCreateStatic( const signed char *pcTimerName,
+ * 									portTickType xTimerPeriodInTicks,
+ * 									unsigned portBASE_TYPE uxAutoReload,
+ * 									void * pvTimerID,
+ * 									tmrTIMER_CALLBACK pxCallbackFunction,
+ * 									xStaticTimer *pxTimerBuffer );
+ *
+ * Creates a new software timer instance in memory supplied by the application,
+ * without using the heap.  The parameters and the return value are the same
+ * as for xTimerCreate(), plus:
+ *
+ * @param pxTimerBuffer Memory to hold the timer, which must stay valid until
+ * the timer has been deleted.
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.  The timer service task and the timer command queue are
+ * then also allocated statically: the application must provide
+ * vApplicationGetTimerTaskMemory() (see below).
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xTimerHandle xTimerCreateStatic( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * void *pvTimerGetTimerID( xTimerHandle xTimer );
@@ -941,6 +967,16 @@ xTaskHandle xTimerGetTimerDaemonTaskHandle( void );
  * for use by the kernel only.
  */
 portBASE_TYPE xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the kernel, when configSUPPORT_STATIC_ALLOCATION is 1, to get the
+ * memory for the timer service task.  The application must provide it, and
+ * set *pusTimerTaskStackSize to the number of portSTACK_TYPE variables in the
+ * stack (normally configTIMER_TASK_STACK_DEPTH).
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	void vApplicationGetTimerTaskMemory( xStaticTask **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer, unsigned short *pusTimerTaskStackSize );
+#endif
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
 
 #ifdef __cplusplus
@@ -0,0 +1,667 @@
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for running the kernel
+ * as a process on a POSIX (Linux) host.
+ *
+ * Everything runs on one host thread, as it would on one core.  Each task
+ * gets a ucontext with a stack from malloc(), and the tick interrupt is a
+ * SIGALRM from an interval timer whose period is independent of
+ * configTICK_RATE_HZ, so a 1 ms tick can be simulated in 100 microseconds.
+ * The tick is still wall clock time on the host: a task set that keeps the
+ * processor busy runs about 10 times faster than real time (an hour of
+ * simulated time in about six minutes), and how much work a task gets done
+ * in a tick depends on the load on the host, so two runs are not tick for
+ * tick the same.  Only time that the target would spend asleep is skipped.
+ *
+ * Interrupts are modelled on the Cortex-M3 port: the tick handler pends a
+ * context switch (PendSV), and masking interrupts sets a flag rather than
+ * BASEPRI.  A tick or yield that comes while interrupts are masked is held
+ * pending and taken when they are enabled again.  Context switches are only
+ * ever made with interrupts unmasked and the critical nesting at zero, so the
+ * nesting count does not need to be saved per task.
+ *
+ * Application code written for the Cortex-M3 reads and writes the ITM, DWT
+ * and SCB registers directly.  So that it runs unmodified, the 64K block of
+ * the system address space they are in (0xE0000000 to 0xE000FFFF) is mapped
+ * as ordinary memory before main() is called.  The ITM stimulus ports always
+ * read as ready, and the DWT cycle counter advances by a tick's worth of
+ * cycles (configCPU_CLOCK_HZ / configTICK_RATE_HZ) on every tick once it has
+ * been enabled.
+ *
+ * With configGENERATE_RUN_TIME_STATS, the run time counter is the same
+ * cycles-per-tick time base, but the cycles within the current tick are
+ * interpolated from the host clock, so a task that runs for part of a tick is
+ * charged for that part rather than for a whole tick or nothing.  The count
+ * is kept in an unsigned long, so it does not wrap at 32 bits on a 64 bit
+ * host.
+ *
+ * With configUSE_TICKLESS_IDLE, the idle task's sleeps are modelled on the
+ * Cortex-M3 port: the tick periods in a sleep still pass (the DWT counter
+ * advances and the host tick hook runs, as a peripheral interrupt would), but
+ * the kernel only sees the tick that ends the sleep and steps its tick count
+ * over the others.  The host does not wait for them, so a sleep takes no wall
+ * clock time however long it is.  How many tick interrupts were suppressed is
+ * printed with the run time.
+ *
+ * The C library is not reentrant across tasks that are preempted in the
+ * middle of a call (they share one host thread), so printf() and friends
+ * should be called with the scheduler suspended or from a single task.
+ *
+ * Environment variables:
+ *   FREERTOS_TICK_US    Host microseconds per tick (default 100).  Each tick
+ *                       costs a signal and usually a context switch, and
+ *                       that time is charged to whichever task it lands in,
+ *                       so below about 50 microseconds the tasks get too
+ *                       little work done between ticks and miss deadlines
+ *                       they meet on the target.
+ *   FREERTOS_RUN_TICKS  Exit after this many ticks, printing the simulated
+ *                       and wall clock time to stderr (default: run forever).
+ *
+ * Build the lab4 demo (from lab4):
+ *   gcc -O2 -I. -IFreeRTOS-Source/include -IFreeRTOS-Source/portable/GCC/Posix
+ *       FreeRTOS-Source/tasks.c FreeRTOS-Source/queue.c FreeRTOS-Source/list.c
+ *       FreeRTOS-Source/timers.c FreeRTOS-Source/portable/GCC/Posix/port.c
+ *       FreeRTOS-Source/portable/MemMang/heap_3.c edf_*.c main.c
+ *       host/edf_host_report.c -o lab4_host
+ *----------------------------------------------------------*/
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Size of the host stack given to each task.  The stack depth passed to
+xTaskCreate() is sized for the target and is far too small for the host C
+library. */
+#ifndef portHOST_STACK_SIZE
+	#define portHOST_STACK_SIZE			( 64 * 1024 )
+#endif
+
+/* Host microseconds per tick when FREERTOS_TICK_US is not set. */
+#define portDEFAULT_TICK_US				100
+
+/* Emulated system address space (ITM, DWT and SCB). */
+#define portSYSTEM_BASE					( ( void * ) 0xE0000000UL )
+#define portSYSTEM_SIZE					0x10000UL
+#define portITM_PORT( n )				( ( volatile unsigned int * ) ( 0xE0000000UL + 4 * ( n ) ) )
+#define portITM_PORTS					32
+#define portDWT_CTRL					( *( ( volatile unsigned int * ) 0xE0001000UL ) )
+#define portDWT_CYCCNT					( *( ( volatile unsigned int * ) 0xE0001004UL ) )
+#define portDWT_CYCCNTENA				0x00000001
+#define portCYCLES_PER_TICK				( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+
+/* The longest sleep the target's 24 bit SysTick allows, in ticks. */
+#define portMAX_SUPPRESSED_TICKS		( 0xffffffUL / portCYCLES_PER_TICK )
+
+#ifndef MAP_FIXED_NOREPLACE
+	#define MAP_FIXED_NOREPLACE			0x100000
+#endif
+
+/* What the first word of each task's stack points to. */
+typedef struct xHOST_TASK
+{
+	ucontext_t xContext;
+	pdTASK_CODE pxCode;
+	void *pvParameters;
+} xHostTask;
+
+/* The first member of the TCB is the top of stack pointer. */
+extern void * volatile pxCurrentTCB;
+#define portCURRENT_TASK()				( ( xHostTask * ) **( ( portSTACK_TYPE ** ) pxCurrentTCB ) )
+
+/* Interrupt state.  Interrupts are masked until the first task starts. */
+static volatile sig_atomic_t xInterruptsMasked = pdTRUE;
+static volatile sig_atomic_t xTickPending = pdFALSE;
+static volatile sig_atomic_t xYieldPending = pdFALSE;
+static volatile unsigned portBASE_TYPE uxCriticalNesting = 0xaaaaaaaa;
+
+/* Stops the compiler moving memory accesses across a change to the interrupt
+mask.  The nesting count is volatile as well, so it is never updated before
+interrupts are masked: a tick in between would switch tasks with the count
+not at zero. */
+#define portMEMORY_BARRIER()			__asm volatile( "" ::: "memory" )
+
+/* Where vPortEndScheduler() returns to. */
+static ucontext_t xSchedulerContext;
+
+/* Run length limit and timing. */
+static unsigned long ulTicksToRun = 0;
+static unsigned long ulTicksRun = 0;
+static struct timespec xStartTime;
+
+/* Run time counter: cycles in the tick periods so far, the host time the
+last one ended, and the host length of a tick. */
+#if configGENERATE_RUN_TIME_STATS == 1
+	static unsigned long ulRunTimeCycles = 0;
+	static struct timespec xLastTickTime;
+	static unsigned long long ullTickNanoseconds;
+#endif
+
+/* Tickless idle statistics: ticks the kernel was not interrupted for, and the
+number of sleeps they were suppressed in. */
+#if configUSE_TICKLESS_IDLE == 1
+	static unsigned long ulTicksSuppressed = 0;
+	static unsigned long ulSleeps = 0;
+#endif
+
+/*
+ * Called on every tick with interrupts masked, if the application defines it.
+ * Lets host builds drain buffers without adding a task.
+ */
+void vApplicationHostTickHook( void ) __attribute__( ( weak ) );
+
+/*
+ * Map the emulated system address space.  Runs before main().
+ */
+static void prvMapSystemSpace( void ) __attribute__( ( constructor ) );
+
+/*
+ * Emulated exception handlers, called with interrupts masked.
+ */
+static void prvTickHandler( void );
+static void prvSwitchContext( void );
+
+/*
+ * Everything a tick period does apart from the kernel tick: advance the DWT
+ * cycle counter, call the host tick hook and count the tick against the run
+ * length.  Runs for suppressed ticks as well, as peripheral interrupts and
+ * time go on while the target sleeps.
+ */
+static void prvTickPeriodElapsed( void );
+
+/*
+ * Take pending ticks and yields.  Called with interrupts masked.
+ */
+static void prvServicePending( void );
+
+/*
+ * The tick signal handler.
+ */
+static void prvTickSignal( int iSignal );
+
+/*
+ * Entry point of every task's context.
+ */
+static void prvTaskStart( void );
+
+/*
+ * Print how long the run took and exit.
+ */
+static void prvFinishRun( void );
+
+/*
+ * Host microseconds per tick, from FREERTOS_TICK_US.
+ */
+static unsigned long prvTickMicroseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static void prvMapSystemSpace( void )
+{
+void *pvSystem;
+unsigned long ulPort;
+
+	pvSystem = mmap( portSYSTEM_BASE, portSYSTEM_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0 );
+
+	if( pvSystem != portSYSTEM_BASE )
+	{
+		fprintf( stderr, "port: could not map the system address space at %p\n", portSYSTEM_BASE );
+		exit( 1 );
+	}
+
+	/* The stimulus ports are always ready to take another write. */
+	for( ulPort = 0; ulPort < portITM_PORTS; ulPort++ )
+	{
+		*portITM_PORT( ulPort ) = 1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.  The stack given by the kernel is only used
+ * to hold a pointer to the task's host context.
+ */
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+xHostTask *pxTask;
+void *pvStack;
+
+	/* Tasks can be created by other tasks, which may be preempted inside
+	malloc(). */
+	vTaskSuspendAll();
+	{
+		pxTask = ( xHostTask * ) malloc( sizeof( xHostTask ) );
+		pvStack = malloc( portHOST_STACK_SIZE );
+	}
+	xTaskResumeAll();
+
+	if( ( pxTask == NULL ) || ( pvStack == NULL ) )
+	{
+		fprintf( stderr, "port: out of memory for a task context\n" );
+		abort();
+	}
+
+	getcontext( &( pxTask->xContext ) );
+	pxTask->xContext.uc_stack.ss_sp = pvStack;
+	pxTask->xContext.uc_stack.ss_size = portHOST_STACK_SIZE;
+	pxTask->xContext.uc_link = NULL;
+	sigemptyset( &( pxTask->xContext.uc_sigmask ) );
+	makecontext( &( pxTask->xContext ), prvTaskStart, 0 );
+
+	pxTask->pxCode = pxCode;
+	pxTask->pvParameters = pvParameters;
+
+	*pxTopOfStack = ( portSTACK_TYPE ) pxTask;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskStart( void )
+{
+xHostTask *pxTask = portCURRENT_TASK();
+
+	/* Tasks are switched to with interrupts masked. */
+	vPortClearInterruptMask();
+
+	pxTask->pxCode( pxTask->pvParameters );
+
+	fprintf( stderr, "port: a task returned from its implementing function\n" );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portBASE_TYPE xPortStartScheduler( void )
+{
+struct sigaction xAction;
+struct itimerval xTimer;
+unsigned long ulTickMicroseconds = prvTickMicroseconds();
+const char *pcSetting;
+
+	if( ( pcSetting = getenv( "FREERTOS_RUN_TICKS" ) ) != NULL )
+	{
+		ulTicksToRun = strtoul( pcSetting, NULL, 0 );
+	}
+
+	/* The first task is started with interrupts masked, and unmasks them
+	itself. */
+	uxCriticalNesting = 0;
+	xInterruptsMasked = pdTRUE;
+
+	xAction.sa_handler = prvTickSignal;
+	xAction.sa_flags = SA_RESTART;
+	sigemptyset( &( xAction.sa_mask ) );
+	sigaction( SIGALRM, &xAction, NULL );
+
+	xTimer.it_interval.tv_sec = ulTickMicroseconds / 1000000UL;
+	xTimer.it_interval.tv_usec = ulTickMicroseconds % 1000000UL;
+	xTimer.it_value = xTimer.it_interval;
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	clock_gettime( CLOCK_MONOTONIC, &xStartTime );
+
+	/* Start the first task.  Only returns if vPortEndScheduler() is called. */
+	swapcontext( &xSchedulerContext, &( portCURRENT_TASK()->xContext ) );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer = { { 0, 0 }, { 0, 0 } };
+
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+	xInterruptsMasked = pdTRUE;
+	setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	/* Set a PendSV to request a context switch.  It is taken straight away
+	unless interrupts are masked. */
+	xYieldPending = pdTRUE;
+
+	if( xInterruptsMasked == pdFALSE )
+	{
+		vPortClearInterruptMask();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	vPortSetInterruptMask();
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	uxCriticalNesting--;
+	if( uxCriticalNesting == 0 )
+	{
+		vPortClearInterruptMask();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptMask( void )
+{
+	xInterruptsMasked = pdTRUE;
+	portMEMORY_BARRIER();
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( void )
+{
+	portMEMORY_BARRIER();
+
+	for( ;; )
+	{
+		/* Unmask before checking, so a tick that arrives after the check is
+		handled by the signal handler itself rather than left pending. */
+		xInterruptsMasked = pdFALSE;
+
+		if( ( xTickPending == pdFALSE ) && ( xYieldPending == pdFALSE ) )
+		{
+			break;
+		}
+
+		xInterruptsMasked = pdTRUE;
+		prvServicePending();
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPortSetInterruptMaskFromISR( void )
+{
+unsigned portBASE_TYPE uxSavedMask = ( unsigned portBASE_TYPE ) xInterruptsMasked;
+
+	xInterruptsMasked = pdTRUE;
+	portMEMORY_BARRIER();
+	return uxSavedMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE uxSavedMask )
+{
+	if( uxSavedMask == pdFALSE )
+	{
+		vPortClearInterruptMask();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvServicePending( void )
+{
+	while( ( xTickPending != pdFALSE ) || ( xYieldPending != pdFALSE ) )
+	{
+		if( xTickPending != pdFALSE )
+		{
+			xTickPending = pdFALSE;
+			prvTickHandler();
+		}
+
+		if( xYieldPending != pdFALSE )
+		{
+			xYieldPending = pdFALSE;
+			prvSwitchContext();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickSignal( int iSignal )
+{
+	( void ) iSignal;
+
+	if( xInterruptsMasked != pdFALSE )
+	{
+		xTickPending = pdTRUE;
+		return;
+	}
+
+	/* The interrupted task may be switched out from here, and carries on
+	from this point (and returns from the handler) when it is switched back
+	in. */
+	xInterruptsMasked = pdTRUE;
+	prvTickHandler();
+	prvServicePending();
+	vPortClearInterruptMask();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickHandler( void )
+{
+	#if configUSE_PREEMPTION == 1
+		/* If using preemption, also force a context switch. */
+		xYieldPending = pdTRUE;
+	#endif
+
+	vTaskIncrementTick();
+	prvTickPeriodElapsed();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickPeriodElapsed( void )
+{
+	if( portDWT_CTRL & portDWT_CYCCNTENA )
+	{
+		portDWT_CYCCNT += portCYCLES_PER_TICK;
+	}
+
+	#if configGENERATE_RUN_TIME_STATS == 1
+	{
+		ulRunTimeCycles += portCYCLES_PER_TICK;
+		clock_gettime( CLOCK_MONOTONIC, &xLastTickTime );
+	}
+	#endif
+
+	if( vApplicationHostTickHook != NULL )
+	{
+		vApplicationHostTickHook();
+	}
+
+	if( ( ulTicksToRun != 0 ) && ( ++ulTicksRun >= ulTicksToRun ) )
+	{
+		prvFinishRun();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if configUSE_TICKLESS_IDLE == 1
+
+	/*
+	 * See header file for description.  Called by the idle task with the
+	 * scheduler suspended.  Models the CM3 port: the SysTick is reprogrammed
+	 * to interrupt once, xExpectedIdleTime ticks later, and the sleep ends
+	 * early if an interrupt (here the host tick hook) makes a task ready.
+	 * Nothing runs while the target sleeps, so the host does not wait for the
+	 * tick periods in the sleep: they all elapse at once, and the tick timer
+	 * starts a whole period again when the sleep ends.
+	 */
+	void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime )
+	{
+	struct itimerval xTimer;
+	portTickType xTicksSuppressed = 0;
+	portBASE_TYPE xWoken = pdFALSE;
+
+		if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+		{
+			xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+		}
+
+		/* Mask interrupts, so a tick signal is only recorded as pending from
+		here on.  A tick that is already pending ends the sleep before it
+		starts, as a pending interrupt does on the target. */
+		vPortSetInterruptMask();
+
+		if( ( xTickPending != pdFALSE ) || ( eTaskConfirmSleepModeStatus() == eAbortSleep ) )
+		{
+			vPortClearInterruptMask();
+			return;
+		}
+
+		while( ( xTicksSuppressed + 1 ) < xExpectedIdleTime )
+		{
+			/* A tick period passed without a tick interrupt. */
+			xTicksSuppressed++;
+			prvTickPeriodElapsed();
+
+			if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+			{
+				/* The host tick hook made a task ready, as another interrupt
+				would on the target. */
+				xWoken = pdTRUE;
+				break;
+			}
+		}
+
+		/* The next tick period starts now. */
+		getitimer( ITIMER_REAL, &xTimer );
+		xTimer.it_value = xTimer.it_interval;
+		setitimer( ITIMER_REAL, &xTimer, NULL );
+
+		if( xWoken == pdFALSE )
+		{
+			/* This is the tick the SysTick was reprogrammed for.  Leave it
+			pending for the tick handler. */
+			xTickPending = pdTRUE;
+		}
+
+		vTaskStepTick( xTicksSuppressed );
+		ulTicksSuppressed += xTicksSuppressed;
+		ulSleeps++;
+
+		/* Take the pending tick, if the sleep ran its full length. */
+		vPortClearInterruptMask();
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+xHostTask *pxPrevious = portCURRENT_TASK();
+xHostTask *pxNext;
+
+	vTaskSwitchContext();
+	pxNext = portCURRENT_TASK();
+
+	if( pxNext != pxPrevious )
+	{
+		swapcontext( &( pxPrevious->xContext ), &( pxNext->xContext ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTickMicroseconds( void )
+{
+unsigned long ulTickMicroseconds = portDEFAULT_TICK_US;
+const char *pcSetting;
+
+	if( ( pcSetting = getenv( "FREERTOS_TICK_US" ) ) != NULL )
+	{
+		ulTickMicroseconds = strtoul( pcSetting, NULL, 0 );
+
+		if( ulTickMicroseconds == 0 )
+		{
+			ulTickMicroseconds = 1;
+		}
+	}
+
+	return ulTickMicroseconds;
+}
+/*-----------------------------------------------------------*/
+
+#if configGENERATE_RUN_TIME_STATS == 1
+
+	/*
+	 * See header file for description.  The kernel calls this before it
+	 * takes its first sample, which is before xPortStartScheduler(), so the
+	 * time base has to be set up here: the first tick period is counted from
+	 * now, and the interpolation within it stays below a whole tick until the
+	 * first tick arrives.
+	 */
+	void vPortConfigureRunTimeCounter( void )
+	{
+		portDWT_CTRL |= portDWT_CYCCNTENA;
+		ullTickNanoseconds = prvTickMicroseconds() * 1000ULL;
+		clock_gettime( CLOCK_MONOTONIC, &xLastTickTime );
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned long ulPortGetRunTimeCounterValue( void )
+	{
+	struct timespec xNow;
+	long long llElapsed;
+	unsigned long ulCycles;
+
+		clock_gettime( CLOCK_MONOTONIC, &xNow );
+		llElapsed = ( long long ) ( xNow.tv_sec - xLastTickTime.tv_sec ) * 1000000000LL + ( xNow.tv_nsec - xLastTickTime.tv_nsec );
+
+		/* The tick signal can be late, or held pending while interrupts are
+		masked, so the interpolation is capped to keep the count behind the
+		start of the next tick period. */
+		if( llElapsed <= 0 )
+		{
+			ulCycles = 0;
+		}
+		else if( ( unsigned long long ) llElapsed >= ullTickNanoseconds )
+		{
+			ulCycles = portCYCLES_PER_TICK - 1;
+		}
+		else
+		{
+			ulCycles = ( unsigned long ) ( ( unsigned long long ) llElapsed * portCYCLES_PER_TICK / ullTickNanoseconds );
+		}
+
+		return ulRunTimeCycles + ulCycles;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvFinishRun( void )
+{
+struct itimerval xTimer = { { 0, 0 }, { 0, 0 } };
+struct timespec xEndTime;
+double dWallSeconds, dSimulatedSeconds;
+
+	/* Stop the ticks, including one that may already be on its way, and
+	keep the exit handlers on this task even if they leave a critical
+	section. */
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+	signal( SIGALRM, SIG_IGN );
+	xTickPending = pdFALSE;
+	vTaskSuspendAll();
+	clock_gettime( CLOCK_MONOTONIC, &xEndTime );
+
+	dWallSeconds = ( xEndTime.tv_sec - xStartTime.tv_sec ) + ( xEndTime.tv_nsec - xStartTime.tv_nsec ) / 1e9;
+	dSimulatedSeconds = ( double ) ulTicksRun / configTICK_RATE_HZ;
+
+	fprintf( stderr, "port: %lu ticks (%.1f s simulated) in %.2f s, %.0f times real time\n",
+		ulTicksRun, dSimulatedSeconds, dWallSeconds, dSimulatedSeconds / dWallSeconds );
+
+	#if configUSE_TICKLESS_IDLE == 1
+	{
+		fprintf( stderr, "port: %lu tick interrupts suppressed in %lu sleeps, %.1f%% of all ticks\n",
+			ulTicksSuppressed, ulSleeps, ulTicksRun ? 100.0 * ulTicksSuppressed / ulTicksRun : 0.0 );
+	}
+	#endif
+
+	exit( 0 );
+}
@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------
+ * Port specific definitions for running the kernel as a process on a POSIX
+ * (Linux) host.  See port.c for a description of the port.
+ *----------------------------------------------------------*/
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions.  The stack type is as wide as a pointer, as the first
+stack word holds a pointer to the task's host context. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef unsigned portSHORT portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffff
+#else
+	typedef unsigned portLONG portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffffffff
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_RATE_MS			( ( portTickType ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities.  A yield is pended like PendSV on the Cortex-M3, and
+taken as soon as interrupts are enabled. */
+extern void vPortYield( void );
+#define portYIELD()					vPortYield()
+
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYield()
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Interrupts (the tick signal and pended
+yields) are masked with a flag rather than the process signal mask, so
+entering and leaving a critical section costs no system calls. */
+extern void vPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( void );
+extern unsigned portBASE_TYPE uxPortSetInterruptMaskFromISR( void );
+extern void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE uxSavedMask );
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		uxPortSetInterruptMaskFromISR()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMaskFromISR( x )
+#define portDISABLE_INTERRUPTS()				vPortSetInterruptMask()
+#define portENABLE_INTERRUPTS()					vPortClearInterruptMask()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+/* Port specific optimisations.  The ready priorities are kept in a bitmap and
+the highest one is found with a count leading zeros builtin, as on the
+Cortex-M3. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( ( sizeof( unsigned long ) * 8 - 1 ) - __builtin_clzl( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+
+/* Tickless idle.  The host has no low power mode: the port waits for the tick
+signal as usual, but only hands the kernel the tick that ends the sleep, and
+counts the others as suppressed. */
+#if configUSE_TICKLESS_IDLE == 1
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Run time stats.  The port keeps its own counter on the DWT cycle counter's
+time base, interpolated within each tick from the host clock, and the
+kernel uses it in place of portGET_RUN_TIME_COUNTER_VALUE().  The port also
+sets up the counter's time base in place of the target's
+portCONFIGURE_TIMER_FOR_RUN_TIME_STATS(), as the kernel takes its first
+sample before the scheduler is started. */
+#if configGENERATE_RUN_TIME_STATS == 1
+	extern void vPortConfigureRunTimeCounter( void );
+	extern unsigned long ulPortGetRunTimeCounterValue( void );
+	#undef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vPortConfigureRunTimeCounter()
+	#define portALT_GET_RUN_TIME_COUNTER_VALUE( ulCountValue ) ( ulCountValue ) = ulPortGetRunTimeCounterValue()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
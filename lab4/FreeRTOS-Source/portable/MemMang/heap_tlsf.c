@@ -0,0 +1,656 @@
+/*
+ * A pvPortMalloc() and vPortFree() with a bounded execution time, so memory
+ * can be allocated and freed again from time critical tasks.
+ *
+ * Allocations first try a set of fixed-size pools (configHEAP_POOLS), which
+ * are meant for the objects that are created and deleted most often: TCBs,
+ * task stacks and queues.  A request is served by the smallest pool whose
+ * blocks are large enough, as long as it is more than half a block (so small
+ * requests do not use up the large blocks), and taking or returning a block
+ * is a push or pop on the pool's free list.
+ *
+ * Everything else, and anything a pool has run out of blocks for, comes from
+ * a Two-Level Segregated Fit general heap.  Free blocks are kept in lists by
+ * size class: the first level is the power of two below the size, and the
+ * second splits each power of two into heapSL_INDEX_COUNT linear steps.  A
+ * bitmap per level records which lists are non-empty, so a large enough
+ * block is found with two count leading zeros instructions instead of a
+ * search.  The request is rounded up to the next class first, so any block
+ * in the list found will do, and what is left over is split off and filed as
+ * a free block.  Freed blocks are merged with free neighbours straight away
+ * (each block header points to the block before it), so the heap does not
+ * fragment into slivers.  Both paths take the same few steps whatever is in
+ * the heap, and only run with the scheduler suspended.
+ *
+ * vPortGetHeapStats() reports free space, the largest free block, the low
+ * water mark and the allocation counts.  Fragmentation of the general heap
+ * is 1 - xSizeOfLargestFreeBlockInBytes / xAvailableHeapSpaceInBytes.
+ *
+ * See heap_1.c for the original allocator, which cannot free.
+ */
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Nothing here is used when the kernel is built without a heap. */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+/* Size classes.  Blocks are multiples of portBYTE_ALIGNMENT.  Below
+heapSMALL_BLOCK_SIZE the classes are portBYTE_ALIGNMENT apart; above it, each
+power of two is split into heapSL_INDEX_COUNT classes. */
+#if portBYTE_ALIGNMENT == 8
+	#define heapALIGNMENT_LOG2		3
+#elif portBYTE_ALIGNMENT == 4
+	#define heapALIGNMENT_LOG2		2
+#else
+	#error heap_tlsf.c needs a portBYTE_ALIGNMENT of 4 or 8.
+#endif
+
+#define heapSL_INDEX_COUNT_LOG2		3
+#define heapSL_INDEX_COUNT			( 1 << heapSL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT			( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT			11
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+#define heapMAX_BLOCK_SIZE			( ( ( size_t ) 1 << ( heapFL_INDEX_SHIFT + heapFL_INDEX_COUNT - 1 ) ) - 1 )
+
+/* Header at the start of every block of the general heap.  The free list
+links are only used while the block is free, and are the first bytes of the
+memory handed out otherwise. */
+typedef struct xBLOCK_HEADER
+{
+	struct xBLOCK_HEADER *pxPrevPhysical;	/*< The block just before this one in memory, or NULL. */
+	size_t xSize;							/*< Bytes after the header, with heapBLOCK_FREE set while free. */
+	struct xBLOCK_HEADER *pxNextFree;		/*< Next block in the same free list. */
+	struct xBLOCK_HEADER *pxPrevFree;		/*< Previous block in the same free list. */
+} xBlockHeader;
+
+#define heapBLOCK_OVERHEAD			offsetof( xBlockHeader, pxNextFree )
+#define heapMIN_BLOCK_SIZE			( sizeof( xBlockHeader ) - heapBLOCK_OVERHEAD )
+#define heapBLOCK_FREE				( ( size_t ) 1 )
+#define heapBLOCK_SIZE( pxBlock )	( ( pxBlock )->xSize & ~heapBLOCK_FREE )
+#define heapNEXT_PHYSICAL( pxBlock )	( ( xBlockHeader * ) ( ( unsigned char * ) ( pxBlock ) + heapBLOCK_OVERHEAD + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* A fixed-size pool.  Free blocks hold a pointer to the next free block. */
+typedef struct xPOOL
+{
+	unsigned char *pucStart;				/*< First block. */
+	unsigned char *pucEnd;					/*< Byte after the last block. */
+	size_t xBlockSize;						/*< Size of each block, a multiple of portBYTE_ALIGNMENT. */
+	void *pvFreeList;						/*< First free block, or NULL. */
+	size_t xFreeBlocks;						/*< Number of free blocks. */
+} xPool;
+
+typedef struct xPOOL_CONFIG
+{
+	size_t xBlockSize;
+	size_t xBlocks;
+} xPoolConfig;
+
+#ifdef configHEAP_POOLS
+	static const xPoolConfig xPoolConfigs[] = configHEAP_POOLS;
+	#define heapNUM_POOLS			( sizeof( xPoolConfigs ) / sizeof( xPoolConfigs[ 0 ] ) )
+	static xPool xPools[ heapNUM_POOLS ];
+#else
+	#define heapNUM_POOLS			0
+#endif
+
+/* Allocate the memory for the heap.  The struct is used to force byte
+alignment without using any non-portable code. */
+static union xRTOS_HEAP
+{
+	#if portBYTE_ALIGNMENT == 8
+		volatile portDOUBLE dDummy;
+	#else
+		volatile unsigned long ulDummy;
+	#endif
+	unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
+} xHeap;
+
+/* Free lists of the general heap, and the bitmaps of the ones that are not
+empty. */
+static xBlockHeader *pxFreeBlocks[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static unsigned long ulFirstLevelMap;
+static unsigned long ulSecondLevelMap[ heapFL_INDEX_COUNT ];
+
+static portBASE_TYPE xHeapInitialised = pdFALSE;
+
+/* Statistics.  The free byte counts are of memory that can be handed out,
+so block headers are not included. */
+static size_t xFreeBytes = 0;
+static size_t xPoolFreeBytes = 0;
+static size_t xMinimumEverFreeBytes = 0;
+static size_t xFreeBlockCount = 0;
+static size_t xAllocations = 0;
+static size_t xFrees = 0;
+static size_t xPoolAllocations = 0;
+static size_t xPoolMisses = 0;
+
+/*
+ * Carve the pools out of the heap and make the rest one free block.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Index of the most significant set bit of a non-zero value.
+ */
+static portBASE_TYPE prvFls( unsigned long ulValue );
+
+/*
+ * The size class of a block.
+ */
+static void prvMapping( size_t xSize, portBASE_TYPE *pxFirst, portBASE_TYPE *pxSecond );
+
+/*
+ * File a free block in, or take it out of, the list for its size class.
+ */
+static void prvInsertFreeBlock( xBlockHeader *pxBlock );
+static void prvRemoveFreeBlock( xBlockHeader *pxBlock );
+
+/*
+ * Allocate from a pool, or the general heap.  Return NULL if they cannot
+ * provide the memory.
+ */
+static void *prvPoolAllocate( size_t xWantedSize );
+static void *prvBlockAllocate( size_t xWantedSize );
+
+/*
+ * Return memory to its pool.  Returns pdFALSE if it did not come from one.
+ */
+static portBASE_TYPE prvPoolFree( void *pv );
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvFls( unsigned long ulValue )
+{
+	#if defined( __CC_ARM )
+		return 31 - __clz( ulValue );
+	#elif defined( __GNUC__ )
+		return ( portBASE_TYPE ) ( sizeof( unsigned long ) * 8 - 1 ) - __builtin_clzl( ulValue );
+	#else
+	{
+	portBASE_TYPE xBit = 0;
+
+		/* Binary search, five steps for 32 bits. */
+		if( ulValue & 0xffff0000UL ) { ulValue >>= 16; xBit += 16; }
+		if( ulValue & 0xff00UL ) { ulValue >>= 8; xBit += 8; }
+		if( ulValue & 0xf0UL ) { ulValue >>= 4; xBit += 4; }
+		if( ulValue & 0xcUL ) { ulValue >>= 2; xBit += 2; }
+		if( ulValue & 0x2UL ) { xBit += 1; }
+
+		return xBit;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapping( size_t xSize, portBASE_TYPE *pxFirst, portBASE_TYPE *pxSecond )
+{
+portBASE_TYPE xBit;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		*pxFirst = 0;
+		*pxSecond = ( portBASE_TYPE ) ( xSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+	}
+	else
+	{
+		xBit = prvFls( ( unsigned long ) xSize );
+		*pxSecond = ( portBASE_TYPE ) ( ( xSize >> ( xBit - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+		*pxFirst = xBit - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( xBlockHeader *pxBlock )
+{
+portBASE_TYPE xFirst, xSecond;
+xBlockHeader *pxHead;
+
+	prvMapping( heapBLOCK_SIZE( pxBlock ), &xFirst, &xSecond );
+	pxHead = pxFreeBlocks[ xFirst ][ xSecond ];
+
+	pxBlock->xSize |= heapBLOCK_FREE;
+	pxBlock->pxPrevFree = NULL;
+	pxBlock->pxNextFree = pxHead;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPrevFree = pxBlock;
+	}
+
+	pxFreeBlocks[ xFirst ][ xSecond ] = pxBlock;
+	ulFirstLevelMap |= 1UL << xFirst;
+	ulSecondLevelMap[ xFirst ] |= 1UL << xSecond;
+	xFreeBlockCount++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( xBlockHeader *pxBlock )
+{
+portBASE_TYPE xFirst, xSecond;
+
+	prvMapping( heapBLOCK_SIZE( pxBlock ), &xFirst, &xSecond );
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPrevFree = pxBlock->pxPrevFree;
+	}
+
+	if( pxBlock->pxPrevFree != NULL )
+	{
+		pxBlock->pxPrevFree->pxNextFree = pxBlock->pxNextFree;
+	}
+	else
+	{
+		/* It was the head of its list. */
+		pxFreeBlocks[ xFirst ][ xSecond ] = pxBlock->pxNextFree;
+
+		if( pxBlock->pxNextFree == NULL )
+		{
+			ulSecondLevelMap[ xFirst ] &= ~( 1UL << xSecond );
+
+			if( ulSecondLevelMap[ xFirst ] == 0 )
+			{
+				ulFirstLevelMap &= ~( 1UL << xFirst );
+			}
+		}
+	}
+
+	pxBlock->xSize &= ~heapBLOCK_FREE;
+	xFreeBlockCount--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+unsigned char *pucNext = xHeap.ucHeap;
+unsigned char *pucEnd = xHeap.ucHeap + ( configTOTAL_HEAP_SIZE & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) );
+xBlockHeader *pxBlock, *pxSentinel;
+size_t xPool, xBlock, xBlockSize;
+
+	for( xPool = 0; xPool < heapNUM_POOLS; xPool++ )
+	{
+		/* Blocks have to be aligned and hold the free list link. */
+		xBlockSize = ( xPoolConfigs[ xPool ].xBlockSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		if( xBlockSize < sizeof( void * ) )
+		{
+			xBlockSize = ( sizeof( void * ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		}
+
+		/* The pools must leave room for at least the general heap's
+		headers. */
+		configASSERT( ( size_t ) ( pucEnd - pucNext ) >= xBlockSize * xPoolConfigs[ xPool ].xBlocks + 2 * sizeof( xBlockHeader ) );
+
+		xPools[ xPool ].xBlockSize = xBlockSize;
+		xPools[ xPool ].pucStart = pucNext;
+		xPools[ xPool ].pvFreeList = NULL;
+		xPools[ xPool ].xFreeBlocks = 0;
+
+		for( xBlock = 0; xBlock < xPoolConfigs[ xPool ].xBlocks; xBlock++ )
+		{
+			if( ( size_t ) ( pucEnd - pucNext ) < xBlockSize + 2 * sizeof( xBlockHeader ) )
+			{
+				break;
+			}
+
+			*( void ** ) pucNext = xPools[ xPool ].pvFreeList;
+			xPools[ xPool ].pvFreeList = pucNext;
+			xPools[ xPool ].xFreeBlocks++;
+			xPoolFreeBytes += xBlockSize;
+			pucNext += xBlockSize;
+		}
+
+		xPools[ xPool ].pucEnd = pucNext;
+	}
+
+	/* The rest is one free block, followed by an empty block that is always
+	in use so the last real block never has to be merged with what follows
+	it. */
+	pxBlock = ( xBlockHeader * ) pucNext;
+	pxBlock->pxPrevPhysical = NULL;
+	pxBlock->xSize = ( size_t ) ( pucEnd - pucNext ) - 2 * heapBLOCK_OVERHEAD;
+
+	/* The size classes end at heapMAX_BLOCK_SIZE.  Raise heapFL_INDEX_COUNT
+	to use a larger heap. */
+	configASSERT( pxBlock->xSize <= heapMAX_BLOCK_SIZE );
+
+	if( pxBlock->xSize > heapMAX_BLOCK_SIZE )
+	{
+		pxBlock->xSize = heapMAX_BLOCK_SIZE & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	}
+
+	pxSentinel = heapNEXT_PHYSICAL( pxBlock );
+	pxSentinel->pxPrevPhysical = pxBlock;
+	pxSentinel->xSize = 0;
+
+	prvInsertFreeBlock( pxBlock );
+
+	xFreeBytes = heapBLOCK_SIZE( pxBlock );
+	xMinimumEverFreeBytes = xFreeBytes + xPoolFreeBytes;
+	xHeapInitialised = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvPoolAllocate( size_t xWantedSize )
+{
+size_t xPool;
+void *pvReturn = NULL;
+
+	for( xPool = 0; xPool < heapNUM_POOLS; xPool++ )
+	{
+		if( xWantedSize <= xPools[ xPool ].xBlockSize )
+		{
+			break;
+		}
+	}
+
+	/* Only the smallest pool that fits is used, and not at all if the
+	request would waste more than half of its block. */
+	if( ( xPool < heapNUM_POOLS ) && ( xWantedSize > xPools[ xPool ].xBlockSize / 2 ) )
+	{
+		pvReturn = xPools[ xPool ].pvFreeList;
+
+		if( pvReturn != NULL )
+		{
+			xPools[ xPool ].pvFreeList = *( void ** ) pvReturn;
+			xPools[ xPool ].xFreeBlocks--;
+			xPoolFreeBytes -= xPools[ xPool ].xBlockSize;
+			xPoolAllocations++;
+		}
+		else
+		{
+			xPoolMisses++;
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvBlockAllocate( size_t xWantedSize )
+{
+size_t xSearchSize;
+portBASE_TYPE xFirst, xSecond;
+unsigned long ulMap;
+xBlockHeader *pxBlock, *pxRemainder;
+
+	xWantedSize = ( xWantedSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	if( xWantedSize < heapMIN_BLOCK_SIZE )
+	{
+		xWantedSize = heapMIN_BLOCK_SIZE;
+	}
+
+	/* Round up to the start of the next size class, so that every block in
+	the list found is big enough. */
+	xSearchSize = xWantedSize;
+
+	if( xSearchSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xSearchSize += ( ( size_t ) 1 << ( prvFls( ( unsigned long ) xSearchSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+
+	if( xSearchSize > heapMAX_BLOCK_SIZE )
+	{
+		return NULL;
+	}
+
+	prvMapping( xSearchSize, &xFirst, &xSecond );
+
+	/* A non-empty list in this first level class, or failing that the
+	smallest non-empty one in a larger class. */
+	ulMap = ulSecondLevelMap[ xFirst ] & ( ~0UL << xSecond );
+
+	if( ulMap == 0 )
+	{
+		ulMap = ulFirstLevelMap & ( ~0UL << ( xFirst + 1 ) );
+
+		if( ulMap == 0 )
+		{
+			return NULL;
+		}
+
+		xFirst = prvFls( ulMap & ( 0UL - ulMap ) );
+		ulMap = ulSecondLevelMap[ xFirst ];
+	}
+
+	xSecond = prvFls( ulMap & ( 0UL - ulMap ) );
+	pxBlock = pxFreeBlocks[ xFirst ][ xSecond ];
+
+	prvRemoveFreeBlock( pxBlock );
+	xFreeBytes -= pxBlock->xSize;
+
+	/* Split off what is not needed, if it can make a block of its own. */
+	if( pxBlock->xSize >= xWantedSize + sizeof( xBlockHeader ) )
+	{
+		pxRemainder = ( xBlockHeader * ) ( ( unsigned char * ) pxBlock + heapBLOCK_OVERHEAD + xWantedSize );
+		pxRemainder->pxPrevPhysical = pxBlock;
+		pxRemainder->xSize = pxBlock->xSize - xWantedSize - heapBLOCK_OVERHEAD;
+		heapNEXT_PHYSICAL( pxRemainder )->pxPrevPhysical = pxRemainder;
+		pxBlock->xSize = xWantedSize;
+
+		prvInsertFreeBlock( pxRemainder );
+		xFreeBytes += heapBLOCK_SIZE( pxRemainder );
+	}
+
+	return ( unsigned char * ) pxBlock + heapBLOCK_OVERHEAD;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvPoolFree( void *pv )
+{
+size_t xPool;
+unsigned char *puc = ( unsigned char * ) pv;
+
+	for( xPool = 0; xPool < heapNUM_POOLS; xPool++ )
+	{
+		if( ( puc >= xPools[ xPool ].pucStart ) && ( puc < xPools[ xPool ].pucEnd ) )
+		{
+			*( void ** ) pv = xPools[ xPool ].pvFreeList;
+			xPools[ xPool ].pvFreeList = pv;
+			xPools[ xPool ].xFreeBlocks++;
+			xPoolFreeBytes += xPools[ xPool ].xBlockSize;
+			return pdTRUE;
+		}
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		if( xHeapInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= heapMAX_BLOCK_SIZE ) )
+		{
+			pvReturn = prvPoolAllocate( xWantedSize );
+
+			if( pvReturn == NULL )
+			{
+				pvReturn = prvBlockAllocate( xWantedSize );
+			}
+		}
+
+		if( pvReturn != NULL )
+		{
+			xAllocations++;
+
+			if( xFreeBytes + xPoolFreeBytes < xMinimumEverFreeBytes )
+			{
+				xMinimumEverFreeBytes = xFreeBytes + xPoolFreeBytes;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+xBlockHeader *pxBlock, *pxNeighbour;
+
+	if( pv == NULL )
+	{
+		return;
+	}
+
+	vTaskSuspendAll();
+	{
+		xFrees++;
+
+		if( prvPoolFree( pv ) == pdFALSE )
+		{
+			pxBlock = ( xBlockHeader * ) ( ( unsigned char * ) pv - heapBLOCK_OVERHEAD );
+
+			/* Freeing memory twice, or memory that did not come from here. */
+			configASSERT( ( pxBlock->xSize & heapBLOCK_FREE ) == 0 );
+
+			xFreeBytes += pxBlock->xSize;
+
+			/* Merge with the free neighbours, whose headers become free
+			memory too. */
+			pxNeighbour = pxBlock->pxPrevPhysical;
+
+			if( ( pxNeighbour != NULL ) && ( pxNeighbour->xSize & heapBLOCK_FREE ) )
+			{
+				prvRemoveFreeBlock( pxNeighbour );
+				pxNeighbour->xSize += heapBLOCK_OVERHEAD + pxBlock->xSize;
+				pxBlock = pxNeighbour;
+				xFreeBytes += heapBLOCK_OVERHEAD;
+			}
+
+			pxNeighbour = heapNEXT_PHYSICAL( pxBlock );
+
+			if( pxNeighbour->xSize & heapBLOCK_FREE )
+			{
+				prvRemoveFreeBlock( pxNeighbour );
+				pxBlock->xSize += heapBLOCK_OVERHEAD + pxNeighbour->xSize;
+				xFreeBytes += heapBLOCK_OVERHEAD;
+			}
+
+			heapNEXT_PHYSICAL( pxBlock )->pxPrevPhysical = pxBlock;
+			prvInsertFreeBlock( pxBlock );
+		}
+	}
+	xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* Only required when static memory is not cleared.  Must not be called
+	once anything has been allocated. */
+	xHeapInitialised = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+size_t xReturn;
+
+	vTaskSuspendAll();
+	{
+		if( xHeapInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+
+		xReturn = xFreeBytes + xPoolFreeBytes;
+	}
+	xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+size_t xReturn;
+
+	vTaskSuspendAll();
+	{
+		if( xHeapInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+
+		xReturn = xMinimumEverFreeBytes;
+	}
+	xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( xHeapStats *pxHeapStats )
+{
+portBASE_TYPE xFirst;
+unsigned long ulMap;
+xBlockHeader *pxBlock;
+size_t xLargest = 0;
+
+	vTaskSuspendAll();
+	{
+		if( xHeapInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+
+		/* The largest free block is in the largest non-empty class.  Blocks
+		in a class differ in size, so that one list has to be walked. */
+		if( ulFirstLevelMap != 0 )
+		{
+			xFirst = prvFls( ulFirstLevelMap );
+			ulMap = ulSecondLevelMap[ xFirst ];
+
+			for( pxBlock = pxFreeBlocks[ xFirst ][ prvFls( ulMap ) ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFree )
+			{
+				if( heapBLOCK_SIZE( pxBlock ) > xLargest )
+				{
+					xLargest = heapBLOCK_SIZE( pxBlock );
+				}
+			}
+		}
+
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytes;
+		pxHeapStats->xAvailablePoolSpaceInBytes = xPoolFreeBytes;
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xLargest;
+		pxHeapStats->xNumberOfFreeBlocks = xFreeBlockCount;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytes;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xFrees;
+		pxHeapStats->xNumberOfPoolAllocations = xPoolAllocations;
+		pxHeapStats->xNumberOfPoolMisses = xPoolMisses;
+	}
+	xTaskResumeAll();
+}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
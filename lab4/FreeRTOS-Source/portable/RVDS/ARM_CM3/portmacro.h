@@ -141,11 +141,17 @@ http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html before disagreeing. */
 
 #define portNOP()
 
+/* Tickless idle/low power functionality. */
+#if configUSE_TICKLESS_IDLE == 1
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
 
 	/* Check the configuration. */
-	#if( configMAX_PRIORITIES >= 32 )
+	#if( configMAX_PRIORITIES > 32 )
 		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
 	#endif
 
@@ -157,7 +163,7 @@ http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html before disagreeing. */
 	
 	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __clz( ( uxReadyPriorities ) ) )
 
-#endif /* taskRECORD_READY_PRIORITY */
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 
 #ifdef __cplusplus
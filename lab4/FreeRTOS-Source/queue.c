@@ -113,6 +113,7 @@ zero. */
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( 4U )
+#define queueQUEUE_TYPE_BLOCK_POOL			( 5U )
 
 /*
  * Definition of the queue used by the scheduler.
@@ -141,6 +142,10 @@ typedef struct QueueDefinition
 		unsigned char ucQueueType;
 	#endif
 
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the memory of the queue came from the application, so it is not freed when the queue is deleted. */
+	#endif
+
 } xQUEUE;
 /*-----------------------------------------------------------*/
 
@@ -151,6 +156,14 @@ typedef struct QueueDefinition
  */
 typedef xQUEUE * xQueueHandle;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* xStaticQueue must be the same size as the queue it stands in for.  This
+	will not compile if a member is added to one and not the other. */
+	typedef char queueSTATIC_QUEUE_SIZE_CHECK[ ( sizeof( xStaticQueue ) == sizeof( xQUEUE ) ) ? 1 : -1 ];
+
+#endif
+
 /*
  * Prototypes for public functions are included here so we don't have to
  * include the API header file (as it defines xQueueHandle differently).  These
@@ -173,12 +186,28 @@ signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle pxQueue ) PRI
 signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 void vQueueWaitForMessageRestricted( xQueueHandle pxQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueReceiveBatchRestricted( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems ) PRIVILEGED_FUNCTION;
 unsigned char ucQueueGetQueueNumber( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 void vQueueSetQueueNumber( xQueueHandle pxQueue, unsigned char ucQueueNumber ) PRIVILEGED_FUNCTION;
 unsigned char ucQueueGetQueueType( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGenericReset( xQueueHandle pxQueue, portBASE_TYPE xNewQueue ) PRIVILEGED_FUNCTION;
 xTaskHandle xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+	xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+	xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_BLOCK_POOLS == 1 )
+	xQueueHandle xQueueCreateBlockPool( unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize ) PRIVILEGED_FUNCTION;
+	xQueueHandle xQueueCreateBlockPoolStatic( unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize, unsigned char *pucBlockStorage, void **ppvFreeBlocks, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+	signed portBASE_TYPE xQueueSendPointer( xQueueHandle pxQueue, void *pvPointer, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+	signed portBASE_TYPE xQueueSendPointerFromISR( xQueueHandle pxQueue, void *pvPointer, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+	void *pvQueueReceivePointer( xQueueHandle pxQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+	void *pvQueueReceivePointerFromISR( xQueueHandle pxQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Co-routine queue functions differ from task queue functions.  Co-routines are
  * an optional component.
@@ -226,6 +255,20 @@ xTaskHandle xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
  */
 static void prvUnlockQueue( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by the dynamic and static versions of xQueueGenericCreate() once the
+ * memory for the queue and its storage area has been obtained.
+ */
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the dynamic and static versions of xQueueCreateMutex() once the
+ * memory for the mutex has been obtained.
+ */
+#if ( configUSE_MUTEXES == 1 )
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Uses a critical section to determine if there is any data in a queue.
  *
@@ -240,6 +283,14 @@ static signed portBASE_TYPE prvIsQueueEmpty( const xQueueHandle pxQueue ) PRIVIL
  */
 static signed portBASE_TYPE prvIsQueueFull( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Puts a pointer to each of the uxBlockCount blocks of uxBlockSize bytes at
+ * pucBlocks on a newly created block pool, so they are all free.
+ */
+#if ( configUSE_BLOCK_POOLS == 1 )
+	static void prvFillBlockPool( xQUEUE *pxPool, unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize, unsigned char *pucBlocks ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Copies an item into the queue, either at the front of the queue or the
  * back of the queue.
@@ -319,103 +370,170 @@ portBASE_TYPE xQueueGenericReset( xQueueHandle pxQueue, portBASE_TYPE xNewQueue
 }
 /*-----------------------------------------------------------*/
 
-xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType )
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage, unsigned char ucQueueType )
 {
-xQUEUE *pxNewQueue;
-size_t xQueueSizeInBytes;
-xQueueHandle xReturn = NULL;
-
 	/* Remove compiler warnings about unused parameters should
 	configUSE_TRACE_FACILITY not be set to 1. */
 	( void ) ucQueueType;
 
-	/* Allocate the new queue structure. */
-	if( uxQueueLength > ( unsigned portBASE_TYPE ) 0 )
+	/* Initialise the queue members as described above where the
+	queue type is defined. */
+	pxNewQueue->pcHead = pcQueueStorage;
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	xQueueGenericReset( pxNewQueue, pdTRUE );
+	#if ( configUSE_TRACE_FACILITY == 1 )
 	{
-		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
-		if( pxNewQueue != NULL )
-		{
-			/* Create the list of pointers to queue items.  The queue is one byte
-			longer than asked for to make wrap checking easier/faster. */
-			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ) + ( size_t ) 1;
+		pxNewQueue->ucQueueType = ucQueueType;
+	}
+	#endif /* configUSE_TRACE_FACILITY */
+
+	traceQUEUE_CREATE( pxNewQueue );
+}
+/*-----------------------------------------------------------*/
 
-			pxNewQueue->pcHead = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
-			if( pxNewQueue->pcHead != NULL )
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType )
+	{
+	xQUEUE *pxNewQueue;
+	size_t xQueueSizeInBytes;
+	signed char *pcQueueStorage;
+	xQueueHandle xReturn = NULL;
+
+		/* Allocate the new queue structure. */
+		if( uxQueueLength > ( unsigned portBASE_TYPE ) 0 )
+		{
+			pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
+			if( pxNewQueue != NULL )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				xQueueGenericReset( pxNewQueue, pdTRUE );
-				#if ( configUSE_TRACE_FACILITY == 1 )
+				/* Create the list of pointers to queue items.  The queue is one byte
+				longer than asked for to make wrap checking easier/faster. */
+				xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ) + ( size_t ) 1;
+
+				pcQueueStorage = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
+				if( pcQueueStorage != NULL )
 				{
-					pxNewQueue->ucQueueType = ucQueueType;
-				}
-				#endif /* configUSE_TRACE_FACILITY */
+					#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+					{
+						pxNewQueue->ucStaticallyAllocated = pdFALSE;
+					}
+					#endif
 
-				traceQUEUE_CREATE( pxNewQueue );
-				xReturn = pxNewQueue;
-			}
-			else
-			{
-				traceQUEUE_CREATE_FAILED( ucQueueType );
-				vPortFree( pxNewQueue );
+					prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, pcQueueStorage, ucQueueType );
+					xReturn = pxNewQueue;
+				}
+				else
+				{
+					traceQUEUE_CREATE_FAILED( ucQueueType );
+					vPortFree( pxNewQueue );
+				}
 			}
 		}
+
+		configASSERT( xReturn );
+
+		return xReturn;
 	}
 
-	configASSERT( xReturn );
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
-	return xReturn;
-}
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType )
+	{
+	xQUEUE *pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+
+		configASSERT( uxQueueLength > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pxStaticQueue );
+
+		/* A storage area is needed if, and only if, items are copied. */
+		configASSERT( ( pucQueueStorage != NULL ) == ( uxItemSize != ( unsigned portBASE_TYPE ) 0 ) );
+
+		#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+		}
+		#endif
+
+		/* A NULL pcHead marks a mutex, so a queue without a storage area
+		points it at itself instead.  Nothing is ever copied there. */
+		if( pucQueueStorage == NULL )
+		{
+			pucQueueStorage = ( unsigned char * ) pxNewQueue;
+		}
+
+		prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, ( signed char * ) pucQueueStorage, ucQueueType );
+
+		return pxNewQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_MUTEXES == 1 )
 
-	xQueueHandle xQueueCreateMutex( unsigned char ucQueueType )
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType )
 	{
-	xQUEUE *pxNewQueue;
-
 		/* Prevent compiler warnings about unused parameters if
 		configUSE_TRACE_FACILITY does not equal 1. */
 		( void ) ucQueueType;
 
+		/* Information required for priority inheritance. */
+		pxNewQueue->pxMutexHolder = NULL;
+		pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+
+		/* Queues used as a mutex no data is actually copied into or out
+		of the queue. */
+		pxNewQueue->pcWriteTo = NULL;
+		pxNewQueue->pcReadFrom = NULL;
+
+		/* Each mutex has a length of 1 (like a binary semaphore) and
+		an item size of 0 as nothing is actually copied into or out
+		of the mutex. */
+		pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
+		pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->xRxLock = queueUNLOCKED;
+		pxNewQueue->xTxLock = queueUNLOCKED;
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			pxNewQueue->ucQueueType = ucQueueType;
+		}
+		#endif
+
+		/* Ensure the event queues start with the correct state. */
+		vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+		vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+
+		traceCREATE_MUTEX( pxNewQueue );
+
+		/* Start with the semaphore in the expected state. */
+		xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateMutex( unsigned char ucQueueType )
+	{
+	xQUEUE *pxNewQueue;
+
 		/* Allocate the new queue structure. */
 		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
 		if( pxNewQueue != NULL )
 		{
-			/* Information required for priority inheritance. */
-			pxNewQueue->pxMutexHolder = NULL;
-			pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
-
-			/* Queues used as a mutex no data is actually copied into or out
-			of the queue. */
-			pxNewQueue->pcWriteTo = NULL;
-			pxNewQueue->pcReadFrom = NULL;
-
-			/* Each mutex has a length of 1 (like a binary semaphore) and
-			an item size of 0 as nothing is actually copied into or out
-			of the mutex. */
-			pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
-			pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->xRxLock = queueUNLOCKED;
-			pxNewQueue->xTxLock = queueUNLOCKED;
-
-			#if ( configUSE_TRACE_FACILITY == 1 )
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
-				pxNewQueue->ucQueueType = ucQueueType;
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
 			}
 			#endif
 
-			/* Ensure the event queues start with the correct state. */
-			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
-
-			traceCREATE_MUTEX( pxNewQueue );
-
-			/* Start with the semaphore in the expected state. */
-			xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+			prvInitialiseMutex( pxNewQueue, ucQueueType );
 		}
 		else
 		{
@@ -429,6 +547,28 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+
+		configASSERT( pxStaticQueue );
+
+		#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+		}
+		#endif
+
+		prvInitialiseMutex( pxNewQueue, ucQueueType );
+
+		return pxNewQueue;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xQueueGetMutexHolder == 1 ) )
 
 	void* xQueueGetMutexHolder( xQueueHandle xSemaphore )
@@ -548,7 +688,7 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if configUSE_COUNTING_SEMAPHORES == 1
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
 	xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount )
 	{
@@ -574,6 +714,189 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_COUNTING_SEMAPHORES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue )
+	{
+	xQueueHandle pxHandle;
+
+		configASSERT( uxInitialCount <= uxCountValue );
+
+		pxHandle = xQueueGenericCreateStatic( ( unsigned portBASE_TYPE ) uxCountValue, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+		pxHandle->uxMessagesWaiting = uxInitialCount;
+
+		traceCREATE_COUNTING_SEMAPHORE();
+
+		return pxHandle;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+	static void prvFillBlockPool( xQUEUE *pxPool, unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize, unsigned char *pucBlocks )
+	{
+	unsigned portBASE_TYPE uxBlock;
+	void *pvBlock;
+
+		/* Nothing can be waiting on a pool that has not been returned to the
+		caller yet, so the pointers can be written straight into the storage
+		area. */
+		for( uxBlock = ( unsigned portBASE_TYPE ) 0U; uxBlock < uxBlockCount; uxBlock++ )
+		{
+			pvBlock = ( void * ) ( pucBlocks + ( uxBlock * uxBlockSize ) );
+			prvCopyDataToQueue( pxPool, &pvBlock, queueSEND_TO_BACK );
+		}
+	}
+
+#endif /* configUSE_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_BLOCK_POOLS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateBlockPool( unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize )
+	{
+	xQUEUE *pxNewQueue;
+	size_t xFreeListSizeInBytes;
+	signed char *pcQueueStorage;
+	xQueueHandle xReturn = NULL;
+
+		if( ( uxBlockCount > ( unsigned portBASE_TYPE ) 0 ) && ( uxBlockSize > ( unsigned portBASE_TYPE ) 0 ) )
+		{
+			pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
+			if( pxNewQueue != NULL )
+			{
+				/* The free list and the blocks share one allocation, so
+				vQueueDelete() frees both through pcHead.  Each block is
+				rounded up to keep the next one aligned. */
+				uxBlockSize = ( uxBlockSize + ( unsigned portBASE_TYPE ) portBYTE_ALIGNMENT_MASK ) & ~( ( unsigned portBASE_TYPE ) portBYTE_ALIGNMENT_MASK );
+				xFreeListSizeInBytes = ( ( size_t ) uxBlockCount * sizeof( void * ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+				pcQueueStorage = ( signed char * ) pvPortMalloc( xFreeListSizeInBytes + ( ( size_t ) uxBlockCount * ( size_t ) uxBlockSize ) );
+				if( pcQueueStorage != NULL )
+				{
+					#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+					{
+						pxNewQueue->ucStaticallyAllocated = pdFALSE;
+					}
+					#endif
+
+					prvInitialiseNewQueue( pxNewQueue, uxBlockCount, sizeof( void * ), pcQueueStorage, queueQUEUE_TYPE_BLOCK_POOL );
+					prvFillBlockPool( pxNewQueue, uxBlockCount, uxBlockSize, ( unsigned char * ) pcQueueStorage + xFreeListSizeInBytes );
+					xReturn = pxNewQueue;
+				}
+				else
+				{
+					traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BLOCK_POOL );
+					vPortFree( pxNewQueue );
+				}
+			}
+		}
+
+		configASSERT( xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_BLOCK_POOLS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateBlockPoolStatic( unsigned portBASE_TYPE uxBlockCount, unsigned portBASE_TYPE uxBlockSize, unsigned char *pucBlockStorage, void **ppvFreeBlocks, xStaticQueue *pxStaticQueue )
+	{
+	xQueueHandle pxHandle;
+
+		configASSERT( pucBlockStorage );
+		configASSERT( uxBlockSize > ( unsigned portBASE_TYPE ) 0 );
+
+		/* The application sized the storage, so the block size cannot be
+		rounded up here as xQueueCreateBlockPool() does.  It has to keep
+		every block as aligned as the first one already. */
+		configASSERT( ( uxBlockSize & ( unsigned portBASE_TYPE ) portBYTE_ALIGNMENT_MASK ) == ( unsigned portBASE_TYPE ) 0 );
+
+		pxHandle = xQueueGenericCreateStatic( uxBlockCount, sizeof( void * ), ( unsigned char * ) ppvFreeBlocks, pxStaticQueue, queueQUEUE_TYPE_BLOCK_POOL );
+
+		if( pxHandle != NULL )
+		{
+			prvFillBlockPool( pxHandle, uxBlockCount, uxBlockSize, pucBlockStorage );
+		}
+
+		return pxHandle;
+	}
+
+#endif /* configUSE_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+	signed portBASE_TYPE xQueueSendPointer( xQueueHandle pxQueue, void *pvPointer, portTickType xTicksToWait )
+	{
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize == sizeof( void * ) );
+
+		/* Only the pointer is copied into the queue.  Whatever it points to
+		now belongs to the task that receives it. */
+		return xQueueGenericSend( pxQueue, &pvPointer, xTicksToWait, queueSEND_TO_BACK );
+	}
+
+#endif /* configUSE_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+	signed portBASE_TYPE xQueueSendPointerFromISR( xQueueHandle pxQueue, void *pvPointer, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize == sizeof( void * ) );
+
+		return xQueueGenericSendFromISR( pxQueue, &pvPointer, pxHigherPriorityTaskWoken, queueSEND_TO_BACK );
+	}
+
+#endif /* configUSE_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+	void *pvQueueReceivePointer( xQueueHandle pxQueue, portTickType xTicksToWait )
+	{
+	void *pvPointer;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize == sizeof( void * ) );
+
+		if( xQueueGenericReceive( pxQueue, &pvPointer, xTicksToWait, pdFALSE ) != pdPASS )
+		{
+			pvPointer = NULL;
+		}
+
+		return pvPointer;
+	}
+
+#endif /* configUSE_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+	void *pvQueueReceivePointerFromISR( xQueueHandle pxQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	void *pvPointer;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize == sizeof( void * ) );
+
+		if( xQueueReceiveFromISR( pxQueue, &pvPointer, pxHigherPriorityTaskWoken ) != pdPASS )
+		{
+			pvPointer = NULL;
+		}
+
+		return pvPointer;
+	}
+
+#endif /* configUSE_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
 signed portBASE_TYPE xQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
 {
 signed portBASE_TYPE xEntryTimeSet = pdFALSE;
@@ -1198,8 +1521,27 @@ void vQueueDelete( xQueueHandle pxQueue )
 
 	traceQUEUE_DELETE( pxQueue );
 	vQueueUnregisterQueue( pxQueue );
-	vPortFree( pxQueue->pcHead );
-	vPortFree( pxQueue );
+
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	{
+		/* Memory provided by the application is not freed. */
+		if( pxQueue->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxQueue->pcHead );
+			vPortFree( pxQueue );
+		}
+	}
+	#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		vPortFree( pxQueue->pcHead );
+		vPortFree( pxQueue );
+	}
+	#else
+	{
+		/* All the memory belongs to the application. */
+		( void ) pxQueue;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -1681,4 +2023,50 @@ signed portBASE_TYPE xReturn;
 	}
 
 #endif
+/*-----------------------------------------------------------*/
+
+#if configUSE_TIMERS == 1
+
+	unsigned portBASE_TYPE uxQueueReceiveBatchRestricted( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems )
+	{
+	unsigned portBASE_TYPE uxItems = ( unsigned portBASE_TYPE ) 0U;
+
+		/* This function should not be called by application code hence the
+		'Restricted' in its name.  It is not part of the public API.  It is
+		used by the timer service task to drain its command queue.
+
+		Up to uxMaxItems items are copied into pvBuffer, one after the other,
+		within a single critical section rather than one critical section per
+		item, and the function never blocks.  A task waiting to send is woken
+		for each item taken, as it would be by that many calls to
+		xQueueReceive().  The critical section grows with uxMaxItems, so it
+		should be kept small. */
+		configASSERT( pxQueue );
+		configASSERT( pvBuffer );
+
+		taskENTER_CRITICAL();
+		{
+			while( ( uxItems < uxMaxItems ) && ( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 ) )
+			{
+				traceQUEUE_RECEIVE( pxQueue );
+
+				prvCopyDataFromQueue( pxQueue, ( ( char * ) pvBuffer ) + ( uxItems * pxQueue->uxItemSize ) );
+				--( pxQueue->uxMessagesWaiting );
+				++uxItems;
+
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) == pdTRUE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return uxItems;
+	}
+
+#endif
 
@@ -127,10 +127,39 @@ typedef struct tskTaskControlBlock
 
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		unsigned long ulRunTimeCounter;		/*< Used for calculating how much CPU time each task is utilising. */
+		unsigned long ulSwitchInCount;		/*< Number of times the task has been switched in after another task ran. */
+		unsigned long ulLongestRun;			/*< Longest time, in run time counter units, the task has run for before another task was switched in. */
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The task's notification value, see xTaskNotify(). */
+		volatile unsigned char ucNotifyState;	/*< Whether the task is waiting for, or has received, a notification. */
+	#endif
+
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char ucStaticallyAllocated;	/*< Which of the TCB and stack came from the application, so only the others are freed when the task is deleted. */
 	#endif
 
 } tskTCB;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* xStaticTask must be the same size as the TCB it stands in for.  This
+	will not compile if a member is added to one and not the other. */
+	typedef char tskSTATIC_TCB_SIZE_CHECK[ ( sizeof( xStaticTask ) == sizeof( tskTCB ) ) ? 1 : -1 ];
+
+#endif
+
+/* Values for ucStaticallyAllocated. */
+#define tskDYNAMIC_TCB_AND_STACK		( ( unsigned char ) 0 )
+#define tskSTATIC_STACK_ONLY			( ( unsigned char ) 1 )
+#define tskSTATIC_TCB_AND_STACK			( ( unsigned char ) 2 )
+
+/* Values for ucNotifyState. */
+#define tskNOT_WAITING_NOTIFICATION		( ( unsigned char ) 0 )
+#define tskWAITING_NOTIFICATION			( ( unsigned char ) 1 )
+#define tskNOTIFICATION_RECEIVED		( ( unsigned char ) 2 )
+
 
 /*
  * Some kernel aware debuggers require data to be viewed to be global, rather
@@ -188,7 +217,10 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
 
 	PRIVILEGED_DATA static char pcStatsString[ 50 ] ;
 	PRIVILEGED_DATA static unsigned long ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	PRIVILEGED_DATA static unsigned long ulTaskRunStartTime = 0UL;		/*< Holds the value of a timer/counter when the running task took over from a different task. */
 	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, unsigned long ulTotalRunTime ) PRIVILEGED_FUNCTION;
+	static unsigned portBASE_TYPE prvSnapshotTasksWithinList( xTaskRunTimeStats *pxStatsArray, unsigned portBASE_TYPE uxArraySize, xList *pxList ) PRIVILEGED_FUNCTION;
+	static void prvFillRunTimeStats( tskTCB *pxTCB, xTaskRunTimeStats *pxStats, unsigned long ulCounterValue ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -415,11 +447,46 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the number of ticks the idle task can sleep for before a delayed task
+ * has to be unblocked, or 0 if a task other than the idle task can run.
+ */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	static portTickType prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Helpers for the task notification functions.  prvBlockForNotification moves
+ * the calling task out of the ready list until a notification arrives or
+ * xTicksToWait expires, and must be called from a critical section.
+ * prvUpdateNotifiedValue applies eAction to the notification value of pxTCB,
+ * and must be called with interrupts masked.
+ */
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockForNotification( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+	static portBASE_TYPE prvUpdateNotifiedValue( tskTCB *pxTCB, unsigned long ulValue, eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Allocates memory from the heap for a TCB and associated stack.  Checks the
  * allocation was successful.
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills in a new TCB and its stack, whichever way their memory was obtained,
+ * and adds the task to the ready list.  pxNewTCB is NULL if the memory could
+ * not be obtained.
+ */
+static signed portBASE_TYPE prvInitialiseNewTask( tskTCB *pxNewTCB, pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
 
 /*
  * Called from vTaskList.  vListTasks details all the tasks currently under
@@ -456,18 +523,61 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
  * TASK CREATION API documented in task.h
  *----------------------------------------------------------*/
 
-signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+	{
+	tskTCB * pxNewTCB;
+
+		/* Allocate the memory required by the TCB and stack for the new task,
+		checking that the allocation was successful. */
+		pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+
+		return prvInitialiseNewTask( pxNewTCB, pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, xRegions );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	signed portBASE_TYPE xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer )
+	{
+	tskTCB * pxNewTCB = NULL;
+
+		configASSERT( puxStackBuffer );
+		configASSERT( pxTaskBuffer );
+
+		if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+		{
+			/* Both the TCB and the stack belong to the application, so
+			nothing is allocated (or freed if the task is deleted). */
+			pxNewTCB = ( tskTCB * ) pxTaskBuffer;
+			pxNewTCB->pxStack = puxStackBuffer;
+
+			#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxNewTCB->ucStaticallyAllocated = tskSTATIC_TCB_AND_STACK;
+			}
+			#endif
+
+			/* Just to help debugging. */
+			memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+		}
+
+		return prvInitialiseNewTask( pxNewTCB, pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, NULL );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvInitialiseNewTask( tskTCB *pxNewTCB, pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, const xMemoryRegion * const xRegions )
 {
 signed portBASE_TYPE xReturn;
-tskTCB * pxNewTCB;
 
 	configASSERT( pxTaskCode );
 	configASSERT( ( ( uxPriority & ( ~portPRIVILEGE_BIT ) ) < configMAX_PRIORITIES ) );
 
-	/* Allocate the memory required by the TCB and stack for the new task,
-	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
-
 	if( pxNewTCB != NULL )
 	{
 		portSTACK_TYPE *pxTopOfStack;
@@ -1022,6 +1132,19 @@ tskTCB * pxNewTCB;
 				vListRemove( &( pxTCB->xEventListItem ) );
 			}
 
+			#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+			{
+				/* A task that was blocked waiting for a notification stops
+				waiting when it is suspended, so a later notification only
+				latches its value and does not make the task ready behind the
+				back of whoever suspended it. */
+				if( pxTCB->ucNotifyState == tskWAITING_NOTIFICATION )
+				{
+					pxTCB->ucNotifyState = tskNOT_WAITING_NOTIFICATION;
+				}
+			}
+			#endif
+
 			vListInsertEnd( ( xList * ) &xSuspendedTaskList, &( pxTCB->xGenericListItem ) );
 		}
 		taskEXIT_CRITICAL();
@@ -1189,7 +1312,26 @@ void vTaskStartScheduler( void )
 portBASE_TYPE xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+	xStaticTask *pxIdleTaskTCBBuffer = NULL;
+	portSTACK_TYPE *pxIdleTaskStackBuffer = NULL;
+	unsigned short usIdleTaskStackSize = tskIDLE_STACK_SIZE;
+
+		/* The memory for the idle task is provided by the application. */
+		vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &usIdleTaskStackSize );
+
+		#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+		{
+			xReturn = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", usIdleTaskStackSize, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), &xIdleTaskHandle, pxIdleTaskStackBuffer, pxIdleTaskTCBBuffer );
+		}
+		#else
+		{
+			xReturn = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", usIdleTaskStackSize, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), NULL, pxIdleTaskStackBuffer, pxIdleTaskTCBBuffer );
+		}
+		#endif
+	}
+	#elif ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 	{
 		/* Create the idle task, storing its handle in xIdleTaskHandle so it can
 		be returned by the xTaskGetIdleTaskHandle() function. */
@@ -1230,6 +1372,20 @@ portBASE_TYPE xReturn;
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* The counter need not start from zero, so time up to here is
+			not charged to the first task. */
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTaskSwitchedInTime );
+			#else
+				ulTaskSwitchedInTime = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+			ulTaskRunStartTime = ulTaskSwitchedInTime;
+			( pxCurrentTCB->ulSwitchInCount )++;
+		}
+		#endif
 		
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
@@ -1544,6 +1700,105 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 #endif
 /*----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	void vTaskGetTaskRunTimeStats( xTaskHandle xTask, xTaskRunTimeStats *pxStats )
+	{
+	tskTCB *pxTCB;
+	unsigned long ulCounterValue;
+
+		configASSERT( pxStats );
+
+		/* If null is passed in here then we are getting the stats of the
+		calling task. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulCounterValue );
+			#else
+				ulCounterValue = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+
+			prvFillRunTimeStats( pxTCB, pxStats, ulCounterValue );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetRunTimeSnapshot( xTaskRunTimeStats *pxStatsArray, unsigned portBASE_TYPE uxArraySize, unsigned long *pulTotalRunTime )
+	{
+	unsigned portBASE_TYPE uxQueue, uxTask = 0;
+
+		configASSERT( pxStatsArray );
+
+		vTaskSuspendAll();
+		{
+			/* Run through all the lists that could potentially contain a TCB,
+			as vTaskGetRunTimeStats() does, but fill in a table of binary
+			records rather than formatting a string. */
+			uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
+
+			do
+			{
+				uxQueue--;
+
+				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+				{
+					uxTask += prvSnapshotTasksWithinList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ) );
+				}
+			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+
+			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+			{
+				uxTask += prvSnapshotTasksWithinList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, ( xList * ) pxDelayedTaskList );
+			}
+
+			if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+			{
+				uxTask += prvSnapshotTasksWithinList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, ( xList * ) pxOverflowDelayedTaskList );
+			}
+
+			#if ( INCLUDE_vTaskDelete == 1 )
+			{
+				if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
+				{
+					uxTask += prvSnapshotTasksWithinList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, &xTasksWaitingTermination );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+				{
+					uxTask += prvSnapshotTasksWithinList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, &xSuspendedTaskList );
+				}
+			}
+			#endif
+
+			if( pulTotalRunTime != NULL )
+			{
+				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+					portALT_GET_RUN_TIME_COUNTER_VALUE( *pulTotalRunTime );
+				#else
+					*pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+				#endif
+			}
+		}
+		xTaskResumeAll();
+
+		return uxTask;
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
 	xTaskHandle xTaskGetIdleTaskHandle( void )
@@ -1636,6 +1891,52 @@ tskTCB * pxTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	void vTaskStepTick( portTickType xTicksToJump )
+	{
+		/* Correct the tick count after a period during which the tick
+		interrupt was suppressed.  The port never sleeps past the tick on which
+		the next task is due to unblock, and leaves that tick to the tick
+		interrupt, so no delayed tasks need to be checked here.  Note the tick
+		hook is not called for the stepped ticks. */
+		configASSERT( ( xTickCount + xTicksToJump ) < xNextTaskUnblockTime );
+		xTickCount += xTicksToJump;
+		traceINCREASE_TICK_COUNT( xTicksToJump );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	{
+	eSleepModeStatus eReturn = eStandardSleep;
+
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+		{
+			/* A task was made ready while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( xMissedYield != pdFALSE )
+		{
+			/* A yield was pended while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( uxMissedTicks != ( unsigned portBASE_TYPE ) 0U )
+		{
+			/* A tick arrived after the idle time was worked out, so the
+			idle time is now too long by that many ticks. */
+			eReturn = eAbortSleep;
+		}
+
+		return eReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_APPLICATION_TASK_TAG == 1 )
 
 	void vTaskSetApplicationTaskTag( xTaskHandle xTask, pdTASK_HOOK_CODE pxHookFunction )
@@ -1725,6 +2026,11 @@ tskTCB * pxTCB;
 
 void vTaskSwitchContext( void )
 {
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	tskTCB *pxPreviousTCB;
+	unsigned long ulTempCounter;
+#endif
+
 	if( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -1737,8 +2043,6 @@ void vTaskSwitchContext( void )
 	
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-			unsigned long ulTempCounter;
-			
 				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
 					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTempCounter );
 				#else
@@ -1752,6 +2056,16 @@ void vTaskSwitchContext( void )
 				this will be about 1 hour assuming a 1uS timer increment. */
 				pxCurrentTCB->ulRunTimeCounter += ( ulTempCounter - ulTaskSwitchedInTime );
 				ulTaskSwitchedInTime = ulTempCounter;
+
+				/* The same task may be selected again, in which case its run
+				carries on, so the longest run is updated with the run so far
+				rather than only when a different task is selected. */
+				if( ( ulTempCounter - ulTaskRunStartTime ) > pxCurrentTCB->ulLongestRun )
+				{
+					pxCurrentTCB->ulLongestRun = ulTempCounter - ulTaskRunStartTime;
+				}
+
+				pxPreviousTCB = pxCurrentTCB;
 		}
 		#endif
 	
@@ -1759,6 +2073,16 @@ void vTaskSwitchContext( void )
 		taskSECOND_CHECK_FOR_STACK_OVERFLOW();
 	
 		taskSELECT_HIGHEST_PRIORITY_TASK();
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			if( pxCurrentTCB != pxPreviousTCB )
+			{
+				( pxCurrentTCB->ulSwitchInCount )++;
+				ulTaskRunStartTime = ulTempCounter;
+			}
+		}
+		#endif
 			
 		traceTASK_SWITCHED_IN();
 	}
@@ -2055,6 +2379,37 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			vApplicationIdleHook();
 		}
 		#endif
+
+		#if ( configUSE_TICKLESS_IDLE == 1 )
+		{
+		portTickType xExpectedIdleTime;
+
+			/* Suspending and resuming the scheduler on every pass through the
+			idle loop would be wasteful, so the expected idle time is first
+			looked at with the scheduler running.  That result is only a
+			hint. */
+			xExpectedIdleTime = prvGetExpectedIdleTime();
+
+			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+			{
+				vTaskSuspendAll();
+				{
+					/* Now the scheduler is suspended the delayed lists cannot
+					change, so the expected idle time can be sampled again
+					and used. */
+					xExpectedIdleTime = prvGetExpectedIdleTime();
+
+					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					{
+						traceLOW_POWER_IDLE_BEGIN();
+						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+						traceLOW_POWER_IDLE_END();
+					}
+				}
+				xTaskResumeAll();
+			}
+		}
+		#endif
 	}
 } /*lint !e715 pvParameters is not accessed but all task functions require the same prototype. */
 
@@ -2121,6 +2476,15 @@ static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxTCB->ulRunTimeCounter = 0UL;
+		pxTCB->ulSwitchInCount = 0UL;
+		pxTCB->ulLongestRun = 0UL;
+	}
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->ucNotifyState = tskNOT_WAITING_NOTIFICATION;
 	}
 	#endif
 
@@ -2223,6 +2587,40 @@ static void prvCheckTasksWaitingTermination( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	static portTickType prvGetExpectedIdleTime( void )
+	{
+	portTickType xReturn;
+
+		if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+		{
+			xReturn = 0;
+		}
+		else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
+		{
+			/* There are other idle priority tasks in the Ready state.  If time
+			slicing is used then the very next tick interrupt must be
+			processed. */
+			xReturn = 0;
+		}
+		else if( xNextTaskUnblockTime <= xTickCount )
+		{
+			/* A delayed task is already due, so the next tick interrupt has
+			work to do. */
+			xReturn = 0;
+		}
+		else
+		{
+			xReturn = xNextTaskUnblockTime - xTickCount;
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 {
 	/* The list item will be inserted in wake time order. */
@@ -2249,36 +2647,46 @@ static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 }
 /*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
-{
-tskTCB *pxNewTCB;
-
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	if( pxNewTCB != NULL )
+	static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
 	{
-		/* Allocate space for the stack used by the task being created.
-		The base of the stack memory stored in the TCB so the task can
-		be deleted later if required. */
-		pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t )usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer );
+	tskTCB *pxNewTCB;
 
-		if( pxNewTCB->pxStack == NULL )
-		{
-			/* Could not allocate the stack.  Delete the allocated TCB. */
-			vPortFree( pxNewTCB );
-			pxNewTCB = NULL;
-		}
-		else
+		/* Allocate space for the TCB.  Where the memory comes from depends on
+		the implementation of the port malloc function. */
+		pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+
+		if( pxNewTCB != NULL )
 		{
-			/* Just to help debugging. */
-			memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+			/* Allocate space for the stack used by the task being created.
+			The base of the stack memory stored in the TCB so the task can
+			be deleted later if required. */
+			pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t )usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer );
+
+			if( pxNewTCB->pxStack == NULL )
+			{
+				/* Could not allocate the stack.  Delete the allocated TCB. */
+				vPortFree( pxNewTCB );
+				pxNewTCB = NULL;
+			}
+			else
+			{
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					pxNewTCB->ucStaticallyAllocated = ( puxStackBuffer == NULL ) ? tskDYNAMIC_TCB_AND_STACK : tskSTATIC_STACK_ONLY;
+				}
+				#endif
+
+				/* Just to help debugging. */
+				memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+			}
 		}
+
+		return pxNewTCB;
 	}
 
-	return pxNewTCB;
-}
+#endif
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -2384,6 +2792,66 @@ tskTCB *pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static void prvFillRunTimeStats( tskTCB *pxTCB, xTaskRunTimeStats *pxStats, unsigned long ulCounterValue )
+	{
+		pxStats->xHandle = ( xTaskHandle ) pxTCB;
+		pxStats->ulRunTime = pxTCB->ulRunTimeCounter;
+		pxStats->ulSwitchInCount = pxTCB->ulSwitchInCount;
+		pxStats->ulLongestRun = pxTCB->ulLongestRun;
+
+		/* The running task has not yet been charged for the time since it
+		was last switched in. */
+		if( pxTCB == pxCurrentTCB )
+		{
+			pxStats->ulRunTime += ulCounterValue - ulTaskSwitchedInTime;
+
+			if( ( ulCounterValue - ulTaskRunStartTime ) > pxStats->ulLongestRun )
+			{
+				pxStats->ulLongestRun = ulCounterValue - ulTaskRunStartTime;
+			}
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static unsigned portBASE_TYPE prvSnapshotTasksWithinList( xTaskRunTimeStats *pxStatsArray, unsigned portBASE_TYPE uxArraySize, xList *pxList )
+	{
+	tskTCB *pxNextTCB, *pxFirstTCB;
+	unsigned portBASE_TYPE uxTask = 0;
+	unsigned long ulCounterValue;
+
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulCounterValue );
+		#else
+			ulCounterValue = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		/* Write the run time stats of the TCB's in pxList into the array,
+		stopping when it is full. */
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+
+			if( uxTask < uxArraySize )
+			{
+				prvFillRunTimeStats( pxNextTCB, &( pxStatsArray[ uxTask ] ), ulCounterValue );
+				uxTask++;
+			}
+
+		} while( pxNextTCB != pxFirstTCB );
+
+		return uxTask;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
 
 	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
@@ -2443,8 +2911,30 @@ tskTCB *pxNewTCB;
 
 		/* Free up the memory allocated by the scheduler for the task.  It is up to
 		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
+		#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		{
+			/* Memory provided by the application is not freed. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMIC_TCB_AND_STACK )
+			{
+				vPortFreeAligned( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATIC_STACK_ONLY )
+			{
+				vPortFree( pxTCB );
+			}
+		}
+		#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			vPortFreeAligned( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#else
+		{
+			/* All the memory belongs to the application. */
+			( void ) pxTCB;
+		}
+		#endif
 	}
 
 #endif
@@ -2602,6 +3092,302 @@ void vTaskExitCritical( void )
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockForNotification( portTickType xTicksToWait )
+	{
+		/* The task is still running, so it must be taken out of its ready
+		list before it goes to the blocked or suspended list.  The yield is
+		held off until the caller leaves its critical section, and nothing can
+		notify this task before then. */
+		vListRemove( &( pxCurrentTCB->xGenericListItem ) );
+		taskCHECK_READY_LIST( pxCurrentTCB->uxPriority );
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Wait indefinitely, without a timeout. */
+				vListInsertEnd( ( xList * ) &xSuspendedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+			}
+		}
+		#else
+		{
+			prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+		}
+		#endif
+
+		portYIELD_WITHIN_API();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static portBASE_TYPE prvUpdateNotifiedValue( tskTCB *pxTCB, unsigned long ulValue, eNotifyAction eAction )
+	{
+	portBASE_TYPE xReturn = pdPASS;
+
+		switch( eAction )
+		{
+			case eSetBits :
+				pxTCB->ulNotifiedValue |= ulValue;
+				break;
+
+			case eIncrement :
+				( pxTCB->ulNotifiedValue )++;
+				break;
+
+			case eSetValueWithOverwrite :
+				pxTCB->ulNotifiedValue = ulValue;
+				break;
+
+			case eSetValueWithoutOverwrite :
+				/* Only write the value if the task has consumed the last
+				one. */
+				if( pxTCB->ucNotifyState != tskNOTIFICATION_RECEIVED )
+				{
+					pxTCB->ulNotifiedValue = ulValue;
+				}
+				else
+				{
+					xReturn = pdFAIL;
+				}
+				break;
+
+			case eNoAction :
+			default :
+				break;
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	unsigned long ulReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			{
+				pxCurrentTCB->ucNotifyState = tskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					traceTASK_NOTIFY_TAKE_BLOCK();
+					prvBlockForNotification( xTicksToWait );
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* The task is running again, because it was notified, timed out, or
+		was resumed. */
+		taskENTER_CRITICAL();
+		{
+			ulReturn = pxCurrentTCB->ulNotifiedValue;
+
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue = 0UL;
+				}
+				else
+				{
+					pxCurrentTCB->ulNotifiedValue = ulReturn - 1UL;
+				}
+			}
+
+			pxCurrentTCB->ucNotifyState = tskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState != tskNOTIFICATION_RECEIVED )
+			{
+				/* Bits are only cleared on entry if no notification was
+				pending, so a value that was sent before the call is not
+				lost. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ucNotifyState = tskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					traceTASK_NOTIFY_WAIT_BLOCK();
+					prvBlockForNotification( xTicksToWait );
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the value before any bits are cleared. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+			}
 
+			if( pxCurrentTCB->ucNotifyState == tskNOTIFICATION_RECEIVED )
+			{
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				/* Timed out, or was resumed, without being notified. */
+				xReturn = pdFALSE;
+			}
+
+			pxCurrentTCB->ucNotifyState = tskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xReturn;
+	unsigned char ucOriginalNotifyState;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		taskENTER_CRITICAL();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			xReturn = prvUpdateNotifiedValue( pxTCB, ulValue, eAction );
+			pxTCB->ucNotifyState = tskNOTIFICATION_RECEIVED;
+
+			traceTASK_NOTIFY( pxTCB );
+
+			/* If the task was blocked waiting for a notification it can be
+			made ready now.  As we are in a critical section we can access the
+			ready lists even if the scheduler is suspended. */
+			if( ucOriginalNotifyState == tskWAITING_NOTIFICATION )
+			{
+				vListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyQueue( pxTCB );
+
+				/* A task waiting for a notification is not on an event
+				list. */
+				configASSERT( pxTCB->xEventListItem.pvContainer == NULL );
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xReturn;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			xReturn = prvUpdateNotifiedValue( pxTCB, ulValue, eAction );
+			pxTCB->ucNotifyState = tskNOTIFICATION_RECEIVED;
+
+			traceTASK_NOTIFY_FROM_ISR( pxTCB );
+
+			if( ucOriginalNotifyState == tskWAITING_NOTIFICATION )
+			{
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					vListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyQueue( pxTCB );
+				}
+				else
+				{
+					/* We cannot access the delayed or ready lists, so hold the
+					task pending until the scheduler is resumed.  The event
+					list item is free, as a task waiting for a notification is
+					not on an event list. */
+					vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		( void ) xTaskGenericNotifyFromISR( xTaskToNotify, 0UL, eIncrement, NULL, pxHigherPriorityTaskWoken );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
 
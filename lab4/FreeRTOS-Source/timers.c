@@ -94,8 +94,19 @@ typedef struct tmrTimerControl
 	unsigned portBASE_TYPE	uxAutoReload;		/*<< Set to pdTRUE if the timer should be automatically restarted once expired.  Set to pdFALSE if the timer is, in effect, a one shot timer. */
 	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
 	tmrTIMER_CALLBACK		pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char		ucStaticallyAllocated;	/*<< Set to pdTRUE if the memory of the timer came from the application, so it is not freed when the timer is deleted. */
+	#endif
 } xTIMER;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* xStaticTimer must be the same size as the timer it stands in for.  This
+	will not compile if a member is added to one and not the other. */
+	typedef char tmrSTATIC_TIMER_SIZE_CHECK[ ( sizeof( xStaticTimer ) == sizeof( xTIMER ) ) ? 1 : -1 ];
+
+#endif
+
 /* The definition of messages that can be sent and received on the timer
 queue. */
 typedef struct tmrTimerQueueMessage
@@ -106,13 +117,51 @@ typedef struct tmrTimerQueueMessage
 } xTIMER_MESSAGE;
 
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access xActiveTimerList. */
-PRIVILEGED_DATA static xList xActiveTimerList1;
-PRIVILEGED_DATA static xList xActiveTimerList2;
-PRIVILEGED_DATA static xList *pxCurrentTimerList;
-PRIVILEGED_DATA static xList *pxOverflowTimerList;
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access xActiveTimerList. */
+	PRIVILEGED_DATA static xList xActiveTimerList1;
+	PRIVILEGED_DATA static xList xActiveTimerList2;
+	PRIVILEGED_DATA static xList *pxCurrentTimerList;
+	PRIVILEGED_DATA static xList *pxOverflowTimerList;
+
+	/* Used by prvProcessTimerOrBlockTask() to decide if the next timer is
+	due. */
+	#define tmrTIMER_HAS_EXPIRED( xExpireTime, xTimeNow )	( ( xExpireTime ) <= ( xTimeNow ) )
+
+#else
+
+	/* A hashed timing wheel.  Active timers are kept, unsorted, in the slot
+	for their expiry time modulo configTIMER_WHEEL_SIZE, so a timer is started
+	or stopped in constant time whatever the number of active timers.  Timers
+	due more than a turn of the wheel away share a slot with nearer ones, and
+	are told apart by the expiry time held in their list item.  Times are
+	compared relative to xWheelTime, so a tick count overflow needs no
+	special handling.  Only the timer service task is allowed to access the
+	wheel. */
+	PRIVILEGED_DATA static xList xTimerWheel[ configTIMER_WHEEL_SIZE ];
+
+	/* Timers due up to and including xWheelTime have been processed, so every
+	active timer expires after it. */
+	PRIVILEGED_DATA static portTickType xWheelTime = ( portTickType ) 0U;
+
+	/* No active timer expires before xWheelNextExpireTime.  It can be early,
+	if the timer that was due then has since been stopped, in which case the
+	timer service task just wakes up for nothing. */
+	PRIVILEGED_DATA static portTickType xWheelNextExpireTime = ( portTickType ) 0U;
+
+	/* The number of timers in the wheel. */
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxActiveTimers = ( unsigned portBASE_TYPE ) 0U;
+
+	#define tmrWHEEL_MASK		( ( portTickType ) configTIMER_WHEEL_SIZE - ( portTickType ) 1U )
+
+	/* Used by prvProcessTimerOrBlockTask() to decide if the next timer is
+	due. */
+	#define tmrTIMER_HAS_EXPIRED( xExpireTime, xTimeNow )	( ( portTickType ) ( ( xTimeNow ) - xWheelTime ) >= ( portTickType ) ( ( xExpireTime ) - xWheelTime ) )
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
@@ -131,6 +180,12 @@ PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
  */
 static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by xTimerCreate() and xTimerCreateStatic() once the memory for the
+ * timer has been obtained.
+ */
+static void prvInitialiseNewTimer( xTIMER *pxNewTimer, const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
+
 /*
  * The timer service task (daemon).  Timer functionality is controlled by this
  * task.  Other tasks communicate with the timer service task using the
@@ -145,22 +200,54 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
 static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * Apply a single command received on the timer queue.
  */
-static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
+static void prvProcessCommand( const xTIMER_MESSAGE *pxMessage, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
+ * depending on if the expire time causes a timer counter overflow (or into
+ * the timer wheel).  Returns pdTRUE, without inserting the timer, if the
+ * expire time has already passed.
  */
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
 
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is
+	 * an auto reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * Put the timer in the wheel slot for xExpiryTime, which must be after
+	 * xWheelTime.
+	 */
+	static void prvInsertTimerInWheel( xTIMER *pxTimer, portTickType xExpiryTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Process every timer that is due up to and including xTimeNow, a tick at
+	 * a time, calling the callbacks of all the timers due on a tick in one pass
+	 * over its slot.
+	 */
+	static void prvProcessExpiredTimers( portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Find the earliest expire time of the timers in the wheel, which must
+	 * not be empty.
+	 */
+	static portTickType prvFindNextExpireTime( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -196,7 +283,26 @@ portBASE_TYPE xReturn = pdFAIL;
 
 	if( xTimerQueue != NULL )
 	{
-		#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+		xStaticTask *pxTimerTaskTCBBuffer = NULL;
+		portSTACK_TYPE *pxTimerTaskStackBuffer = NULL;
+		unsigned short usTimerTaskStackSize;
+
+			/* The memory for the timer task comes from the application. */
+			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &usTimerTaskStackSize );
+
+			#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+			{
+				xReturn = xTaskCreateStatic( prvTimerTask, ( const signed char * ) "Tmr Svc", usTimerTaskStackSize, NULL, ( ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT, &xTimerTaskHandle, pxTimerTaskStackBuffer, pxTimerTaskTCBBuffer );
+			}
+			#else
+			{
+				xReturn = xTaskCreateStatic( prvTimerTask, ( const signed char * ) "Tmr Svc", usTimerTaskStackSize, NULL, ( ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT, NULL, pxTimerTaskStackBuffer, pxTimerTaskTCBBuffer );
+			}
+			#endif
+		}
+		#elif ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
 		{
 			/* Create the timer task, storing its handle in xTimerTaskHandle so
 			it can be returned by the xTimerGetTimerDaemonTaskHandle() function. */
@@ -215,43 +321,82 @@ portBASE_TYPE xReturn = pdFAIL;
 }
 /*-----------------------------------------------------------*/
 
-xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
+static void prvInitialiseNewTimer( xTIMER *pxNewTimer, const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
 {
-xTIMER *pxNewTimer;
+	/* Ensure the infrastructure used by the timer service task has been
+	created/initialised. */
+	prvCheckForValidListAndQueue();
 
-	/* Allocate the timer structure. */
-	if( xTimerPeriodInTicks == ( portTickType ) 0U )
-	{
-		pxNewTimer = NULL;
-		configASSERT( ( xTimerPeriodInTicks > 0 ) );
-	}
-	else
+	/* Initialise the timer structure members using the function parameters. */
+	pxNewTimer->pcTimerName = pcTimerName;
+	pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+	pxNewTimer->uxAutoReload = uxAutoReload;
+	pxNewTimer->pvTimerID = pvTimerID;
+	pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+	vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+
+	traceTIMER_CREATE( pxNewTimer );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
 	{
-		pxNewTimer = ( xTIMER * ) pvPortMalloc( sizeof( xTIMER ) );
-		if( pxNewTimer != NULL )
+	xTIMER *pxNewTimer;
+
+		/* Allocate the timer structure. */
+		if( xTimerPeriodInTicks == ( portTickType ) 0U )
 		{
-			/* Ensure the infrastructure used by the timer service task has been
-			created/initialised. */
-			prvCheckForValidListAndQueue();
-	
-			/* Initialise the timer structure members using the function parameters. */
-			pxNewTimer->pcTimerName = pcTimerName;
-			pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
-			pxNewTimer->uxAutoReload = uxAutoReload;
-			pxNewTimer->pvTimerID = pvTimerID;
-			pxNewTimer->pxCallbackFunction = pxCallbackFunction;
-			vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
-			
-			traceTIMER_CREATE( pxNewTimer );
+			pxNewTimer = NULL;
+			configASSERT( ( xTimerPeriodInTicks > 0 ) );
 		}
 		else
 		{
-			traceTIMER_CREATE_FAILED();
+			pxNewTimer = ( xTIMER * ) pvPortMalloc( sizeof( xTIMER ) );
+			if( pxNewTimer != NULL )
+			{
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					pxNewTimer->ucStaticallyAllocated = pdFALSE;
+				}
+				#endif
+
+				prvInitialiseNewTimer( pxNewTimer, pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
+			}
+			else
+			{
+				traceTIMER_CREATE_FAILED();
+			}
 		}
+
+		return ( xTimerHandle ) pxNewTimer;
 	}
-	
-	return ( xTimerHandle ) pxNewTimer;
-}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTimerHandle xTimerCreateStatic( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer )
+	{
+	xTIMER *pxNewTimer = ( xTIMER * ) pxTimerBuffer;
+
+		configASSERT( ( xTimerPeriodInTicks > 0 ) );
+		configASSERT( pxTimerBuffer );
+
+		#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			pxNewTimer->ucStaticallyAllocated = pdTRUE;
+		}
+		#endif
+
+		prvInitialiseNewTimer( pxNewTimer, pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
+
+		return ( xTimerHandle ) pxNewTimer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime )
@@ -304,40 +449,164 @@ xTIMER_MESSAGE xMessage;
 #endif
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
-{
-xTIMER *pxTimer;
-portBASE_TYPE xResult;
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
+	{
+	xTIMER *pxTimer;
+	portBASE_TYPE xResult;
+
+		/* Remove the timer from the list of active timers.  A check has already
+		been performed to ensure the list is not empty. */
+		pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+		vListRemove( &( pxTimer->xTimerListItem ) );
+		traceTIMER_EXPIRED( pxTimer );
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-	vListRemove( &( pxTimer->xTimerListItem ) );
-	traceTIMER_EXPIRED( pxTimer );
+		/* If the timer is an auto reload timer then calculate the next
+		expiry time and re-insert the timer in the list of active timers. */
+		if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+		{
+			/* This is the only time a timer is inserted into a list using
+			a time relative to anything other than the current time.  It
+			will therefore be inserted into the correct list relative to
+			the time this task thinks it is now, even if a command to
+			switch lists due to a tick count overflow is already waiting in
+			the timer queue. */
+			if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
+			{
+				/* The timer expired before it was added to the active timer
+				list.  Reload it now.  */
+				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
+				configASSERT( xResult );
+				( void ) xResult;
+			}
+		}
 
-	/* If the timer is an auto reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
-	if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+		/* Call the timer callback. */
+		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvInsertTimerInWheel( xTIMER *pxTimer, portTickType xExpiryTime )
 	{
-		/* This is the only time a timer is inserted into a list using
-		a time relative to anything other than the current time.  It
-		will therefore be inserted into the correct list relative to
-		the time this task thinks it is now, even if a command to
-		switch lists due to a tick count overflow is already waiting in
-		the timer queue. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
+		listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+		listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+		vListInsertEnd( &( xTimerWheel[ xExpiryTime & tmrWHEEL_MASK ] ), &( pxTimer->xTimerListItem ) );
+
+		if( ( uxActiveTimers == ( unsigned portBASE_TYPE ) 0U ) || ( ( portTickType ) ( xExpiryTime - xWheelTime ) < ( portTickType ) ( xWheelNextExpireTime - xWheelTime ) ) )
 		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
+			xWheelNextExpireTime = xExpiryTime;
 		}
+
+		( uxActiveTimers )++;
 	}
 
-	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
-}
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvProcessExpiredTimers( portTickType xTimeNow )
+	{
+	xList *pxSlot;
+	volatile xListItem *pxItem, *pxNextItem;
+	xTIMER *pxTimer;
+
+		while( ( uxActiveTimers > ( unsigned portBASE_TYPE ) 0U ) && ( tmrTIMER_HAS_EXPIRED( xWheelNextExpireTime, xTimeNow ) != pdFALSE ) )
+		{
+			/* Nothing expires between xWheelTime and xWheelNextExpireTime, so
+			the wheel can skip straight to it rather than look at the slots
+			in between. */
+			xWheelTime = xWheelNextExpireTime;
+			pxSlot = &( xTimerWheel[ xWheelTime & tmrWHEEL_MASK ] );
+
+			/* Call back every timer in the slot that is due now.  The others
+			are a turn or more of the wheel away.  The timer is removed
+			before its callback is called, and a reloaded timer is due at
+			least a tick later, so it is not called again in this pass even
+			if it goes back into the same slot. */
+			pxItem = pxSlot->xListEnd.pxNext;
+			while( pxItem != ( volatile xListItem * ) &( pxSlot->xListEnd ) )
+			{
+				pxNextItem = pxItem->pxNext;
+
+				if( listGET_LIST_ITEM_VALUE( pxItem ) == xWheelTime )
+				{
+					pxTimer = ( xTIMER * ) listGET_LIST_ITEM_OWNER( pxItem );
+					vListRemove( &( pxTimer->xTimerListItem ) );
+					( uxActiveTimers )--;
+					traceTIMER_EXPIRED( pxTimer );
+
+					/* A reload that is already due (the period is shorter
+					than the time the task fell behind by) is picked up later
+					in this call, as it is after xWheelTime. */
+					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+					{
+						prvInsertTimerInWheel( pxTimer, xWheelTime + pxTimer->xTimerPeriodInTicks );
+					}
+
+					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+				}
+
+				pxItem = pxNextItem;
+			}
+
+			if( uxActiveTimers > ( unsigned portBASE_TYPE ) 0U )
+			{
+				xWheelNextExpireTime = prvFindNextExpireTime();
+			}
+		}
+
+		/* Everything due up to now has been processed. */
+		xWheelTime = xTimeNow;
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	static portTickType prvFindNextExpireTime( void )
+	{
+	portTickType xTicksAway, xNearest = portMAX_DELAY, xSlotTime;
+	unsigned portBASE_TYPE uxSlot;
+	xList *pxSlot;
+	volatile xListItem *pxItem;
+
+		/* Look at the slots in expiry order, starting with the tick after
+		xWheelTime.  A timer in a slot is due on the slot's tick in this turn
+		of the wheel, or a whole turn or more later.  The first timer found
+		that is due in this turn is therefore the next to expire.  If there is
+		none, every timer has been looked at, and the nearest is kept. */
+		for( uxSlot = ( unsigned portBASE_TYPE ) 1U; uxSlot <= ( unsigned portBASE_TYPE ) configTIMER_WHEEL_SIZE; uxSlot++ )
+		{
+			xSlotTime = xWheelTime + ( portTickType ) uxSlot;
+			pxSlot = &( xTimerWheel[ xSlotTime & tmrWHEEL_MASK ] );
+
+			for( pxItem = pxSlot->xListEnd.pxNext; pxItem != ( volatile xListItem * ) &( pxSlot->xListEnd ); pxItem = pxItem->pxNext )
+			{
+				xTicksAway = listGET_LIST_ITEM_VALUE( pxItem ) - xWheelTime;
+
+				if( xTicksAway == ( portTickType ) uxSlot )
+				{
+					return xSlotTime;
+				}
+
+				if( xTicksAway < xNearest )
+				{
+					xNearest = xTicksAway;
+				}
+			}
+		}
+
+		return xWheelTime + xNearest;
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvTimerTask( void *pvParameters )
@@ -380,10 +649,19 @@ portBASE_TYPE xTimerListsWereSwitched;
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
 			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			if( ( xListWasEmpty == pdFALSE ) && ( tmrTIMER_HAS_EXPIRED( xNextExpireTime, xTimeNow ) != pdFALSE ) )
 			{
 				xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+
+				#if ( configUSE_TIMER_WHEEL == 0 )
+				{
+					prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				}
+				#else
+				{
+					prvProcessExpiredTimers( xTimeNow );
+				}
+				#endif
 			}
 			else
 			{
@@ -424,10 +702,27 @@ portTickType xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+	#if ( configUSE_TIMER_WHEEL == 0 )
+	{
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+	}
+	#else
+	{
+		*pxListWasEmpty = ( uxActiveTimers == ( unsigned portBASE_TYPE ) 0U );
+	}
+	#endif
+
 	if( *pxListWasEmpty == pdFALSE )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		#if ( configUSE_TIMER_WHEEL == 0 )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		#else
+		{
+			xNextExpireTime = xWheelNextExpireTime;
+		}
+		#endif
 	}
 	else
 	{
@@ -442,195 +737,276 @@ portTickType xNextExpireTime;
 static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
 {
 portTickType xTimeNow;
-PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U;
 
 	xTimeNow = xTaskGetTickCount();
 	
-	if( xTimeNow < xLastTime )
+	#if ( configUSE_TIMER_WHEEL == 0 )
 	{
-		prvSwitchTimerLists( xLastTime );
-		*pxTimerListsWereSwitched = pdTRUE;
+	PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U;
+
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists( xLastTime );
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
+
+		xLastTime = xTimeNow;
 	}
-	else
+	#else
 	{
+		/* The wheel works on times relative to xWheelTime, so there are no
+		lists to switch when the tick count overflows. */
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
-	
-	xLastTime = xTimeNow;
+	#endif
 	
 	return xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
-static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
-{
-portBASE_TYPE xProcessTimerNow = pdFALSE;
+#if ( configUSE_TIMER_WHEEL == 0 )
 
-	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-	
-	if( xNextExpiryTime <= xTimeNow )
+	static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
 	{
-		/* Has the expiry time elapsed between the command to start/reset a
-		timer was issued, and the time the command was processed? */
-		if( ( ( portTickType ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks )
+	portBASE_TYPE xProcessTimerNow = pdFALSE;
+
+		listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+		listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+	
+		if( xNextExpiryTime <= xTimeNow )
 		{
-			/* The time between a command being issued and the command being
-			processed actually exceeds the timers period.  */
-			xProcessTimerNow = pdTRUE;
+			/* Has the expiry time elapsed between the command to start/reset a
+			timer was issued, and the time the command was processed? */
+			if( ( ( portTickType ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks )
+			{
+				/* The time between a command being issued and the command being
+				processed actually exceeds the timers period.  */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+			{
+				/* If, since the command was issued, the tick count has overflowed
+				but the expiry time has not, then the timer must have already passed
+				its expiry time and should be processed immediately. */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
+
+		return xProcessTimerNow;
 	}
-	else
+
+#else
+
+	static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
 	{
-		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+	portBASE_TYPE xProcessTimerNow = pdFALSE;
+
+		/* Has the expiry time passed between the command to start/reset the
+		timer being issued and the command being processed?  Both times are
+		taken relative to the command time, so this also holds if the tick
+		count has overflowed in between. */
+		if( ( portTickType ) ( xNextExpiryTime - xCommandTime ) <= ( portTickType ) ( xTimeNow - xCommandTime ) )
 		{
-			/* If, since the command was issued, the tick count has overflowed
-			but the expiry time has not, then the timer must have already passed
-			its expiry time and should be processed immediately. */
 			xProcessTimerNow = pdTRUE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			/* With no timers in the wheel the task does not keep xWheelTime
+			up to date, so bring it up to now. */
+			if( uxActiveTimers == ( unsigned portBASE_TYPE ) 0U )
+			{
+				xWheelTime = xTimeNow;
+			}
+
+			prvInsertTimerInWheel( pxTimer, xNextExpiryTime );
 		}
+
+		return xProcessTimerNow;
 	}
 
-	return xProcessTimerNow;
-}
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void	prvProcessReceivedCommands( void )
 {
-xTIMER_MESSAGE xMessage;
-xTIMER *pxTimer;
-portBASE_TYPE xTimerListsWereSwitched, xResult;
+xTIMER_MESSAGE xMessages[ configTIMER_COMMAND_BATCH ];
+unsigned portBASE_TYPE uxMessage, uxMessages;
+portBASE_TYPE xTimerListsWereSwitched;
 portTickType xTimeNow;
 
 	/* In this case the xTimerListsWereSwitched parameter is not used, but it
 	must be present in the function call. */
 	xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+	/* Take the commands off the queue up to configTIMER_COMMAND_BATCH at a
+	time, so a burst of commands costs one queue access per batch rather than
+	one per command. */
+	while( ( uxMessages = uxQueueReceiveBatchRestricted( xTimerQueue, xMessages, ( unsigned portBASE_TYPE ) configTIMER_COMMAND_BATCH ) ) != ( unsigned portBASE_TYPE ) 0U )
 	{
-		pxTimer = xMessage.pxTimer;
+		for( uxMessage = ( unsigned portBASE_TYPE ) 0U; uxMessage < uxMessages; uxMessage++ )
+		{
+			prvProcessCommand( &( xMessages[ uxMessage ] ), xTimeNow );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessCommand( const xTIMER_MESSAGE *pxMessage, portTickType xTimeNow )
+{
+xTIMER *pxTimer;
+portBASE_TYPE xResult;
 
-		/* Is the timer already in a list of active timers?  When the command
-		is trmCOMMAND_PROCESS_TIMER_OVERFLOW, the timer will be NULL as the
-		command is to the task rather than to an individual timer. */
-		if( pxTimer != NULL )
+	pxTimer = pxMessage->pxTimer;
+
+	/* Is the timer already in a list of active timers?  When the command
+	is trmCOMMAND_PROCESS_TIMER_OVERFLOW, the timer will be NULL as the
+	command is to the task rather than to an individual timer. */
+	if( pxTimer != NULL )
+	{
+		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
 		{
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+			/* The timer is in a list, remove it. */
+			vListRemove( &( pxTimer->xTimerListItem ) );
+
+			#if ( configUSE_TIMER_WHEEL == 1 )
 			{
-				/* The timer is in a list, remove it. */
-				vListRemove( &( pxTimer->xTimerListItem ) );
+				( uxActiveTimers )--;
 			}
+			#endif
 		}
+	}
 
-		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
-		
-		switch( xMessage.xMessageID )
-		{
-			case tmrCOMMAND_START :	
-				/* Start or restart a timer. */
-				if( prvInsertTimerInActiveList( pxTimer,  xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.xMessageValue ) == pdTRUE )
-				{
-					/* The timer expired before it was added to the active timer
-					list.  Process it now. */
-					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+	traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->xMessageValue );
+	
+	switch( pxMessage->xMessageID )
+	{
+		case tmrCOMMAND_START :	
+			/* Start or restart a timer. */
+			if( prvInsertTimerInActiveList( pxTimer,  pxMessage->xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->xMessageValue ) == pdTRUE )
+			{
+				/* The timer expired before it was added to the active timer
+				list.  Process it now. */
+				pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
 
-					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
-					{
-						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-						configASSERT( xResult );
-						( void ) xResult;
-					}
+				if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, pxMessage->xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+			}
+			break;
+
+		case tmrCOMMAND_STOP :	
+			/* The timer has already been removed from the active list.
+			There is nothing to do here. */
+			break;
+
+		case tmrCOMMAND_CHANGE_PERIOD :
+			pxTimer->xTimerPeriodInTicks = pxMessage->xMessageValue;
+			configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+			prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+			break;
+
+		case tmrCOMMAND_DELETE :
+			/* The timer has already been removed from the active list,
+			just free up the memory, unless the application provided
+			it. */
+			#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+			{
+				if( pxTimer->ucStaticallyAllocated == pdFALSE )
+				{
+					vPortFree( pxTimer );
 				}
-				break;
-
-			case tmrCOMMAND_STOP :	
-				/* The timer has already been removed from the active list.
-				There is nothing to do here. */
-				break;
-
-			case tmrCOMMAND_CHANGE_PERIOD :
-				pxTimer->xTimerPeriodInTicks = xMessage.xMessageValue;
-				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-				prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-				break;
-
-			case tmrCOMMAND_DELETE :
-				/* The timer has already been removed from the active list,
-				just free up the memory. */
+			}
+			#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
 				vPortFree( pxTimer );
-				break;
+			}
+			#endif
+			break;
 
-			default	:			
-				/* Don't expect to get here. */
-				break;
-		}
+		default	:			
+			/* Don't expect to get here. */
+			break;
 	}
 }
 /*-----------------------------------------------------------*/
 
-static void prvSwitchTimerLists( portTickType xLastTime )
-{
-portTickType xNextExpireTime, xReloadTime;
-xList *pxTemp;
-xTIMER *pxTimer;
-portBASE_TYPE xResult;
+#if ( configUSE_TIMER_WHEEL == 0 )
 
-	/* Remove compiler warnings if configASSERT() is not defined. */
-	( void ) xLastTime;
-	
-	/* The tick count has overflowed.  The timer lists must be switched.
-	If there are any timers still referenced from the current timer list
-	then they must have expired and should be processed before the lists
-	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	static void prvSwitchTimerLists( portTickType xLastTime )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	portTickType xNextExpireTime, xReloadTime;
+	xList *pxTemp;
+	xTIMER *pxTimer;
+	portBASE_TYPE xResult;
 
-		/* Remove the timer from the list. */
-		pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-		vListRemove( &( pxTimer->xTimerListItem ) );
+		/* Remove compiler warnings if configASSERT() is not defined. */
+		( void ) xLastTime;
+	
+		/* The tick count has overflowed.  The timer lists must be switched.
+		If there are any timers still referenced from the current timer list
+		then they must have expired and should be processed before the lists
+		are switched. */
+		while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-		/* Execute its callback, then send a command to restart the timer if
-		it is an auto-reload timer.  It cannot be restarted here as the lists
-		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+			/* Remove the timer from the list. */
+			pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+			vListRemove( &( pxTimer->xTimerListItem ) );
 
-		if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
-		{
-			/* Calculate the reload value, and if the reload value results in
-			the timer going into the same timer list then it has already expired
-			and the timer should be re-inserted into the current list so it is
-			processed again within this loop.  Otherwise a command should be sent
-			to restart the timer to ensure it is only inserted into a list after
-			the lists have been swapped. */
-			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-			if( xReloadTime > xNextExpireTime )
-			{
-				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
-			}
-			else
+			/* Execute its callback, then send a command to restart the timer if
+			it is an auto-reload timer.  It cannot be restarted here as the lists
+			have not yet been switched. */
+			pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+
+			if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
 			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
-				configASSERT( xResult );
-				( void ) xResult;
+				/* Calculate the reload value, and if the reload value results in
+				the timer going into the same timer list then it has already expired
+				and the timer should be re-inserted into the current list so it is
+				processed again within this loop.  Otherwise a command should be sent
+				to restart the timer to ensure it is only inserted into a list after
+				the lists have been swapped. */
+				xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+				if( xReloadTime > xNextExpireTime )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				}
+				else
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
 			}
 		}
+
+		pxTemp = pxCurrentTimerList;
+		pxCurrentTimerList = pxOverflowTimerList;
+		pxOverflowTimerList = pxTemp;
 	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
-}
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -642,11 +1018,38 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
-			xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			#if ( configUSE_TIMER_WHEEL == 0 )
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#else
+			{
+			unsigned portBASE_TYPE uxSlot;
+
+				for( uxSlot = ( unsigned portBASE_TYPE ) 0U; uxSlot < ( unsigned portBASE_TYPE ) configTIMER_WHEEL_SIZE; uxSlot++ )
+				{
+					vListInitialise( &( xTimerWheel[ uxSlot ] ) );
+				}
+			}
+			#endif
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+			/* The timer queue is created once, so its memory can be
+			allocated statically here. */
+			static xStaticQueue xStaticTimerQueue;
+			static xTIMER_MESSAGE xTimerQueueStorage[ configTIMER_QUEUE_LENGTH ];
+
+				xTimerQueue = xQueueCreateStatic( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ), ( unsigned char * ) xTimerQueueStorage, &xStaticTimerQueue );
+			}
+			#else
+			{
+				xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			}
+			#endif
 		}
 	}
 	taskEXIT_CRITICAL();
@@ -67,12 +67,18 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION			1
-#define configUSE_IDLE_HOOK				0
+#define configUSE_IDLE_HOOK				1
 #define configUSE_TICK_HOOK				0
+#define configUSE_TICKLESS_IDLE			1 /* Stop the SysTick while the idle task runs and there is nothing due, rather than take an interrupt every millisecond. */
 #define configCPU_CLOCK_HZ				( ( unsigned long ) 12000000 )
 #define configTICK_RATE_HZ				( ( portTickType ) 1000 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 70 )
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 2048 ) )
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 2560 ) )
+#define configHEAP_POOLS				{ { 80, 6 }, { configMINIMAL_STACK_SIZE * sizeof( portSTACK_TYPE ), 5 } } /* heap_tlsf.c pools as { block size, blocks }, smallest first: TCBs and queues, then minimal stacks. */
+#define configSUPPORT_STATIC_ALLOCATION	1 /* Kernel objects are created in memory given by the application (xTaskCreateStatic() etc.). */
+#define configSUPPORT_DYNAMIC_ALLOCATION	0 /* No heap, so all RAM use is known at link time. Set to 1 to use heap_tlsf.c. */
+#define configUSE_BLOCK_POOLS			1 /* Fixed size block pools and pointer queues, to pass large items without copying them. */
+#define configUSE_TASK_NOTIFICATIONS	1 /* Direct-to-task notifications, a lighter way to signal a task than a semaphore. */
 #define configMAX_TASK_NAME_LEN			( 12 )
 #define configUSE_TRACE_FACILITY		1 /* This is set to one so each task is given a unique number, which is then used to generate the logic analyzer output. */
 #define configUSE_16_BIT_TICKS			0
@@ -81,6 +87,7 @@
 #define configUSE_MUTEXES				0
 #define configUSE_RECURSIVE_MUTEXES		0
 #define configCHECK_FOR_STACK_OVERFLOW	0
+#define configGENERATE_RUN_TIME_STATS	1 /* Charge each task for the CPU cycles it runs for, counted by the DWT cycle counter (see below). */
 
 #define configMAX_PRIORITIES			( 5 )
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
@@ -91,7 +98,7 @@ to exclude the API function. */
 
 #define INCLUDE_vTaskPrioritySet			0
 #define INCLUDE_uxTaskPriorityGet			0
-#define INCLUDE_vTaskDelete					0
+#define INCLUDE_vTaskDelete					1
 #define INCLUDE_vTaskCleanUpResources		0
 #define INCLUDE_vTaskSuspend				1
 #define INCLUDE_vTaskDelayUntil				1
@@ -114,6 +121,18 @@ extern unsigned long ulTaskNumber[];
 #define traceTASK_SWITCHED_IN() 	ulTaskNumber[ pxCurrentTCB->uxTCBNumber ] = 1
 #define traceTASK_SWITCHED_OUT() 	ulTaskNumber[ pxCurrentTCB->uxTCBNumber ] = 0
 
+/* The run time stats time base is the DWT cycle counter, so task run times are
+in CPU cycles.  It is a 32 bit count, so it wraps every 2^32 / configCPU_CLOCK_HZ
+seconds (about 6 minutes at 12 MHz); the run time of a task is only valid until
+then, but the time between two readings is valid as long as it is shorter. */
+#define configDEMCR							( *( ( volatile unsigned long * ) 0xE000EDFC ) )
+#define configDEMCR_TRCENA					0x01000000
+#define configDWT_CTRL						( *( ( volatile unsigned long * ) 0xE0001000 ) )
+#define configDWT_CTRL_CYCCNTENA			0x00000001
+#define configDWT_CYCCNT					( *( ( volatile unsigned long * ) 0xE0001004 ) )
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	do { configDEMCR |= configDEMCR_TRCENA; configDWT_CTRL |= configDWT_CTRL_CYCCNTENA; } while( 0 )
+#define portGET_RUN_TIME_COUNTER_VALUE()			configDWT_CYCCNT
+
 /*
  * Use the Cortex-M3 optimisations, rather than the generic C implementation.
  */
@@ -0,0 +1,449 @@
+#include "edf_admission.h"
+
+/*
+ * NAME:          task_count
+ *
+ * DESCRIPTION:   Number of tasks the analysis looks at: the admitted set, plus
+ *                the candidate task if there is one.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *candidate
+ *    - The task being tested, or 0.
+ *
+ * RETURNS:
+ *  unsigned int
+ *    - Number of tasks.
+ */
+static unsigned int task_count( struct edf_admission *admission, const struct edf_task_params *candidate )
+{
+	return admission->num_tasks + ( candidate ? 1 : 0 );
+}
+
+/*
+ * NAME:          task_at
+ *
+ * DESCRIPTION:   Get a task from the admitted set, or the candidate task for
+ *                the index just past the end, so the analysis can treat the
+ *                candidate as part of the set without copying it in.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *candidate
+ *    - The task being tested.
+ *  unsigned int i
+ *    - Index (0 to num_tasks inclusive).
+ *
+ * RETURNS:
+ *  const struct edf_task_params *
+ *    - The task.
+ */
+static const struct edf_task_params *task_at( struct edf_admission *admission, const struct edf_task_params *candidate, unsigned int i )
+{
+	return ( i < admission->num_tasks ) ? &admission->tasks[ i ] : candidate;
+}
+
+/*
+ * NAME:          resource_at
+ *
+ * DESCRIPTION:   Get the critical section and ceiling of a task, as they
+ *                would be with a new resource use applied.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *candidate
+ *    - The task being tested, or 0.
+ *  const struct edf_resource_use *use
+ *    - The resource use being tested, or 0.
+ *  unsigned int i
+ *    - Index of the task.
+ *  unsigned long *critical_section
+ *  unsigned long *ceiling
+ *    - Where to store the results.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void resource_at( struct edf_admission *admission, const struct edf_task_params *candidate, const struct edf_resource_use *use,
+                         unsigned int i, unsigned long *critical_section, unsigned long *ceiling )
+{
+	const struct edf_task_params *task = task_at( admission, candidate, i );
+
+	*critical_section = task->critical_section;
+	*ceiling = task->ceiling;
+
+	if ( !use )
+	{
+		return;
+	}
+
+	if ( i == use->task && use->critical_section > *critical_section )
+	{
+		*critical_section = use->critical_section;
+	}
+
+	if ( ( i == use->task || ( i < sizeof( use->users ) * 8 && ( use->users & ( 1UL << i ) ) ) ) && use->ceiling < *ceiling )
+	{
+		*ceiling = use->ceiling;
+	}
+}
+
+/*
+ * NAME:          blocking
+ *
+ * DESCRIPTION:   Blocking B(t) under SRP: the longest critical section of a
+ *                task with a deadline after t on a resource with a ceiling at
+ *                or before t (so a job with deadline t can be held up by it).
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *candidate
+ *    - The task being tested, or 0.
+ *  const struct edf_resource_use *use
+ *    - The resource use being tested, or 0.
+ *  unsigned long long t
+ *    - Length of the interval.
+ *
+ * RETURNS:
+ *  unsigned long long
+ *    - B(t) in ticks.
+ */
+static unsigned long long blocking( struct edf_admission *admission, const struct edf_task_params *candidate, const struct edf_resource_use *use, unsigned long long t )
+{
+	unsigned long long b = 0;
+	unsigned int count = task_count( admission, candidate );
+	unsigned int i;
+
+	for ( i = 0; i < count; ++i )
+	{
+		unsigned long critical_section;
+		unsigned long ceiling;
+
+		resource_at( admission, candidate, use, i, &critical_section, &ceiling );
+
+		if ( critical_section > b && task_at( admission, candidate, i )->deadline > t && ceiling <= t )
+		{
+			b = critical_section;
+		}
+	}
+
+	return b;
+}
+
+/*
+ * NAME:          demand
+ *
+ * DESCRIPTION:   Processor demand h(t): total execution time of the jobs that
+ *                are released at time 0 or later and have their deadline at or
+ *                before t (all tasks released together at time 0).
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *candidate
+ *    - The task being tested.
+ *  unsigned long long t
+ *    - Length of the interval.
+ *
+ * RETURNS:
+ *  unsigned long long
+ *    - h(t) in ticks.
+ */
+static unsigned long long demand( struct edf_admission *admission, const struct edf_task_params *candidate, unsigned long long t )
+{
+	unsigned long long h = 0;
+	unsigned int count = task_count( admission, candidate );
+	unsigned int i;
+
+	for ( i = 0; i < count; ++i )
+	{
+		const struct edf_task_params *task = task_at( admission, candidate, i );
+
+		if ( task->deadline <= t )
+		{
+			h += ( ( t - task->deadline ) / task->period + 1 ) * task->execution_time;
+		}
+	}
+
+	return h;
+}
+
+/*
+ * NAME:          last_deadline_before
+ *
+ * DESCRIPTION:   Latest absolute deadline strictly before t.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *candidate
+ *    - The task being tested.
+ *  unsigned long long t
+ *    - Time to look before.
+ *
+ * RETURNS:
+ *  unsigned long long
+ *    - The deadline, or 0 if there is none.
+ */
+static unsigned long long last_deadline_before( struct edf_admission *admission, const struct edf_task_params *candidate, unsigned long long t )
+{
+	unsigned long long latest = 0;
+	unsigned int count = task_count( admission, candidate );
+	unsigned int i;
+
+	for ( i = 0; i < count; ++i )
+	{
+		const struct edf_task_params *task = task_at( admission, candidate, i );
+
+		if ( task->deadline < t )
+		{
+			unsigned long long d = task->deadline + ( ( t - task->deadline - 1 ) / task->period ) * task->period;
+
+			if ( d > latest )
+			{
+				latest = d;
+			}
+		}
+	}
+
+	return latest;
+}
+
+/*
+ * NAME:          processor_demand_test
+ *
+ * DESCRIPTION:   Quick Processor-demand Analysis (Zhang & Burns). Checks
+ *                h(t) <= t for the deadlines up to the bound
+ *                L = max( D_max, sum( ( T_i - D_i ) * U_i ) / ( 1 - U ) ),
+ *                stepping backwards from L and jumping straight to h(t)
+ *                whenever h(t) < t, so only a few points need checking.
+ *                With shared resources, h(t) + B(t) <= t is checked instead.
+ *                B(t) can only be non-zero below the longest deadline of a
+ *                task holding resources, and can grow as t gets smaller, so
+ *                below that every deadline is checked.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *candidate
+ *    - The task being tested, or 0 to test the admitted set.
+ *  const struct edf_resource_use *use
+ *    - The resource use being tested, or 0.
+ *  unsigned long utilisation
+ *    - Total utilisation including the candidate (must be below
+ *      EDF_UTILISATION_ONE).
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if schedulable, 0 if not.
+ */
+static int processor_demand_test( struct edf_admission *admission, const struct edf_task_params *candidate,
+                                  const struct edf_resource_use *use, unsigned long utilisation )
+{
+	unsigned long long slack = 0;
+	unsigned long long bound = 0;
+	unsigned long long min_deadline = ~0ULL;
+	unsigned long long blocking_limit = 0;
+	unsigned long long t;
+	unsigned int count = task_count( admission, candidate );
+	unsigned int i;
+
+	for ( i = 0; i < count; ++i )
+	{
+		const struct edf_task_params *task = task_at( admission, candidate, i );
+		unsigned long critical_section;
+		unsigned long ceiling;
+
+		resource_at( admission, candidate, use, i, &critical_section, &ceiling );
+
+		if ( critical_section && ceiling != EDF_NO_CEILING && task->deadline > blocking_limit )
+		{
+			blocking_limit = task->deadline;
+		}
+
+		if ( task->deadline < task->period )
+		{
+			// ( T - D ) * C / T, rounded up.
+			slack += ( ( unsigned long long )( task->period - task->deadline ) * task->execution_time + task->period - 1 ) / task->period;
+		}
+
+		if ( task->deadline > bound )
+		{
+			bound = task->deadline;
+		}
+
+		if ( task->deadline < min_deadline )
+		{
+			min_deadline = task->deadline;
+		}
+	}
+
+	t = ( slack * EDF_UTILISATION_ONE + ( EDF_UTILISATION_ONE - utilisation ) - 1 ) / ( EDF_UTILISATION_ONE - utilisation );
+
+	if ( t > bound )
+	{
+		bound = t;
+	}
+
+	t = last_deadline_before( admission, candidate, bound + 1 );
+
+	for ( ;; )
+	{
+		unsigned long long h = demand( admission, candidate, t );
+
+		if ( t < blocking_limit )
+		{
+			h += blocking( admission, candidate, use, t );
+		}
+
+		if ( h > t )
+		{
+			// More work is due by t than fits in t.
+			return 0;
+		}
+
+		if ( h <= min_deadline && blocking_limit < min_deadline )
+		{
+			return 1;
+		}
+
+		if ( h < t && t > blocking_limit )
+		{
+			// No deadline between max( h, blocking_limit ) and t can fail.
+			t = ( h > blocking_limit ) ? h : last_deadline_before( admission, candidate, blocking_limit + 1 );
+		}
+		else
+		{
+			t = last_deadline_before( admission, candidate, t );
+		}
+
+		if ( t == 0 )
+		{
+			return 1;
+		}
+	}
+}
+
+/*
+ * See edf_admission.h for comments.
+ */
+void edf_admission_init( struct edf_admission *admission )
+{
+	admission->num_tasks = 0;
+	admission->num_constrained = 0;
+	admission->num_blocking = 0;
+	admission->utilisation = 0;
+}
+
+/*
+ * See edf_admission.h for comments.
+ */
+unsigned long edf_admission_utilisation( const struct edf_task_params *task )
+{
+	return ( unsigned long )( ( ( unsigned long long )task->execution_time * EDF_UTILISATION_ONE + task->period - 1 ) / task->period );
+}
+
+/*
+ * See edf_admission.h for comments.
+ */
+int edf_admission_test( struct edf_admission *admission, const struct edf_task_params *task )
+{
+	unsigned long utilisation;
+
+	if ( admission->num_tasks >= EDF_MAX_TASKS || task->period == 0 || task->execution_time > task->deadline )
+	{
+		return 0;
+	}
+
+	utilisation = admission->utilisation + edf_admission_utilisation( task );
+
+	if ( utilisation > EDF_UTILISATION_ONE )
+	{
+		return 0;
+	}
+
+	// With implicit deadlines and no shared resources, U <= 1 is exact for
+	// EDF.
+	if ( admission->num_constrained == 0 && task->deadline >= task->period &&
+	     admission->num_blocking == 0 && task->critical_section == 0 )
+	{
+		return 1;
+	}
+
+	// Otherwise U <= 1 is only necessary. The demand bound needs U < 1, so a
+	// fully loaded constrained task set is (pessimistically) rejected.
+	if ( utilisation == EDF_UTILISATION_ONE )
+	{
+		return 0;
+	}
+
+	return processor_demand_test( admission, task, 0, utilisation );
+}
+
+/*
+ * See edf_admission.h for comments.
+ */
+int edf_admission_add( struct edf_admission *admission, const struct edf_task_params *task )
+{
+	if ( admission->num_tasks >= EDF_MAX_TASKS )
+	{
+		return 0;
+	}
+
+	admission->tasks[ admission->num_tasks++ ] = *task;
+	admission->utilisation += edf_admission_utilisation( task );
+
+	if ( task->deadline < task->period )
+	{
+		++admission->num_constrained;
+	}
+
+	if ( task->critical_section )
+	{
+		++admission->num_blocking;
+	}
+
+	return 1;
+}
+
+/*
+ * See edf_admission.h for comments.
+ */
+int edf_admission_test_resource( struct edf_admission *admission, const struct edf_resource_use *use )
+{
+	if ( use->task >= admission->num_tasks || admission->utilisation >= EDF_UTILISATION_ONE )
+	{
+		return 0;
+	}
+
+	return processor_demand_test( admission, 0, use, admission->utilisation );
+}
+
+/*
+ * See edf_admission.h for comments.
+ */
+void edf_admission_add_resource( struct edf_admission *admission, const struct edf_resource_use *use )
+{
+	unsigned int i;
+
+	for ( i = 0; i < admission->num_tasks; ++i )
+	{
+		struct edf_task_params *task = &admission->tasks[ i ];
+		unsigned long critical_section;
+		unsigned long ceiling;
+
+		resource_at( admission, 0, use, i, &critical_section, &ceiling );
+
+		if ( critical_section && !task->critical_section )
+		{
+			++admission->num_blocking;
+		}
+
+		task->critical_section = critical_section;
+		task->ceiling = ceiling;
+	}
+}
@@ -0,0 +1,200 @@
+#ifndef __EDF_ADMISSION__
+#define __EDF_ADMISSION__
+
+#include "edf_ready_queue.h"
+
+/*
+ * Fixed point representation of a utilisation of 1 (100% of the CPU).
+ */
+#define EDF_UTILISATION_ONE    ( 1UL << 20 )
+
+/*
+ * Resource ceiling of a task that does not use any resources.
+ */
+#define EDF_NO_CEILING         ( ~0UL )
+
+/*
+ * Timing parameters of an admitted task, all in ticks.
+ *
+ * MEMBERS:
+ *   unsigned long execution_time
+ *     - Worst case execution time (C).
+ *   unsigned long deadline
+ *     - Relative deadline (D).
+ *   unsigned long period
+ *     - Period or minimum inter-arrival time (T).
+ *   unsigned long critical_section
+ *     - Longest time the task holds a shared resource (0 if it uses none).
+ *   unsigned long ceiling
+ *     - Lowest ceiling (shortest relative deadline of the users) of the
+ *       resources the task uses, or EDF_NO_CEILING. Pairing the longest
+ *       critical section with the lowest ceiling can only overestimate the
+ *       blocking the task causes.
+ */
+struct edf_task_params
+{
+	unsigned long execution_time;
+	unsigned long deadline;
+	unsigned long period;
+	unsigned long critical_section;
+	unsigned long ceiling;
+};
+
+/*
+ * A task starting to use a shared resource under the Stack Resource Policy.
+ *
+ * MEMBERS:
+ *   unsigned int task
+ *     - Index of the task in the admitted set.
+ *   unsigned long critical_section
+ *     - Longest time the task holds the resource.
+ *   unsigned long ceiling
+ *     - Ceiling of the resource once the task uses it.
+ *   unsigned long users
+ *     - Bitmap (by index) of the tasks already using the resource, whose
+ *       ceiling may drop.
+ */
+struct edf_resource_use
+{
+	unsigned int task;
+	unsigned long critical_section;
+	unsigned long ceiling;
+	unsigned long users;
+};
+
+/*
+ * State of the admission test: the admitted task set and its running totals.
+ *
+ * MEMBERS:
+ *   struct edf_task_params tasks[]
+ *     - Parameters of the admitted tasks (needed for processor demand
+ *       analysis).
+ *   unsigned int num_tasks
+ *     - Number of admitted tasks.
+ *   unsigned int num_constrained
+ *     - Number of admitted tasks whose deadline is shorter than their period.
+ *   unsigned int num_blocking
+ *     - Number of admitted tasks that hold shared resources.
+ *   unsigned long utilisation
+ *     - Total utilisation of the admitted tasks, in units of
+ *       1 / EDF_UTILISATION_ONE. Each task's share is rounded up, so this is
+ *       never less than the real utilisation.
+ */
+struct edf_admission
+{
+	struct edf_task_params tasks[ EDF_MAX_TASKS ];
+	unsigned int num_tasks;
+	unsigned int num_constrained;
+	unsigned int num_blocking;
+	unsigned long utilisation;
+};
+
+/*
+ * NAME:          edf_admission_init
+ *
+ * DESCRIPTION:   Initialize an empty task set.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_admission_init( struct edf_admission * );
+
+/*
+ * NAME:          edf_admission_test
+ *
+ * DESCRIPTION:   Check if the task set would still be schedulable under EDF
+ *                with a new task added. While every deadline equals its
+ *                period, this is the O(1) utilisation test (U <= 1). If any
+ *                deadline is shorter than its period, or any task holds
+ *                shared resources, processor demand analysis (QPA) is run
+ *                over the whole task set instead, with the blocking of one
+ *                critical section allowed for at each deadline.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *task
+ *    - Parameters of the new task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task set would be schedulable, 0 if not.
+ */
+int edf_admission_test( struct edf_admission *, const struct edf_task_params * );
+
+/*
+ * NAME:          edf_admission_add
+ *
+ * DESCRIPTION:   Add a task to the task set without testing it.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_task_params *task
+ *    - Parameters of the new task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task was added, 0 if the task set is full.
+ */
+int edf_admission_add( struct edf_admission *, const struct edf_task_params * );
+
+/*
+ * NAME:          edf_admission_utilisation
+ *
+ * DESCRIPTION:   Utilisation of a single task, rounded up.
+ *
+ * PARAMETERS:
+ *  const struct edf_task_params *task
+ *    - Parameters of the task.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - C / T in units of 1 / EDF_UTILISATION_ONE.
+ */
+unsigned long edf_admission_utilisation( const struct edf_task_params * );
+
+/*
+ * NAME:          edf_admission_test_resource
+ *
+ * DESCRIPTION:   Check if the task set would still be schedulable under EDF
+ *                with the Stack Resource Policy once a task starts using a
+ *                resource. Under SRP a job is blocked at most once, for one
+ *                critical section of a task with a later relative deadline,
+ *                so h(t) + B(t) <= t is checked at each deadline t, where B(t)
+ *                is the longest critical section of a task with D > t on a
+ *                resource with a ceiling <= t (Baker).
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_resource_use *use
+ *    - The new resource use.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task set would be schedulable, 0 if not.
+ */
+int edf_admission_test_resource( struct edf_admission *, const struct edf_resource_use * );
+
+/*
+ * NAME:          edf_admission_add_resource
+ *
+ * DESCRIPTION:   Record a resource use without testing it.
+ *
+ * PARAMETERS:
+ *  struct edf_admission *admission
+ *    - Pointer to the admission state.
+ *  const struct edf_resource_use *use
+ *    - The new resource use.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_admission_add_resource( struct edf_admission *, const struct edf_resource_use * );
+
+#endif // __EDF_ADMISSION__
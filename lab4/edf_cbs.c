@@ -0,0 +1,47 @@
+#include "edf_cbs.h"
+
+/*
+ * See edf_cbs.h for comments.
+ */
+void edf_cbs_init( struct edf_cbs *cbs, unsigned long budget, unsigned long period, unsigned long now )
+{
+	cbs->budget = budget;
+	cbs->period = period;
+	cbs->remaining = 0;
+	cbs->deadline = now;
+}
+
+/*
+ * See edf_cbs.h for comments.
+ */
+unsigned long edf_cbs_wake( struct edf_cbs *cbs, unsigned long now )
+{
+	// c >= ( d - now ) * Q / T, cross multiplied to stay in integers.
+	if ( ( long )( cbs->deadline - now ) <= 0 ||
+	     ( unsigned long long )cbs->remaining * cbs->period >= ( unsigned long long )( cbs->deadline - now ) * cbs->budget )
+	{
+		cbs->remaining = cbs->budget;
+		cbs->deadline = now + cbs->period;
+	}
+
+	return cbs->deadline;
+}
+
+/*
+ * See edf_cbs.h for comments.
+ */
+unsigned long edf_cbs_charge( struct edf_cbs *cbs, unsigned long ticks )
+{
+	// The scheduler wakes up when the budget runs out, so this normally only
+	// goes round once, but a late wake up can use up more than one budget.
+	while ( ticks >= cbs->remaining )
+	{
+		ticks -= cbs->remaining;
+		cbs->remaining = cbs->budget;
+		cbs->deadline += cbs->period;
+	}
+
+	cbs->remaining -= ticks;
+
+	return cbs->deadline;
+}
@@ -0,0 +1,89 @@
+#ifndef __EDF_CBS__
+#define __EDF_CBS__
+
+/*
+ * Budget and deadline of a Constant Bandwidth Server (Abeni & Buttazzo). The
+ * server is scheduled by EDF like a periodic task with execution time budget
+ * and period period, whatever work is queued to it, so it can never take more
+ * than budget / period of the CPU away from the other tasks.
+ *
+ * MEMBERS:
+ *   unsigned long budget
+ *     - Maximum budget (Q), in ticks.
+ *   unsigned long period
+ *     - Server period (T), in ticks.
+ *   unsigned long remaining
+ *     - Budget left (c), in ticks.
+ *   unsigned long deadline
+ *     - Current absolute deadline of the server (d).
+ */
+struct edf_cbs
+{
+	unsigned long budget;
+	unsigned long period;
+	unsigned long remaining;
+	unsigned long deadline;
+};
+
+/*
+ * NAME:          edf_cbs_init
+ *
+ * DESCRIPTION:   Initialize an idle server with no budget left.
+ *
+ * PARAMETERS:
+ *  struct edf_cbs *cbs
+ *    - Pointer to the server.
+ *  unsigned long budget
+ *    - Maximum budget (Q), in ticks (must not be 0).
+ *  unsigned long period
+ *    - Server period (T), in ticks.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_cbs_init( struct edf_cbs *, unsigned long, unsigned long, unsigned long );
+
+/*
+ * NAME:          edf_cbs_wake
+ *
+ * DESCRIPTION:   Work has arrived for an idle server. If the budget left can
+ *                be used up by the current deadline without going over the
+ *                server's bandwidth (c < ( d - now ) * Q / T), the server
+ *                keeps its budget and deadline. Otherwise the budget is
+ *                refilled and the deadline is set a period from now.
+ *
+ * PARAMETERS:
+ *  struct edf_cbs *cbs
+ *    - Pointer to the server.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - Deadline to schedule the server with.
+ */
+unsigned long edf_cbs_wake( struct edf_cbs *, unsigned long );
+
+/*
+ * NAME:          edf_cbs_charge
+ *
+ * DESCRIPTION:   Take the ticks the server ran out of its budget. Whenever the
+ *                budget runs out, it is refilled and the deadline is pushed
+ *                back a period, so the server drops behind other tasks instead
+ *                of overrunning.
+ *
+ * PARAMETERS:
+ *  struct edf_cbs *cbs
+ *    - Pointer to the server.
+ *  unsigned long ticks
+ *    - Ticks the server ran.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - Deadline to schedule the server with.
+ */
+unsigned long edf_cbs_charge( struct edf_cbs *, unsigned long );
+
+#endif // __EDF_CBS__
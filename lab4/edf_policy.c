@@ -0,0 +1,375 @@
+#include "edf_policy.h"
+#include <string.h>
+
+/*
+ * NAME:          next_sporadic_release
+ *
+ * DESCRIPTION:   Earliest time a sporadic task can be released again: now, or
+ *                the minimum inter-arrival time (period) after its last
+ *                release if that has not passed yet.
+ *
+ * PARAMETERS:
+ *  struct tcb *tcb
+ *    - The task.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - Release time.
+ */
+static unsigned long next_sporadic_release( struct tcb *tcb, unsigned long now )
+{
+	if ( now - tcb->restart_time >= tcb->period )
+	{
+		return now;
+	}
+
+	return tcb->restart_time + tcb->period;
+}
+
+/*
+ * NAME:          record_job_completion
+ *
+ * DESCRIPTION:   Update a task's statistics for a job that just completed.
+ *
+ * PARAMETERS:
+ *  struct tcb *tcb
+ *    - The task.
+ *  unsigned long deadline
+ *    - Absolute deadline of the job.
+ *  unsigned long now
+ *    - Tick count the job completed at.
+ *
+ * RETURNS:
+ *  int
+ *    - EDF_JOB_COMPLETED, or EDF_JOB_MISSED if the job was late.
+ */
+static int record_job_completion( struct tcb *tcb, unsigned long deadline, unsigned long now )
+{
+	struct edf_task_stats *stats = &tcb->stats;
+	unsigned int response_time = now - tcb->restart_time;
+	unsigned int bucket = 0;
+	unsigned int value = response_time;
+	int result = EDF_JOB_COMPLETED;
+
+	++stats->jobs;
+
+	if ( response_time > stats->worst_response_time )
+	{
+		stats->worst_response_time = response_time;
+	}
+
+	if ( tcb->elapsed_time > tcb->execution_time )
+	{
+		++stats->overruns;
+	}
+
+	if ( ( long )( now - deadline ) > 0 )
+	{
+		++stats->misses;
+		stats->total_tardiness += now - deadline;
+		result = EDF_JOB_MISSED;
+	}
+
+	// Bucket is the number of significant bits in the response time.
+	while ( value != 0 && bucket < EDF_STATS_HISTOGRAM_BUCKETS - 1 )
+	{
+		value >>= 1;
+		++bucket;
+	}
+
+	++stats->response_histogram[ bucket ];
+
+	return result;
+}
+
+/*
+ * NAME:          has_started
+ *
+ * DESCRIPTION:   Check if a ready task's current job has already been
+ *                dispatched.
+ *
+ * PARAMETERS:
+ *  void *owner
+ *    - The task's tcb.
+ *  void *context
+ *    - Not used.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if it has, 0 if not.
+ */
+static int has_started( void *owner, void *context )
+{
+	( void )context;
+
+	return ( ( struct tcb * )owner )->started;
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+void edf_policy_init( struct edf_policy *policy, unsigned long now )
+{
+	edf_ready_queue_init( &policy->ready_tasks );
+	edf_release_wheel_init( &policy->blocked_tasks, now );
+	policy->system_ceiling = EDF_NO_CEILING;
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+void edf_policy_setup_task( struct tcb *tcb, const struct edf_task_params *params, unsigned int id, unsigned int sporadic, unsigned long now )
+{
+	tcb->id = id;
+	tcb->execution_time = params->execution_time;
+	tcb->deadline = params->deadline;
+	tcb->period = params->period;
+	tcb->elapsed_time = 0;
+	tcb->started = 0;
+	tcb->absolute_deadline = params->deadline;
+	tcb->sporadic = sporadic;
+	tcb->release_pending = 0;
+	tcb->idle = sporadic;
+	tcb->cbs = 0;
+	tcb->release_node.owner = tcb;
+
+	// A sporadic task can be released as soon as it is set up, so make it
+	// look like its last release was a full period ago.
+	tcb->restart_time = sporadic ? now - params->period : 0;
+	memset( &tcb->stats, 0, sizeof( tcb->stats ) );
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+void edf_policy_setup_server( struct tcb *tcb, struct edf_cbs *cbs, const struct edf_task_params *params, unsigned int id, unsigned long now )
+{
+	edf_policy_setup_task( tcb, params, id, 0, now );
+	edf_cbs_init( cbs, params->execution_time, params->period, now );
+	tcb->cbs = cbs;
+	tcb->idle = 1;
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+int edf_policy_ready( struct edf_policy *policy, struct tcb *tcb )
+{
+	if ( edf_ready_queue_insert( &policy->ready_tasks, tcb->absolute_deadline, tcb->id, tcb ) )
+	{
+		return 1;
+	}
+
+	// The queue only fills up if more tasks are set up than it holds. Rather
+	// than lose the task, file it to be released again on the next advance;
+	// its release time has passed, and its deadline is kept.
+	edf_release_wheel_insert( &policy->blocked_tasks, &tcb->release_node, tcb->restart_time );
+
+	return 0;
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+void edf_policy_release( struct edf_policy *policy, struct tcb *tcb, unsigned long release_time, unsigned long now )
+{
+	tcb->restart_time = release_time;
+	tcb->absolute_deadline = release_time + tcb->deadline;
+
+	if ( ( long )( release_time - now ) <= 0 )
+	{
+		edf_policy_ready( policy, tcb );
+	}
+	else
+	{
+		edf_release_wheel_insert( &policy->blocked_tasks, &tcb->release_node, release_time );
+	}
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+void edf_policy_release_sporadic( struct edf_policy *policy, struct tcb *tcb, unsigned long now )
+{
+	if ( tcb->idle )
+	{
+		tcb->idle = 0;
+		edf_policy_release( policy, tcb, next_sporadic_release( tcb, now ), now );
+	}
+	else
+	{
+		tcb->release_pending = 1;
+	}
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+void edf_policy_wake_server( struct edf_policy *policy, struct tcb *tcb, unsigned long now )
+{
+	if ( !tcb->idle )
+	{
+		// Running servers are dealt with when they stop.
+		return;
+	}
+
+	tcb->idle = 0;
+	tcb->restart_time = now;
+	tcb->absolute_deadline = edf_cbs_wake( tcb->cbs, now );
+	tcb->elapsed_time = tcb->execution_time - tcb->cbs->remaining;
+
+	edf_policy_ready( policy, tcb );
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+void edf_policy_advance( struct edf_policy *policy, unsigned long now )
+{
+	struct edf_wheel_node *node;
+
+	node = edf_release_wheel_advance( &policy->blocked_tasks, now );
+
+	while ( node )
+	{
+		// Read the next node first, since it is only valid until the task is
+		// filed somewhere else.
+		struct edf_wheel_node *next = node->next;
+
+		// It is currently task's wake up time, or it has passed.
+		// So put it into the ready queue now.
+		edf_policy_ready( policy, ( struct tcb * )node->owner );
+
+		node = next;
+	}
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+struct tcb *edf_policy_next( struct edf_policy *policy )
+{
+	struct tcb *tcb;
+
+	// The ready queue is a heap ordered by deadline, with ties broken by ID
+	// (T1 > T2 > T3), so the task to run is always at the root unless the
+	// system ceiling holds it back. A job that has not started may only
+	// start from the root: letting a later one start ahead of it would block
+	// the root for longer than one critical section.
+	tcb = ( struct tcb * )edf_ready_queue_peek( &policy->ready_tasks );
+
+	if ( !tcb )
+	{
+		return 0;
+	}
+
+	if ( tcb->started || tcb->deadline < policy->system_ceiling )
+	{
+		tcb = ( struct tcb * )edf_ready_queue_pop( &policy->ready_tasks );
+	}
+	else
+	{
+		tcb = ( struct tcb * )edf_ready_queue_pop_if( &policy->ready_tasks, has_started, 0 );
+	}
+
+	if ( tcb )
+	{
+		// Whether the job has run is recorded here rather than read from its
+		// charged time, which can still be 0 after it has locked a mutex.
+		tcb->started = 1;
+	}
+
+	return tcb;
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+int edf_policy_stop( struct edf_policy *policy, struct tcb *tcb, unsigned long ran, unsigned long now )
+{
+	int result;
+
+	tcb->elapsed_time += ran;
+
+	if ( tcb->elapsed_time < tcb->execution_time )
+	{
+		// Task needs to continue to be done, but other tasks may have an
+		// earlier deadline now.
+		edf_policy_ready( policy, tcb );
+		return EDF_JOB_PREEMPTED;
+	}
+
+	result = record_job_completion( tcb, tcb->absolute_deadline, now );
+
+	// Reset elapsed time.
+	tcb->elapsed_time = 0;
+	tcb->started = 0;
+
+	if ( tcb->sporadic )
+	{
+		if ( !tcb->release_pending )
+		{
+			// Wait for the next release.
+			tcb->idle = 1;
+		}
+		else
+		{
+			// A release came in while this job was running.
+			tcb->release_pending = 0;
+			edf_policy_release( policy, tcb, next_sporadic_release( tcb, now ), now );
+		}
+	}
+	else
+	{
+		// This task should be prepped to start again after a period of
+		// restarting.
+		edf_policy_release( policy, tcb, tcb->restart_time + tcb->period, now );
+	}
+
+	return result;
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+int edf_policy_stop_server( struct edf_policy *policy, struct tcb *tcb, unsigned long ran, unsigned long now, int has_work )
+{
+	unsigned long deadline = tcb->absolute_deadline;
+
+	tcb->absolute_deadline = edf_cbs_charge( tcb->cbs, ran );
+	tcb->elapsed_time = tcb->execution_time - tcb->cbs->remaining;
+
+	if ( has_work )
+	{
+		edf_policy_ready( policy, tcb );
+		return EDF_JOB_PREEMPTED;
+	}
+
+	// The whole busy period counts as one job in the statistics.
+	tcb->idle = 1;
+	tcb->started = 0;
+
+	return record_job_completion( tcb, deadline, now );
+}
+
+/*
+ * See edf_policy.h for comments.
+ */
+unsigned long edf_policy_wake_time( struct edf_policy *policy, struct tcb *running, unsigned long now )
+{
+	unsigned long wake_time = edf_release_wheel_next_expiry( &policy->blocked_tasks );
+
+	if ( running )
+	{
+		unsigned long budget_end = now + ( running->execution_time - running->elapsed_time );
+
+		if ( wake_time == EDF_WHEEL_NO_EXPIRY || ( long )( budget_end - wake_time ) < 0 )
+		{
+			wake_time = budget_end;
+		}
+	}
+
+	return ( wake_time == EDF_WHEEL_NO_EXPIRY ) ? EDF_NO_EVENT : wake_time;
+}
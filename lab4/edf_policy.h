@@ -0,0 +1,377 @@
+#ifndef __EDF_POLICY__
+#define __EDF_POLICY__
+
+#include "edf_ready_queue.h"
+#include "edf_release_wheel.h"
+#include "edf_admission.h"
+#include "edf_cbs.h"
+
+/*
+ * The scheduling decisions of the EDF scheduler, kept apart from FreeRTOS so
+ * the same code can run on the host (see host/edf_multicore_simulator.c).
+ * Nothing here suspends or resumes tasks: the caller is told which task to run
+ * and for how long at most, and reports back how long it actually ran.
+ * Times are tick counts.
+ */
+
+/*
+ * Number of buckets in the response time histogram. Bucket 0 counts response
+ * times of 0 ticks, bucket k counts response times in [2^(k-1), 2^k) ticks,
+ * and the last bucket also counts everything longer.
+ */
+#define EDF_STATS_HISTOGRAM_BUCKETS    16
+
+/*
+ * Returned by edf_policy_wake_time when nothing is due.
+ */
+#define EDF_NO_EVENT                   ( ~0UL )
+
+/*
+ * Returned by edf_policy_stop and edf_policy_stop_server.
+ */
+#define EDF_JOB_PREEMPTED              0    // Back in the ready queue.
+#define EDF_JOB_COMPLETED              1    // Completed by its deadline.
+#define EDF_JOB_MISSED                 2    // Completed after its deadline.
+
+/*
+ * Per task statistics, updated each time a job of the task completes.
+ *
+ * MEMBERS:
+ *   unsigned int jobs
+ *     - Number of completed jobs.
+ *   unsigned int misses
+ *     - Number of jobs that completed after their deadline.
+ *   unsigned int overruns
+ *     - Number of jobs that were charged more than their execution time.
+ *   unsigned int worst_response_time
+ *     - Longest time from a job's release to its completion, in ticks.
+ *   unsigned long total_tardiness
+ *     - Sum of the time by which jobs missed their deadlines, in ticks.
+ *   unsigned int response_histogram[]
+ *     - log2 histogram of response times (see EDF_STATS_HISTOGRAM_BUCKETS).
+ */
+struct edf_task_stats
+{
+	unsigned int jobs;
+	unsigned int misses;
+	unsigned int overruns;
+	unsigned int worst_response_time;
+	unsigned long total_tardiness;
+	unsigned int response_histogram[ EDF_STATS_HISTOGRAM_BUCKETS ];
+};
+
+/*
+ * Task Control Buffer.
+ *
+ * The release_node is used to file the task in the blocked tasks wheel.
+ * deadline is relative to the job's release (restart_time) and may be shorter
+ * than the period; absolute_deadline is the current job's deadline. For a
+ * sporadic task, period is the minimum time between releases, idle is set
+ * while it waits for a release, and release_pending is set if a release came
+ * in while a job was still waiting or running. started is set once the current
+ * job (or server busy period) has been dispatched. cbs points to the budget of
+ * a Constant Bandwidth Server, or is 0 for a normal task. handle is the task's
+ * xTaskHandle (which FreeRTOS defines as a void *); the policy never uses it.
+ */
+struct tcb
+{
+	unsigned int id;
+	unsigned int execution_time;
+	unsigned int deadline;
+	unsigned int period;
+	unsigned int elapsed_time;
+	unsigned int restart_time;
+	unsigned long absolute_deadline;
+	unsigned char sporadic;
+	unsigned char release_pending;
+	unsigned char idle;
+	unsigned char started;
+	struct edf_cbs *cbs;
+	void *handle;
+	struct edf_wheel_node release_node;
+	struct edf_task_stats stats;
+};
+
+/*
+ * State of the policy.
+ *
+ * MEMBERS:
+ *   struct edf_ready_queue ready_tasks
+ *     - Heap to keep track of tasks that are ready to execute, ordered by
+ *       deadline (then ID). The running task is not in it.
+ *   struct edf_release_wheel blocked_tasks
+ *     - Timing wheel to keep track of tasks that are not ready to execute
+ *       (waiting for a wake up time to pass), filed by restart time.
+ *   unsigned long system_ceiling
+ *     - Lowest ceiling of the locked mutexes (Stack Resource Policy), or
+ *       EDF_NO_CEILING if none are locked.
+ */
+struct edf_policy
+{
+	struct edf_ready_queue ready_tasks;
+	struct edf_release_wheel blocked_tasks;
+	unsigned long system_ceiling;
+};
+
+/*
+ * NAME:          edf_policy_init
+ *
+ * DESCRIPTION:   Initialize a policy with no tasks.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_policy_init( struct edf_policy *, unsigned long );
+
+/*
+ * NAME:          edf_policy_setup_task
+ *
+ * DESCRIPTION:   Fill in a task's tcb. The task is not released; a periodic
+ *                task is started with edf_policy_release, and a sporadic task
+ *                waits for edf_policy_release_sporadic.
+ *
+ * PARAMETERS:
+ *  struct tcb *tcb
+ *    - Pointer to the task's tcb.
+ *  const struct edf_task_params *params
+ *    - Timing parameters of the task.
+ *  unsigned int id
+ *    - ID for the task.
+ *  unsigned int sporadic
+ *    - 1 for a sporadic task, 0 for a periodic task.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_policy_setup_task( struct tcb *, const struct edf_task_params *, unsigned int, unsigned int, unsigned long );
+
+/*
+ * NAME:          edf_policy_setup_server
+ *
+ * DESCRIPTION:   Fill in the tcb of a Constant Bandwidth Server, which starts
+ *                idle with no budget.
+ *
+ * PARAMETERS:
+ *  struct tcb *tcb
+ *    - Pointer to the server's tcb.
+ *  struct edf_cbs *cbs
+ *    - Budget of the server.
+ *  const struct edf_task_params *params
+ *    - Budget (execution time) and period of the server.
+ *  unsigned int id
+ *    - ID for the server.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_policy_setup_server( struct tcb *, struct edf_cbs *, const struct edf_task_params *, unsigned int, unsigned long );
+
+/*
+ * NAME:          edf_policy_ready
+ *
+ * DESCRIPTION:   Put a task into the ready queue with its current deadline.
+ *                If the ready queue is full, the task is released again on
+ *                the next call to edf_policy_advance instead.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  struct tcb *tcb
+ *    - The task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task is in the ready queue, 0 if it was put off.
+ */
+int edf_policy_ready( struct edf_policy *, struct tcb * );
+
+/*
+ * NAME:          edf_policy_release
+ *
+ * DESCRIPTION:   Set up the next job of a task: its release time, and its
+ *                deadline (release time + relative deadline). The task is made
+ *                ready straight away if the release time has come, otherwise
+ *                it is added to the blocked wheel.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  struct tcb *tcb
+ *    - The task.
+ *  unsigned long release_time
+ *    - Tick count to release the job at.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_policy_release( struct edf_policy *, struct tcb *, unsigned long, unsigned long );
+
+/*
+ * NAME:          edf_policy_release_sporadic
+ *
+ * DESCRIPTION:   A sporadic task has been released. An idle task is released
+ *                now, or once its minimum inter-arrival time has passed. A
+ *                task that already has a job is released again when that job
+ *                completes (releases in between are merged into one).
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  struct tcb *tcb
+ *    - The task.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_policy_release_sporadic( struct edf_policy *, struct tcb *, unsigned long );
+
+/*
+ * NAME:          edf_policy_wake_server
+ *
+ * DESCRIPTION:   Work has arrived for a server. If it is idle, it is put back
+ *                into the ready queue with the deadline given by the CBS wake
+ *                up rule.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  struct tcb *tcb
+ *    - The server's tcb.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_policy_wake_server( struct edf_policy *, struct tcb *, unsigned long );
+
+/*
+ * NAME:          edf_policy_advance
+ *
+ * DESCRIPTION:   Move the blocked wheel forward and make the tasks whose
+ *                restart time has come ready. Only the tasks that are due are
+ *                looked at.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_policy_advance( struct edf_policy *, unsigned long );
+
+/*
+ * NAME:          edf_policy_next
+ *
+ * DESCRIPTION:   Take the task that should run next out of the ready queue:
+ *                the earliest deadline (ties broken by ID), subject to the
+ *                Stack Resource Policy. A job can carry on once it has
+ *                started, but it can only start if its preemption level is
+ *                above the system ceiling (its relative deadline is shorter
+ *                than that of every user of a locked mutex). Any mutex it
+ *                needs is then free, so it never blocks once it has started.
+ *                While the earliest job is held back, only jobs that have
+ *                already started may run; one of them holds the mutex that
+ *                raised the ceiling, so there is always one.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *
+ * RETURNS:
+ *  struct tcb *
+ *    - The task to run, or 0 if there is none.
+ */
+struct tcb *edf_policy_next( struct edf_policy * );
+
+/*
+ * NAME:          edf_policy_stop
+ *
+ * DESCRIPTION:   A task taken with edf_policy_next has stopped running. It is
+ *                charged the ticks it ran. If its job has now used its
+ *                execution time, the job completes (statistics are updated
+ *                and the next job is set up), otherwise the task goes back
+ *                into the ready queue.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  struct tcb *tcb
+ *    - The task.
+ *  unsigned long ran
+ *    - Ticks the task ran.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  int
+ *    - EDF_JOB_PREEMPTED, EDF_JOB_COMPLETED or EDF_JOB_MISSED.
+ */
+int edf_policy_stop( struct edf_policy *, struct tcb *, unsigned long, unsigned long );
+
+/*
+ * NAME:          edf_policy_stop_server
+ *
+ * DESCRIPTION:   Same as edf_policy_stop, for a server. The server is charged
+ *                against its budget (a later deadline if it ran out). If it
+ *                still has work, it goes back into the ready queue, otherwise
+ *                it goes idle and its busy period counts as one job.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  struct tcb *tcb
+ *    - The server's tcb.
+ *  unsigned long ran
+ *    - Ticks the server ran.
+ *  unsigned long now
+ *    - Current tick count.
+ *  int has_work
+ *    - Non-zero if the server still has requests to run.
+ *
+ * RETURNS:
+ *  int
+ *    - EDF_JOB_PREEMPTED, EDF_JOB_COMPLETED or EDF_JOB_MISSED.
+ */
+int edf_policy_stop_server( struct edf_policy *, struct tcb *, unsigned long, unsigned long, int );
+
+/*
+ * NAME:          edf_policy_wake_time
+ *
+ * DESCRIPTION:   Get the time the policy next has to be looked at: the
+ *                earliest restart time of a blocked task, or the time the
+ *                running task uses up its execution time, whichever comes
+ *                first.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - Pointer to the policy.
+ *  struct tcb *running
+ *    - The task that is about to run, or 0.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - Tick count, or EDF_NO_EVENT if nothing is due.
+ */
+unsigned long edf_policy_wake_time( struct edf_policy *, struct tcb *, unsigned long );
+
+#endif // __EDF_POLICY__
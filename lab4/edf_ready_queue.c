@@ -0,0 +1,229 @@
+#include "edf_ready_queue.h"
+
+/*
+ * Returns non-zero if node a should be run before node b (earlier deadline,
+ * or same deadline and lower ID). Deadlines are compared by their difference
+ * so the order still holds when the tick count wraps.
+ */
+#define NODE_BEFORE( a, b )    ( ( ( long )( ( a )->deadline - ( b )->deadline ) < 0 ) || \
+                                 ( ( ( a )->deadline == ( b )->deadline ) && ( ( a )->id < ( b )->id ) ) )
+
+/*
+ * NAME:          sift_up
+ *
+ * DESCRIPTION:   Move a hole up the heap until its parent should run before
+ *                the node, then put the node in it. Parents are shifted down
+ *                into the hole instead of swapped so each level only costs one
+ *                copy.
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue.
+ *  unsigned int hole
+ *    - Index of the hole.
+ *  const struct edf_ready_queue_node *node
+ *    - Node to put in the hole.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void sift_up( struct edf_ready_queue *queue, unsigned int hole, const struct edf_ready_queue_node *node )
+{
+	while ( hole != 0 )
+	{
+		unsigned int parent = ( hole - 1 ) >> 1;
+
+		if ( !NODE_BEFORE( node, &queue->nodes[ parent ] ) )
+		{
+			break;
+		}
+
+		queue->nodes[ hole ] = queue->nodes[ parent ];
+		hole = parent;
+	}
+
+	queue->nodes[ hole ] = *node;
+}
+
+/*
+ * NAME:          sift_down
+ *
+ * DESCRIPTION:   Move a hole down the heap until the node should run before
+ *                both children, then put the node in it.
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue.
+ *  unsigned int hole
+ *    - Index of the hole.
+ *  const struct edf_ready_queue_node *node
+ *    - Node to put in the hole.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void sift_down( struct edf_ready_queue *queue, unsigned int hole, const struct edf_ready_queue_node *node )
+{
+	unsigned int length = queue->length;
+
+	for ( ;; )
+	{
+		unsigned int child = ( hole << 1 ) + 1;
+
+		if ( child >= length )
+		{
+			break;
+		}
+
+		// Pick the child that should run first.
+		if ( ( child + 1 < length ) && NODE_BEFORE( &queue->nodes[ child + 1 ], &queue->nodes[ child ] ) )
+		{
+			++child;
+		}
+
+		if ( !NODE_BEFORE( &queue->nodes[ child ], node ) )
+		{
+			break;
+		}
+
+		queue->nodes[ hole ] = queue->nodes[ child ];
+		hole = child;
+	}
+
+	queue->nodes[ hole ] = *node;
+}
+
+/*
+ * NAME:          remove_at
+ *
+ * DESCRIPTION:   Remove the entry at any position in the heap, filling the gap
+ *                with the last entry. O(log n).
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue (must not be empty).
+ *  unsigned int index
+ *    - Position of the entry.
+ *
+ * RETURNS:
+ *  void *
+ *    - Owner of the removed entry.
+ */
+static void *remove_at( struct edf_ready_queue *queue, unsigned int index )
+{
+	void *owner = queue->nodes[ index ].owner;
+	struct edf_ready_queue_node last;
+
+	last = queue->nodes[ --queue->length ];
+
+	if ( index != queue->length )
+	{
+		// The last entry can belong above or below the gap.
+		if ( index != 0 && NODE_BEFORE( &last, &queue->nodes[ ( index - 1 ) >> 1 ] ) )
+		{
+			sift_up( queue, index, &last );
+		}
+		else
+		{
+			sift_down( queue, index, &last );
+		}
+	}
+
+	return owner;
+}
+
+/*
+ * See edf_ready_queue.h for comments.
+ */
+void edf_ready_queue_init( struct edf_ready_queue *queue )
+{
+	queue->length = 0;
+}
+
+/*
+ * See edf_ready_queue.h for comments.
+ */
+int edf_ready_queue_insert( struct edf_ready_queue *queue, unsigned long deadline, unsigned int id, void *owner )
+{
+	struct edf_ready_queue_node node;
+
+	if ( queue->length >= EDF_MAX_TASKS )
+	{
+		return 0;
+	}
+
+	node.deadline = deadline;
+	node.id = id;
+	node.owner = owner;
+
+	// Start with a hole at the end of the heap and move it up.
+	sift_up( queue, queue->length++, &node );
+
+	return 1;
+}
+
+/*
+ * See edf_ready_queue.h for comments.
+ */
+void *edf_ready_queue_peek( struct edf_ready_queue *queue )
+{
+	if ( queue->length == 0 )
+	{
+		return 0;
+	}
+
+	return queue->nodes[ 0 ].owner;
+}
+
+/*
+ * See edf_ready_queue.h for comments.
+ */
+void *edf_ready_queue_pop( struct edf_ready_queue *queue )
+{
+	if ( queue->length == 0 )
+	{
+		return 0;
+	}
+
+	return remove_at( queue, 0 );
+}
+
+/*
+ * See edf_ready_queue.h for comments.
+ */
+void *edf_ready_queue_pop_if( struct edf_ready_queue *queue, int ( *eligible )( void *, void * ), void *context )
+{
+	unsigned int best;
+	unsigned int i;
+
+	if ( queue->length == 0 )
+	{
+		return 0;
+	}
+
+	// Usually the root can run, which costs the same as a plain pop.
+	if ( eligible( queue->nodes[ 0 ].owner, context ) )
+	{
+		return remove_at( queue, 0 );
+	}
+
+	// Otherwise look through the rest of the heap for the earliest entry
+	// that can.
+	best = queue->length;
+
+	for ( i = 1; i < queue->length; ++i )
+	{
+		if ( ( best == queue->length || NODE_BEFORE( &queue->nodes[ i ], &queue->nodes[ best ] ) ) &&
+		     eligible( queue->nodes[ i ].owner, context ) )
+		{
+			best = i;
+		}
+	}
+
+	if ( best == queue->length )
+	{
+		return 0;
+	}
+
+	return remove_at( queue, best );
+}
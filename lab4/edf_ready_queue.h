@@ -0,0 +1,139 @@
+#ifndef __EDF_READY_QUEUE__
+#define __EDF_READY_QUEUE__
+
+/*
+ * Maximum number of tasks that can be in the ready queue at once.
+ * Can be overridden at compile time (the host benchmarks use a larger value).
+ */
+#ifndef EDF_MAX_TASKS
+#define EDF_MAX_TASKS        16
+#endif
+
+/*
+ * A single entry in the ready queue.
+ *
+ * MEMBERS:
+ *   unsigned long deadline
+ *     - Absolute deadline (in ticks) of the task. Primary key.
+ *   unsigned int id
+ *     - ID of the task. Used to break ties between equal deadlines (lower ID
+ *       wins, so T1 > T2 > T3).
+ *   void *owner
+ *     - Object the entry refers to (the policy stores the task's tcb here).
+ */
+struct edf_ready_queue_node
+{
+	unsigned long deadline;
+	unsigned int id;
+	void *owner;
+};
+
+/*
+ * Ready queue for the EDF scheduler. Implemented as a binary min-heap keyed on
+ * (deadline, id), stored in a fixed size array so no dynamic memory is needed.
+ *
+ * MEMBERS:
+ *   struct edf_ready_queue_node nodes[]
+ *     - Heap storage. nodes[0] is always the task with the earliest deadline.
+ *   unsigned int length
+ *     - Number of entries currently in the heap.
+ */
+struct edf_ready_queue
+{
+	struct edf_ready_queue_node nodes[ EDF_MAX_TASKS ];
+	unsigned int length;
+};
+
+/*
+ * Returns non-zero if the ready queue has no entries.
+ */
+#define edf_ready_queue_is_empty( queue )    ( ( queue )->length == 0 )
+
+/*
+ * NAME:          edf_ready_queue_init
+ *
+ * DESCRIPTION:   Initialize an empty ready queue.
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_ready_queue_init( struct edf_ready_queue * );
+
+/*
+ * NAME:          edf_ready_queue_insert
+ *
+ * DESCRIPTION:   Insert an entry into the ready queue. O(log n).
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue.
+ *  unsigned long deadline
+ *    - Absolute deadline of the entry.
+ *  unsigned int id
+ *    - Task ID used to break ties.
+ *  void *owner
+ *    - Object the entry refers to.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the entry was inserted, 0 if the queue is full.
+ */
+int edf_ready_queue_insert( struct edf_ready_queue *, unsigned long, unsigned int, void * );
+
+/*
+ * NAME:          edf_ready_queue_peek
+ *
+ * DESCRIPTION:   Get the entry with the earliest deadline without removing it.
+ *                O(1).
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue.
+ *
+ * RETURNS:
+ *  void *
+ *    - Owner of the earliest deadline entry, or 0 if the queue is empty.
+ */
+void *edf_ready_queue_peek( struct edf_ready_queue * );
+
+/*
+ * NAME:          edf_ready_queue_pop
+ *
+ * DESCRIPTION:   Remove the entry with the earliest deadline. O(log n).
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue.
+ *
+ * RETURNS:
+ *  void *
+ *    - Owner of the removed entry, or 0 if the queue is empty.
+ */
+void *edf_ready_queue_pop( struct edf_ready_queue * );
+
+/*
+ * NAME:          edf_ready_queue_pop_if
+ *
+ * DESCRIPTION:   Remove the entry with the earliest deadline out of the
+ *                entries accepted by a function. O(log n) if the root is
+ *                accepted, otherwise O(n) (every entry is looked at).
+ *
+ * PARAMETERS:
+ *  struct edf_ready_queue *queue
+ *    - Pointer to the ready queue.
+ *  int ( *eligible )( void *owner, void *context )
+ *    - Returns non-zero if the entry with this owner can be removed.
+ *  void *context
+ *    - Passed on to eligible.
+ *
+ * RETURNS:
+ *  void *
+ *    - Owner of the removed entry, or 0 if no entry was accepted.
+ */
+void *edf_ready_queue_pop_if( struct edf_ready_queue *, int ( * )( void *, void * ), void * );
+
+#endif // __EDF_READY_QUEUE__
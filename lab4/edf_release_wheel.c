@@ -0,0 +1,353 @@
+#include "edf_release_wheel.h"
+
+#define SLOT_MASK              ( EDF_WHEEL_SLOTS - 1 )
+
+/*
+ * Number of ticks covered by the whole wheel.
+ */
+#define WHEEL_SPAN             ( 1UL << ( EDF_WHEEL_SLOT_BITS * EDF_WHEEL_LEVELS ) )
+
+/*
+ * Bit in a level's occupied bitmap for a slot.
+ */
+#define SLOT_BIT( slot )       ( 1UL << ( slot ) )
+
+/*
+ * NAME:          count_trailing_zeros
+ *
+ * DESCRIPTION:   Index of the lowest set bit (value must not be 0).
+ *
+ * PARAMETERS:
+ *  unsigned long value
+ *    - Value to look at.
+ *
+ * RETURNS:
+ *  unsigned int
+ *    - Index of the lowest set bit.
+ */
+static unsigned int count_trailing_zeros( unsigned long value )
+{
+#if defined( __ARMCC_VERSION )
+	// RBIT + CLZ on the Cortex-M3.
+	return __clz( __rbit( value ) );
+#elif defined( __GNUC__ )
+	return __builtin_ctzl( value );
+#else
+	unsigned int i = 0;
+
+	while ( !( value & 1UL ) )
+	{
+		value >>= 1;
+		++i;
+	}
+
+	return i;
+#endif
+}
+
+/*
+ * NAME:          first_occupied_from
+ *
+ * DESCRIPTION:   Distance from a slot to the first occupied slot at or after
+ *                it, wrapping around the end of the level.
+ *
+ * PARAMETERS:
+ *  unsigned long occupied
+ *    - Occupied bitmap of the level (must not be 0).
+ *  unsigned int start
+ *    - Slot to start looking from.
+ *
+ * RETURNS:
+ *  unsigned int
+ *    - Number of slots from start to the first occupied slot.
+ */
+static unsigned int first_occupied_from( unsigned long occupied, unsigned int start )
+{
+	unsigned long rotated = occupied >> start;
+
+	if ( start != 0 )
+	{
+		rotated |= occupied << ( EDF_WHEEL_SLOTS - start );
+	}
+
+	return count_trailing_zeros( rotated & ( ( SLOT_BIT( EDF_WHEEL_SLOTS - 1 ) << 1 ) - 1UL ) );
+}
+
+/*
+ * NAME:          file_node
+ *
+ * DESCRIPTION:   Put a node into the slot for its release time, relative to
+ *                the wheel's current base.
+ *
+ * PARAMETERS:
+ *  struct edf_release_wheel *wheel
+ *    - Pointer to the wheel.
+ *  struct edf_wheel_node *node
+ *    - Node to file.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void file_node( struct edf_release_wheel *wheel, struct edf_wheel_node *node )
+{
+	unsigned long expiry = node->expiry;
+	unsigned long delta;
+	unsigned int level;
+	unsigned int slot;
+
+	// Releases that are already due go into the slot that is processed next.
+	if ( ( long )( expiry - wheel->base ) < 0 )
+	{
+		expiry = wheel->base;
+	}
+
+	delta = expiry - wheel->base;
+
+	// Releases past the end of the wheel are parked in the last slot they can
+	// reach and re-filed (with their real expiry) when that slot cascades.
+	if ( delta >= WHEEL_SPAN )
+	{
+		delta = WHEEL_SPAN - 1;
+		expiry = wheel->base + delta;
+	}
+
+	level = 0;
+
+	while ( delta >= ( 1UL << ( EDF_WHEEL_SLOT_BITS * ( level + 1 ) ) ) )
+	{
+		++level;
+	}
+
+	slot = ( expiry >> ( EDF_WHEEL_SLOT_BITS * level ) ) & SLOT_MASK;
+
+	node->level = ( unsigned char )level;
+	node->slot = ( unsigned char )slot;
+	node->next = wheel->slots[ level ][ slot ];
+	node->pprev = &wheel->slots[ level ][ slot ];
+
+	if ( node->next )
+	{
+		node->next->pprev = &node->next;
+	}
+
+	wheel->slots[ level ][ slot ] = node;
+	wheel->occupied[ level ] |= SLOT_BIT( slot );
+}
+
+/*
+ * NAME:          cascade
+ *
+ * DESCRIPTION:   Called when the base crosses a level 0 boundary. Re-file the
+ *                higher level slots that now fall within reach of the lower
+ *                levels.
+ *
+ * PARAMETERS:
+ *  struct edf_release_wheel *wheel
+ *    - Pointer to the wheel.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void cascade( struct edf_release_wheel *wheel )
+{
+	unsigned int level;
+
+	for ( level = 1; level < EDF_WHEEL_LEVELS; ++level )
+	{
+		unsigned int slot = ( wheel->base >> ( EDF_WHEEL_SLOT_BITS * level ) ) & SLOT_MASK;
+
+		if ( wheel->occupied[ level ] & SLOT_BIT( slot ) )
+		{
+			// Detach the whole slot first, since its nodes are re-filed
+			// into the same wheel.
+			struct edf_wheel_node *node = wheel->slots[ level ][ slot ];
+
+			wheel->slots[ level ][ slot ] = 0;
+			wheel->occupied[ level ] &= ~SLOT_BIT( slot );
+
+			while ( node )
+			{
+				struct edf_wheel_node *next = node->next;
+
+				file_node( wheel, node );
+				node = next;
+			}
+		}
+
+		// Only carry into the next level when this level also wrapped.
+		if ( slot != 0 )
+		{
+			break;
+		}
+	}
+}
+
+/*
+ * See edf_release_wheel.h for comments.
+ */
+void edf_release_wheel_init( struct edf_release_wheel *wheel, unsigned long now )
+{
+	unsigned int level;
+	unsigned int slot;
+
+	for ( level = 0; level < EDF_WHEEL_LEVELS; ++level )
+	{
+		for ( slot = 0; slot < EDF_WHEEL_SLOTS; ++slot )
+		{
+			wheel->slots[ level ][ slot ] = 0;
+		}
+
+		wheel->occupied[ level ] = 0;
+	}
+
+	wheel->base = now;
+	wheel->length = 0;
+}
+
+/*
+ * See edf_release_wheel.h for comments.
+ */
+void edf_release_wheel_insert( struct edf_release_wheel *wheel, struct edf_wheel_node *node, unsigned long expiry )
+{
+	node->expiry = expiry;
+	file_node( wheel, node );
+	++wheel->length;
+}
+
+/*
+ * See edf_release_wheel.h for comments.
+ */
+void edf_release_wheel_remove( struct edf_release_wheel *wheel, struct edf_wheel_node *node )
+{
+	*node->pprev = node->next;
+
+	if ( node->next )
+	{
+		node->next->pprev = node->pprev;
+	}
+
+	if ( !wheel->slots[ node->level ][ node->slot ] )
+	{
+		wheel->occupied[ node->level ] &= ~SLOT_BIT( node->slot );
+	}
+
+	node->next = 0;
+	node->pprev = 0;
+	--wheel->length;
+}
+
+/*
+ * See edf_release_wheel.h for comments.
+ */
+struct edf_wheel_node *edf_release_wheel_advance( struct edf_release_wheel *wheel, unsigned long now )
+{
+	struct edf_wheel_node *released = 0;
+
+	while ( ( long )( wheel->base - now ) <= 0 )
+	{
+		unsigned int index = wheel->base & SLOT_MASK;
+		unsigned long later;
+		unsigned long next_base;
+
+		if ( index == 0 )
+		{
+			cascade( wheel );
+		}
+
+		if ( wheel->occupied[ 0 ] & SLOT_BIT( index ) )
+		{
+			// Everything in the current level 0 slot is due. Move the
+			// whole slot onto the released list.
+			struct edf_wheel_node *node = wheel->slots[ 0 ][ index ];
+
+			wheel->slots[ 0 ][ index ] = 0;
+			wheel->occupied[ 0 ] &= ~SLOT_BIT( index );
+
+			while ( node )
+			{
+				struct edf_wheel_node *next = node->next;
+
+				node->pprev = 0;
+				node->next = released;
+				released = node;
+				--wheel->length;
+				node = next;
+			}
+		}
+
+		// Skip straight to the next occupied level 0 slot, or to the next
+		// boundary (where higher levels may cascade) if there is none.
+		later = wheel->occupied[ 0 ] & ~( ( SLOT_BIT( index ) << 1 ) - 1UL );
+
+		if ( later )
+		{
+			next_base = ( wheel->base & ~( unsigned long )SLOT_MASK ) + count_trailing_zeros( later );
+		}
+		else
+		{
+			next_base = ( wheel->base | SLOT_MASK ) + 1;
+		}
+
+		if ( ( long )( next_base - now ) > 0 )
+		{
+			wheel->base = now + 1;
+			break;
+		}
+
+		wheel->base = next_base;
+	}
+
+	return released;
+}
+
+/*
+ * See edf_release_wheel.h for comments.
+ */
+unsigned long edf_release_wheel_next_expiry( struct edf_release_wheel *wheel )
+{
+	unsigned long next_expiry = EDF_WHEEL_NO_EXPIRY;
+	unsigned int level;
+
+	if ( wheel->length == 0 )
+	{
+		return EDF_WHEEL_NO_EXPIRY;
+	}
+
+	// Level 0 slots are single ticks, so this time is exact.
+	if ( wheel->occupied[ 0 ] )
+	{
+		next_expiry = wheel->base + first_occupied_from( wheel->occupied[ 0 ], wheel->base & SLOT_MASK );
+	}
+
+	// For higher levels, the start of the first occupied slot is when it
+	// cascades. Unless the base sits exactly on that level's boundary (the
+	// cascade is still to come), the slot holding the base has already been
+	// cascaded, so anything filed there is a full rotation away.
+	for ( level = 1; level < EDF_WHEEL_LEVELS; ++level )
+	{
+		unsigned int shift = EDF_WHEEL_SLOT_BITS * level;
+		unsigned int start = ( wheel->base >> shift ) & SLOT_MASK;
+		unsigned long offset = 0;
+		unsigned long cascade_time;
+
+		if ( !wheel->occupied[ level ] )
+		{
+			continue;
+		}
+
+		if ( wheel->base & ( ( 1UL << shift ) - 1UL ) )
+		{
+			start = ( start + 1 ) & SLOT_MASK;
+			offset = 1;
+		}
+
+		cascade_time = ( ( wheel->base >> shift ) + offset + first_occupied_from( wheel->occupied[ level ], start ) ) << shift;
+
+		if ( next_expiry == EDF_WHEEL_NO_EXPIRY || ( long )( cascade_time - next_expiry ) < 0 )
+		{
+			next_expiry = cascade_time;
+		}
+	}
+
+	return next_expiry;
+}
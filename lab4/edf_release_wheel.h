@@ -0,0 +1,159 @@
+#ifndef __EDF_RELEASE_WHEEL__
+#define __EDF_RELEASE_WHEEL__
+
+/*
+ * Number of levels in the wheel and log2 of the number of slots per level.
+ * Level 0 slots are 1 tick wide, level 1 slots are 32 ticks wide, and so on,
+ * so 4 levels of 32 slots cover 2^20 ticks (~17 minutes at 1 kHz). Releases
+ * further away than that are parked in the top level and re-filed when it
+ * cascades.
+ */
+#define EDF_WHEEL_LEVELS       4
+#define EDF_WHEEL_SLOT_BITS    5
+#define EDF_WHEEL_SLOTS        ( 1 << EDF_WHEEL_SLOT_BITS )
+
+/*
+ * Returned by edf_release_wheel_next_expiry when the wheel is empty.
+ */
+#define EDF_WHEEL_NO_EXPIRY    ( ~0UL )
+
+/*
+ * A release waiting in the wheel. Embedded in whatever is being released.
+ *
+ * MEMBERS:
+ *   struct edf_wheel_node *next
+ *     - Next node in the same slot (or in the list of expired nodes).
+ *   struct edf_wheel_node **pprev
+ *     - Pointer to the pointer that points to this node, so a node can be
+ *       removed without walking its slot.
+ *   unsigned long expiry
+ *     - Tick count at which the node is released.
+ *   unsigned char level
+ *   unsigned char slot
+ *     - Where the node is filed.
+ *   void *owner
+ *     - Object the node belongs to (the scheduler stores the task's list item
+ *       here).
+ */
+struct edf_wheel_node
+{
+	struct edf_wheel_node *next;
+	struct edf_wheel_node **pprev;
+	unsigned long expiry;
+	unsigned char level;
+	unsigned char slot;
+	void *owner;
+};
+
+/*
+ * Hierarchical timing wheel of release times.
+ *
+ * MEMBERS:
+ *   struct edf_wheel_node *slots[][]
+ *     - Head of the (unsorted) list of nodes in each slot.
+ *   unsigned long occupied[]
+ *     - Bitmap of the non-empty slots in each level, used to skip empty
+ *       slots without looking at them.
+ *   unsigned long base
+ *     - Next tick count that has not been processed yet.
+ *   unsigned int length
+ *     - Number of nodes in the wheel.
+ */
+struct edf_release_wheel
+{
+	struct edf_wheel_node *slots[ EDF_WHEEL_LEVELS ][ EDF_WHEEL_SLOTS ];
+	unsigned long occupied[ EDF_WHEEL_LEVELS ];
+	unsigned long base;
+	unsigned int length;
+};
+
+/*
+ * NAME:          edf_release_wheel_init
+ *
+ * DESCRIPTION:   Initialize an empty release wheel.
+ *
+ * PARAMETERS:
+ *  struct edf_release_wheel *wheel
+ *    - Pointer to the wheel.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_release_wheel_init( struct edf_release_wheel *, unsigned long );
+
+/*
+ * NAME:          edf_release_wheel_insert
+ *
+ * DESCRIPTION:   Add a node to be released at a given tick count. O(1). A
+ *                release time that has already passed is released on the
+ *                next call to edf_release_wheel_advance.
+ *
+ * PARAMETERS:
+ *  struct edf_release_wheel *wheel
+ *    - Pointer to the wheel.
+ *  struct edf_wheel_node *node
+ *    - Node to add (owner must already be set).
+ *  unsigned long expiry
+ *    - Tick count to release the node at.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_release_wheel_insert( struct edf_release_wheel *, struct edf_wheel_node *, unsigned long );
+
+/*
+ * NAME:          edf_release_wheel_remove
+ *
+ * DESCRIPTION:   Take a node out of the wheel before it is released. O(1).
+ *
+ * PARAMETERS:
+ *  struct edf_release_wheel *wheel
+ *    - Pointer to the wheel.
+ *  struct edf_wheel_node *node
+ *    - Node to remove.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_release_wheel_remove( struct edf_release_wheel *, struct edf_wheel_node * );
+
+/*
+ * NAME:          edf_release_wheel_advance
+ *
+ * DESCRIPTION:   Move the wheel forward to the current tick count and take out
+ *                every node whose release time has been reached. Only slots
+ *                that hold nodes are visited.
+ *
+ * PARAMETERS:
+ *  struct edf_release_wheel *wheel
+ *    - Pointer to the wheel.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  struct edf_wheel_node *
+ *    - List (linked through next) of released nodes, or 0 if none.
+ */
+struct edf_wheel_node *edf_release_wheel_advance( struct edf_release_wheel *, unsigned long );
+
+/*
+ * NAME:          edf_release_wheel_next_expiry
+ *
+ * DESCRIPTION:   Get the earliest tick count at which the wheel has to be
+ *                advanced again. This is exact for releases less than 32 ticks
+ *                away; for later releases it may be the time a higher level
+ *                slot has to be cascaded, which is never after the release.
+ *
+ * PARAMETERS:
+ *  struct edf_release_wheel *wheel
+ *    - Pointer to the wheel.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - Tick count, or EDF_WHEEL_NO_EXPIRY if the wheel is empty.
+ */
+unsigned long edf_release_wheel_next_expiry( struct edf_release_wheel * );
+
+#endif // __EDF_RELEASE_WHEEL__
@@ -2,184 +2,190 @@
 #include <stdio.h>
 
 /*
- * ****list.h did not implement a getter for owner so implemented here.*****
- * Access macro the retrieve the ownder of the list item.  The owner of a list
- * item is the object (usually a TCB) that contains the list item.
- *
- * \page listGET_LIST_ITEM_VALUE listGET_LIST_ITEM_VALUE
- * \ingroup LinkedList
- */
-#define _listGET_LIST_ITEM_OWNER( pxListItem ) ( ( pxListItem )->pvOwner )
-
-/*
- * Time between scheduler ask being executed.
+ * Time between scheduler ask being executed (quantum dispatch). In event
+ * driven dispatch, this is only the longest the scheduler sleeps when there is
+ * nothing to wait for.
  */
 #define SCHEDULER_PERIOD     ( 1000 / portTICK_RATE_MS ) // 1 s before restarting
 
 /*
- * NAME:          block_task
+ * NAME:          stop_task
  *
- * DESCRIPTION:   Block a task (suspend it and add to bloacked list).
+ * DESCRIPTION:   Suspend the current task and charge it for the ticks it ran
+ *                (see edf_policy_stop). A server still has work while its
+ *                request queue is not empty.
  *
  * PARAMETERS:
  *   struct edf_scheduler_data *edf_scheduler_data
  *     - Pointer to struct edf_scheduler_data.
- *  struct task_info *task
- *    - A Task.
+ *  struct tcb *tcb
+ *    - The current task.
+ *  portTickType ran
+ *    - Ticks the task ran.
+ *  portTickType tick_count
+ *    - Current tick count.
  *
  * RETURNS:
  *  N/A
  */
-static void block_task( struct edf_scheduler_data *edf_scheduler_data, xListItem *task )
+static void stop_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, portTickType ran, portTickType tick_count )
 {
-	struct tcb *tcb = ( struct tcb * )_listGET_LIST_ITEM_OWNER( task );
-	vTaskSuspend( tcb->handle );
+	int result;
 
-	// Set the restart time.
-	tcb->restart_time = listGET_LIST_ITEM_VALUE( task );
+	vTaskSuspend( tcb->handle );
 
-	// This task should be prepped to start again after a period of restarting.
-	// Since the task should start again at this time, it is also the deadline
-	// for the next execution.
-	listSET_LIST_ITEM_VALUE( task, tcb->restart_time + tcb->period );
+	if ( tcb->cbs )
+	{
+		// Servers run until they are out of requests, and are only held back
+		// by their budget.
+		struct edf_server *server = ( struct edf_server * )tcb;
 
-	// Reset elapsed time.
-	tcb->elapsed_time = 0;
+		result = edf_policy_stop_server( &edf_scheduler_data->policy, tcb, ran, tick_count,
+			uxQueueMessagesWaiting( server->requests ) != 0 );
+	}
+	else
+	{
+		result = edf_policy_stop( &edf_scheduler_data->policy, tcb, ran, tick_count );
+	}
 
-	// Add task to the blocked state.
-	vListInsert( &edf_scheduler_data->blocked_tasks_list, task );
+	// The tardiness of a miss is in the task's statistics.
+	EDF_TRACE( EDF_TRACE_PREEMPT + result, tcb->id );
 }
 
 /*
  * NAME:          resume_task
  *
- * DESCRIPTION:   Resume a task and increment it's elapsed time by the
- *                scheduler period, as after the scheduler runs again, it is
- *                not guaranteed that the task may continue to run (another task
- *                may then be set to run.
+ * DESCRIPTION:   Resume a task, and record the time it was resumed.
  *
  * PARAMETERS:
- *  struct task_info *task
+ *   struct edf_scheduler_data *edf_scheduler_data
+ *     - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
  *    - A Task.
+ *  portTickType tick_count
+ *    - Current tick count.
  *
  * RETURNS:
  *  N/A
  */
-static void resume_task( xListItem *task )
+static void resume_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, portTickType tick_count )
 {
-	struct tcb *tcb = ( struct tcb * )_listGET_LIST_ITEM_OWNER( task );
+#if EDF_MEASURED_EXECUTION_TIME
+	xTaskRunTimeStats run_time_stats;
 
-	// If the task is in a list, remove it from that list.
-	// (vListRemove will get the list that the task is in and then remove it).
-	vListRemove( task );
+	vTaskGetTaskRunTimeStats( tcb->handle, &run_time_stats );
+	edf_scheduler_data->dispatch_run_time = run_time_stats.ulRunTime;
+#endif
 
-	// Increment elapsed time
-	tcb->elapsed_time += SCHEDULER_PERIOD;
+	edf_scheduler_data->dispatch_time = tick_count;
 
-	vTaskResume( tcb->handle );
+	EDF_TRACE( EDF_TRACE_RESUME, tcb->id );
 
-	printf("Task #%d\n", tcb->id);
+	vTaskResume( tcb->handle );
 }
 
 /*
- * NAME:          get_next_task
+ * NAME:          check_sporadic_releases
  *
- * DESCRIPTION:   Get the next task that should be executed as per EDF
- *                Scheduler.
+ * DESCRIPTION:   Take the sporadic releases sent by release_sporadic_task
+ *                (and its ISR version) off the release queue and hand them to
+ *                the policy. Servers send themselves here when a request is
+ *                queued or they run out of work, and unlock_mutex sends 0.
  *
  * PARAMETERS:
  *   struct edf_scheduler_data *edf_scheduler_data
  *     - Pointer to struct edf_scheduler_data.
+ *  portTickType tick_count
+ *    - Current tick count.
  *
  * RETURNS:
- *  xListItem *
- *    - Pointer to the task that should be executed in the next slot.
+ *  N/A
  */
-static xListItem* get_next_task( struct edf_scheduler_data *edf_scheduler_data )
+static void check_sporadic_releases( struct edf_scheduler_data *edf_scheduler_data, portTickType tick_count )
 {
-	int i;
-	volatile xListItem *list_item;
-	xListItem *next_list_item;
-
-	if ( listLIST_IS_EMPTY( &edf_scheduler_data->ready_tasks_list ) )
-	{
-		return 0;
-	}
-
-	// xList stores a pointer to the tail (xListEnd), which holds a pointer
-	// back to the beginning (pxNext). (Circular array/buffer).
-	list_item = edf_scheduler_data->ready_tasks_list.xListEnd.pxNext;
-	next_list_item = ( xListItem * )list_item;
+	struct tcb *tcb;
 
-	// xList is sorted in ascending order by list item Value, so we only
-	// neex to check the first item. However, if the first item and second item
-	// have the same deadline, use the order T1 > T2 > T3 to break the tie.
-	for ( i = listCURRENT_LIST_LENGTH( &edf_scheduler_data->ready_tasks_list ); i != 0; --i )
+	while ( xQueueReceive( edf_scheduler_data->release_queue, &tcb, 0 ) == pdPASS )
 	{
-		if ( listGET_LIST_ITEM_VALUE( list_item ) == listGET_LIST_ITEM_VALUE( next_list_item ) )
+		if ( !tcb )
 		{
-			struct tcb *tcb_li = ( struct tcb * )_listGET_LIST_ITEM_OWNER( list_item );
-			struct tcb *tcb_nli = ( struct tcb * )_listGET_LIST_ITEM_OWNER( next_list_item );
+			// Sent by unlock_mutex just to wake the scheduler up.
+			continue;
+		}
 
-			if ( tcb_li->id < tcb_nli->id )
+		if ( tcb->cbs )
+		{
+			if ( uxQueueMessagesWaiting( ( ( struct edf_server * )tcb )->requests ) != 0 )
 			{
-				next_list_item = ( xListItem * )list_item;
+				edf_policy_wake_server( &edf_scheduler_data->policy, tcb, tick_count );
 			}
-
 		}
 		else
 		{
-			// Once the value changes, we know the value increased, so we
-			// break and do the task with the earliest deadline
-			break;
+			edf_policy_release_sporadic( &edf_scheduler_data->policy, tcb, tick_count );
 		}
-
-		list_item = list_item->pxNext;
 	}
-
-	return next_list_item;
 }
 
+#if EDF_MEASURED_EXECUTION_TIME
 /*
- * NAME:          check_blocked_tasks
+ * NAME:          get_measured_run_time
  *
- * DESCRIPTION:   Check the blocked list and see if any task can be unblocked.
+ * DESCRIPTION:   Get the CPU time the current task used since it was resumed,
+ *                rounded to the nearest tick. The task is suspended (or at
+ *                least not running), so its run time is up to date.
  *
  * PARAMETERS:
  *   struct edf_scheduler_data *edf_scheduler_data
  *     - Pointer to struct edf_scheduler_data.
  *
  * RETURNS:
- *  N/A
+ *  portTickType
+ *    - Ticks the task ran.
  */
-static void check_blocked_tasks( struct edf_scheduler_data *edf_scheduler_data )
+static portTickType get_measured_run_time( struct edf_scheduler_data *edf_scheduler_data )
 {
-	int i;
-	volatile xListItem *list_item;
-	portTickType tick_count;
+	xTaskRunTimeStats run_time_stats;
 
-	tick_count = xTaskGetTickCount();
+	vTaskGetTaskRunTimeStats( edf_scheduler_data->current_task->handle, &run_time_stats );
 
-	// xList stores a pointer to the tail (xListEnd), which holds a pointer
-	// back to the beginning (pxNext). (Circular array/buffer).
-	list_item = edf_scheduler_data->blocked_tasks_list.xListEnd.pxNext;
+	return ( portTickType )( ( run_time_stats.ulRunTime - edf_scheduler_data->dispatch_run_time + EDF_RUN_TIME_PER_TICK / 2 ) / EDF_RUN_TIME_PER_TICK );
+}
+#endif
 
-	for ( i = listCURRENT_LIST_LENGTH( &edf_scheduler_data->blocked_tasks_list ); i != 0; --i )
-	{
-		struct tcb *tcb = ( struct tcb * )_listGET_LIST_ITEM_OWNER( list_item );
+#if EDF_EVENT_DRIVEN_DISPATCH
+/*
+ * NAME:          get_wake_time
+ *
+ * DESCRIPTION:   Get the time the scheduler next has to run (see
+ *                edf_policy_wake_time), or a scheduler period from now if
+ *                nothing is due.
+ *
+ * PARAMETERS:
+ *   struct edf_scheduler_data *edf_scheduler_data
+ *     - Pointer to struct edf_scheduler_data.
+ *  portTickType tick_count
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  portTickType
+ *    - Tick count to wake up at.
+ */
+static portTickType get_wake_time( struct edf_scheduler_data *edf_scheduler_data, portTickType tick_count )
+{
+	unsigned long wake_time;
 
-		if ( tcb->restart_time <= tick_count )
-		{
-			// It is currently task's wake up time, or it has passed.
-			// So put it into the ready list now.
-			// Must cast to non-volatile xListItem* first
-			vListRemove( ( xListItem * )list_item );
-			vListInsert( &edf_scheduler_data->ready_tasks_list, ( xListItem * )list_item );
-		}
+	wake_time = edf_policy_wake_time( &edf_scheduler_data->policy, edf_scheduler_data->current_task, tick_count );
 
-		list_item = list_item->pxNext;
+	// Nothing to wait for, so just check again after a scheduler period.
+	if ( wake_time == EDF_NO_EVENT )
+	{
+		return tick_count + SCHEDULER_PERIOD;
 	}
+
+	return ( portTickType )wake_time;
 }
+#endif
 
 /*
  * NAME:          edf_scheduler
@@ -197,72 +203,588 @@ static void edf_scheduler( void *parameters )
 {
 	struct edf_scheduler_data *edf_scheduler_data = ( struct edf_scheduler_data *)parameters;
 
+#if EDF_EVENT_DRIVEN_DISPATCH
+	struct tcb *released;
+#else
 	/* Initialise xNextWakeTime - this only needs to be done once. */
 	portTickType next_wake_time = xTaskGetTickCount();
+#endif
 
 	for( ;; )
 	{
-		printf("Scheduler [%d]\n", next_wake_time);
+		portTickType tick_count = xTaskGetTickCount();
+
+		EDF_TRACE( EDF_TRACE_SCHEDULER, EDF_TRACE_NO_TASK );
 
 		// Check to see if tasks that are currently blocked should be
-		// unblocked.
-		check_blocked_tasks( edf_scheduler_data );
+		// unblocked, and if any sporadic tasks were released.
+		edf_policy_advance( &edf_scheduler_data->policy, tick_count );
+		check_sporadic_releases( edf_scheduler_data, tick_count );
 
 		if ( edf_scheduler_data->current_task )
 		{
-			struct tcb *tcb = ( struct tcb * )_listGET_LIST_ITEM_OWNER( edf_scheduler_data->current_task );
-
-			if ( tcb->elapsed_time  >= tcb->execution_time )
-			{
-				// Current task has completed executing.
-				block_task( edf_scheduler_data, edf_scheduler_data->current_task );
-			}
-			else
-			{
-				// Task needs to continue to be done, but suspend it for now
-				// so other running tasks have a change at executing aswell.
-				vTaskSuspend( tcb->handle );
-				vListInsert ( &edf_scheduler_data->ready_tasks_list, edf_scheduler_data->current_task );
-			}
+#if EDF_MEASURED_EXECUTION_TIME
+			// Charge the task for the CPU time it used since it was resumed.
+			portTickType ran = get_measured_run_time( edf_scheduler_data );
+#elif EDF_EVENT_DRIVEN_DISPATCH
+			// Charge the task for the ticks it ran since it was resumed.
+			portTickType ran = tick_count - edf_scheduler_data->dispatch_time;
+#else
+			// It is not guaranteed that the task ran for the whole period,
+			// but it is charged for it anyway.
+			portTickType ran = SCHEDULER_PERIOD;
+#endif
+
+			stop_task( edf_scheduler_data, edf_scheduler_data->current_task, ran, tick_count );
 		}
 
-		edf_scheduler_data->current_task = get_next_task( edf_scheduler_data );
+		edf_scheduler_data->current_task = edf_policy_next( &edf_scheduler_data->policy );
 
 		if ( edf_scheduler_data->current_task )
 		{
-			resume_task( edf_scheduler_data->current_task );
+			resume_task( edf_scheduler_data, edf_scheduler_data->current_task, tick_count );
 		}
 
+#if EDF_EVENT_DRIVEN_DISPATCH
+		// Block scheduler until the next task is released, the current task
+		// runs out of execution time, or a sporadic release is queued. If
+		// that time has already passed, the scheduler runs again straight
+		// away. The release is only peeked at here and taken off the queue at
+		// the top of the loop.
+		edf_scheduler_data->wake_time = get_wake_time( edf_scheduler_data, tick_count );
+		tick_count = xTaskGetTickCount();
+		xQueuePeek( edf_scheduler_data->release_queue, &released,
+			( ( long )( edf_scheduler_data->wake_time - tick_count ) > 0 ) ? edf_scheduler_data->wake_time - tick_count : 0 );
+#else
 		// Block scheduler until next period.
+		edf_scheduler_data->wake_time = next_wake_time + SCHEDULER_PERIOD;
 		vTaskDelayUntil( &next_wake_time, SCHEDULER_PERIOD );
+#endif
 	}
 }
 
+/*
+ * NAME:          set_task_params
+ *
+ * DESCRIPTION:   Fill in the timing parameters of a task that does not use
+ *                any shared resources yet (see use_mutex).
+ *
+ * PARAMETERS:
+ *  struct edf_task_params *params
+ *    - Parameters to fill in.
+ *  unsigned int execution_time
+ *    - Execution time of the task.
+ *  unsigned int deadline
+ *    - Relative deadline of the task.
+ *  unsigned int period
+ *    - Period of the task.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void set_task_params( struct edf_task_params *params, unsigned int execution_time, unsigned int deadline, unsigned int period )
+{
+	params->execution_time = execution_time;
+	params->deadline = deadline;
+	params->period = period;
+	params->critical_section = 0;
+	params->ceiling = EDF_NO_CEILING;
+}
+
+/*
+ * NAME:          add_task
+ *
+ * DESCRIPTION:   Add a task to the task list, and its timing parameters to
+ *                the admitted task set.
+ *
+ * PARAMETERS:
+ *   struct edf_scheduler_data *edf_scheduler_data
+ *     - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
+ *    - Pointer to the task's tcb.
+ *  struct edf_task_params *params
+ *    - Timing parameters of the task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task was added, 0 if the task list is full.
+ */
+static int add_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, struct edf_task_params *params )
+{
+	// Check for room before the admitted task set counts the task's
+	// utilisation, so a task that is turned away leaves no trace.
+	if ( edf_scheduler_data->num_tasks >= EDF_MAX_TASKS || !edf_admission_add( &edf_scheduler_data->admission, params ) )
+	{
+		return 0;
+	}
+
+	edf_scheduler_data->tasks[ edf_scheduler_data->num_tasks++ ] = tcb;
+
+	return 1;
+}
+
+/*
+ * NAME:          admit
+ *
+ * DESCRIPTION:   Run the admission test for a task and set it up if it passes.
+ *                A periodic task is released the next time the scheduler
+ *                runs; a sporadic task waits for its first release.
+ *
+ * PARAMETERS:
+ *   struct edf_scheduler_data *edf_scheduler_data
+ *     - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
+ *    - Pointer to the task's tcb.
+ *  struct edf_task_params *params
+ *    - Timing parameters of the task.
+ *  unsigned int id
+ *    - ID for a task.
+ *  unsigned int sporadic
+ *    - 1 for a sporadic task, 0 for a periodic task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task was admitted, 0 if it was rejected.
+ */
+static int admit( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, struct edf_task_params *params, unsigned int id, unsigned int sporadic )
+{
+	int admitted;
+
+	// Keep the scheduler task from running while the task set is changed.
+	vTaskSuspendAll();
+
+	admitted = edf_admission_test( &edf_scheduler_data->admission, params ) &&
+	           add_task( edf_scheduler_data, tcb, params );
+
+	if ( admitted )
+	{
+		edf_policy_setup_task( tcb, params, id, sporadic, xTaskGetTickCount() );
+
+		if ( !sporadic )
+		{
+			// The scheduler may be asleep, so release the task the next
+			// time it runs.
+			edf_policy_release( &edf_scheduler_data->policy, tcb, edf_scheduler_data->wake_time, xTaskGetTickCount() );
+		}
+
+		vTaskSuspend( tcb->handle );
+	}
+
+	xTaskResumeAll();
+
+	return admitted;
+}
+
 /*
  * Task Initializer
  */
-void initialize_task( struct edf_scheduler_data *edf_scheduler_data, xListItem *list_item, struct tcb *tcb, unsigned int id, unsigned int execution_time, unsigned int period )
+int initialize_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, unsigned int id, unsigned int execution_time, unsigned int deadline, unsigned int period )
 {
-	tcb->id = id;
-	tcb->execution_time = execution_time;
-	tcb->period = period;
-	tcb->elapsed_time = 0;
-	tcb->restart_time = 0;
+	struct edf_task_params params;
 
-	// Initialize the list item before using it.
-	vListInitialiseItem( list_item );
+	set_task_params( &params, execution_time, deadline, period );
 
-	// ListItem Owner is used to hold the tcb details.
-	listSET_LIST_ITEM_OWNER( list_item, tcb );
+	if ( !add_task( edf_scheduler_data, tcb, &params ) )
+	{
+		return 0;
+	}
 
-	// ListItem Value is used to hold the time when task should be unblocked.
-	listSET_LIST_ITEM_VALUE( list_item, period );
+	edf_policy_setup_task( tcb, &params, id, 0, 0 );
 
-	// Add task to ready list.
-	vListInsert( &edf_scheduler_data->ready_tasks_list, list_item );
+	// The task is released at time 0, so add it to the ready queue.
+	edf_policy_release( &edf_scheduler_data->policy, tcb, 0, 0 );
 
 	// Initially, task should be in a suspended state.
 	vTaskSuspend( tcb->handle );
+
+	return 1;
+}
+
+/*
+ * Sporadic Task Initializer
+ */
+int initialize_sporadic_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, unsigned int id, unsigned int execution_time, unsigned int deadline, unsigned int min_interarrival_time )
+{
+	struct edf_task_params params;
+
+	set_task_params( &params, execution_time, deadline, min_interarrival_time );
+
+	if ( !add_task( edf_scheduler_data, tcb, &params ) )
+	{
+		return 0;
+	}
+
+	edf_policy_setup_task( tcb, &params, id, 1, xTaskGetTickCount() );
+
+	// Suspended until the first release.
+	vTaskSuspend( tcb->handle );
+
+	return 1;
+}
+
+/*
+ * Task Admission
+ */
+int admit_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, unsigned int id, unsigned int execution_time, unsigned int deadline, unsigned int period )
+{
+	struct edf_task_params params;
+
+	set_task_params( &params, execution_time, deadline, period );
+
+	return admit( edf_scheduler_data, tcb, &params, id, 0 );
+}
+
+/*
+ * Sporadic Task Admission
+ */
+int admit_sporadic_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, unsigned int id, unsigned int execution_time, unsigned int deadline, unsigned int min_interarrival_time )
+{
+	struct edf_task_params params;
+
+	set_task_params( &params, execution_time, deadline, min_interarrival_time );
+
+	return admit( edf_scheduler_data, tcb, &params, id, 1 );
+}
+
+/*
+ * Sporadic Task Release
+ */
+int release_sporadic_task( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb )
+{
+	EDF_TRACE( EDF_TRACE_RELEASE, tcb->id );
+
+	return xQueueSend( edf_scheduler_data->release_queue, &tcb, 0 ) == pdPASS;
+}
+
+/*
+ * Sporadic Task Release (ISR)
+ */
+int release_sporadic_task_from_isr( struct edf_scheduler_data *edf_scheduler_data, struct tcb *tcb, signed portBASE_TYPE *higher_priority_task_woken )
+{
+	EDF_TRACE( EDF_TRACE_RELEASE, tcb->id );
+
+	return xQueueSendFromISR( edf_scheduler_data->release_queue, &tcb, higher_priority_task_woken ) == pdPASS;
+}
+
+/*
+ * NAME:          server_task
+ *
+ * DESCRIPTION:   Task of a Constant Bandwidth Server. Runs the requests queued
+ *                to the server in order, and tells the scheduler when there
+ *                are none left.
+ *
+ * PARAMETERS:
+ *  void *parameters
+ *    - The server.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void server_task( void *parameters )
+{
+	struct edf_server *server = ( struct edf_server * )parameters;
+	struct tcb *tcb = &server->tcb;
+	struct edf_request request;
+
+	for( ;; )
+	{
+		// Leave the request on the queue while it runs, so the scheduler can
+		// see the server still has work.
+		xQueuePeek( server->requests, &request, portMAX_DELAY );
+		request.function( request.parameter );
+		xQueueReceive( server->requests, &request, 0 );
+
+		if ( uxQueueMessagesWaiting( server->requests ) == 0 )
+		{
+			// Wake the scheduler up to give the rest of the budget away.
+			xQueueSend( server->scheduler->release_queue, &tcb, 0 );
+		}
+	}
+}
+
+/*
+ * NAME:          setup_server
+ *
+ * DESCRIPTION:   Create a server's request queue and task, and set it up as
+ *                an idle task.
+ *
+ * PARAMETERS:
+ *   struct edf_scheduler_data *edf_scheduler_data
+ *     - Pointer to struct edf_scheduler_data.
+ *  struct edf_server *server
+ *    - Pointer to the server.
+ *  struct edf_task_params *params
+ *    - Budget and period of the server.
+ *  unsigned int id
+ *    - ID for the server's task.
+ *  unsigned int queue_length
+ *    - Number of requests that can be waiting (at most
+ *      EDF_SERVER_QUEUE_LENGTH without a heap).
+ *  unsigned int priority
+ *    - FreeRTOS priority of the server's task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the server was set up, 0 if the task list is full or its queue
+ *      or task could not be created.
+ */
+static int setup_server( struct edf_scheduler_data *edf_scheduler_data, struct edf_server *server, struct edf_task_params *params, unsigned int id, unsigned int queue_length, unsigned int priority )
+{
+	// Check for room before anything is created for the server, so that
+	// add_task cannot fail below.
+	if ( edf_scheduler_data->num_tasks >= EDF_MAX_TASKS )
+	{
+		return 0;
+	}
+
+#if configSUPPORT_STATIC_ALLOCATION
+	if ( queue_length > EDF_SERVER_QUEUE_LENGTH )
+	{
+		return 0;
+	}
+
+	server->requests = xQueueCreateStatic( queue_length, sizeof( struct edf_request ), ( unsigned char * )server->requests_storage, &server->requests_buffer );
+#else
+	server->requests = xQueueCreate( queue_length, sizeof( struct edf_request ) );
+#endif
+
+	if ( !server->requests )
+	{
+		return 0;
+	}
+
+	server->scheduler = edf_scheduler_data;
+
+#if configSUPPORT_STATIC_ALLOCATION
+	if ( xTaskCreateStatic( server_task, ( const signed char * )"server", configMINIMAL_STACK_SIZE, ( void * )server, priority, &server->tcb.handle, server->stack, &server->task_buffer ) != pdPASS )
+#else
+	if ( xTaskCreate( server_task, ( const signed char * )"server", configMINIMAL_STACK_SIZE, ( void * )server, priority, &server->tcb.handle ) != pdPASS )
+#endif
+	{
+		return 0;
+	}
+
+	edf_policy_setup_server( &server->tcb, &server->cbs, params, id, xTaskGetTickCount() );
+	add_task( edf_scheduler_data, &server->tcb, params );
+
+	// Suspended until the first request.
+	vTaskSuspend( server->tcb.handle );
+
+	return 1;
+}
+
+/*
+ * Server Initializer
+ */
+int initialize_server( struct edf_scheduler_data *edf_scheduler_data, struct edf_server *server, unsigned int id, unsigned int budget, unsigned int period, unsigned int queue_length, unsigned int priority )
+{
+	struct edf_task_params params;
+
+	set_task_params( &params, budget, period, period );
+
+	return setup_server( edf_scheduler_data, server, &params, id, queue_length, priority );
+}
+
+/*
+ * Server Admission
+ */
+int admit_server( struct edf_scheduler_data *edf_scheduler_data, struct edf_server *server, unsigned int id, unsigned int budget, unsigned int period, unsigned int queue_length, unsigned int priority )
+{
+	struct edf_task_params params;
+	int admitted;
+
+	set_task_params( &params, budget, period, period );
+
+	// Keep the scheduler task (and the new server task) from running while
+	// the task set is changed.
+	vTaskSuspendAll();
+
+	admitted = edf_admission_test( &edf_scheduler_data->admission, &params ) &&
+	           setup_server( edf_scheduler_data, server, &params, id, queue_length, priority );
+
+	xTaskResumeAll();
+
+	return admitted;
+}
+
+/*
+ * Server Request
+ */
+int submit_request( struct edf_server *server, void ( *function )( void * ), void *parameter )
+{
+	struct tcb *tcb = &server->tcb;
+	struct edf_request request;
+
+	request.function = function;
+	request.parameter = parameter;
+
+	if ( xQueueSend( server->requests, &request, 0 ) != pdPASS )
+	{
+		return 0;
+	}
+
+	EDF_TRACE( EDF_TRACE_RELEASE, tcb->id );
+
+	// Let the scheduler wake the server up if it is idle.
+	xQueueSend( server->scheduler->release_queue, &tcb, 0 );
+
+	return 1;
+}
+
+/*
+ * Server Request (ISR)
+ */
+int submit_request_from_isr( struct edf_server *server, void ( *function )( void * ), void *parameter, signed portBASE_TYPE *higher_priority_task_woken )
+{
+	struct tcb *tcb = &server->tcb;
+	struct edf_request request;
+
+	request.function = function;
+	request.parameter = parameter;
+
+	if ( xQueueSendFromISR( server->requests, &request, higher_priority_task_woken ) != pdPASS )
+	{
+		return 0;
+	}
+
+	EDF_TRACE( EDF_TRACE_RELEASE, tcb->id );
+	xQueueSendFromISR( server->scheduler->release_queue, &tcb, higher_priority_task_woken );
+
+	return 1;
+}
+
+/*
+ * Mutex Initializer
+ */
+void initialize_mutex( struct edf_mutex *mutex )
+{
+	mutex->ceiling = EDF_NO_CEILING;
+	mutex->previous_ceiling = EDF_NO_CEILING;
+	mutex->users = 0;
+}
+
+/*
+ * Mutex Use
+ */
+int use_mutex( struct edf_scheduler_data *edf_scheduler_data, struct edf_mutex *mutex, struct tcb *tcb, unsigned int critical_section )
+{
+	struct edf_resource_use use;
+	unsigned int i;
+	int admitted = 0;
+
+	vTaskSuspendAll();
+
+	// The index of the task in tasks[] is also its index in the admitted set.
+	for ( i = 0; i < edf_scheduler_data->num_tasks && edf_scheduler_data->tasks[ i ] != tcb; ++i );
+
+	if ( i < edf_scheduler_data->num_tasks && i < sizeof( mutex->users ) * 8 )
+	{
+		use.task = i;
+		use.critical_section = critical_section;
+		use.ceiling = ( tcb->deadline < mutex->ceiling ) ? tcb->deadline : mutex->ceiling;
+		use.users = mutex->users;
+
+		admitted = edf_admission_test_resource( &edf_scheduler_data->admission, &use );
+
+		if ( admitted )
+		{
+			edf_admission_add_resource( &edf_scheduler_data->admission, &use );
+			mutex->ceiling = use.ceiling;
+			mutex->users |= 1UL << i;
+		}
+	}
+
+	xTaskResumeAll();
+
+	return admitted;
+}
+
+/*
+ * Mutex Lock
+ */
+void lock_mutex( struct edf_scheduler_data *edf_scheduler_data, struct edf_mutex *mutex )
+{
+	// Under SRP the mutex is always free here, so locking only raises the
+	// system ceiling.
+	taskENTER_CRITICAL();
+	mutex->previous_ceiling = edf_scheduler_data->policy.system_ceiling;
+
+	if ( mutex->ceiling < edf_scheduler_data->policy.system_ceiling )
+	{
+		edf_scheduler_data->policy.system_ceiling = mutex->ceiling;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*
+ * Mutex Unlock
+ */
+void unlock_mutex( struct edf_scheduler_data *edf_scheduler_data, struct edf_mutex *mutex )
+{
+	struct tcb *none = 0;
+
+	taskENTER_CRITICAL();
+	edf_scheduler_data->policy.system_ceiling = mutex->previous_ceiling;
+	taskEXIT_CRITICAL();
+
+	// Jobs held back by the ceiling may be able to preempt now.
+	xQueueSend( edf_scheduler_data->release_queue, &none, 0 );
+}
+
+/*
+ * Task statistics.
+ */
+void get_task_stats( struct tcb *tcb, struct edf_task_stats *stats )
+{
+	// The scheduler task updates the statistics, so keep it out while
+	// copying.
+	taskENTER_CRITICAL();
+	*stats = tcb->stats;
+	taskEXIT_CRITICAL();
+}
+
+/*
+ * Print task statistics.
+ */
+void print_task_stats( struct edf_scheduler_data *edf_scheduler_data )
+{
+	unsigned int i;
+	unsigned int bucket;
+
+	for ( i = 0; i < edf_scheduler_data->num_tasks; ++i )
+	{
+		struct tcb *tcb = edf_scheduler_data->tasks[ i ];
+		struct edf_task_stats stats;
+
+		get_task_stats( tcb, &stats );
+
+		printf("Task #%d: jobs %d misses %d overruns %d worst response %d tardiness %lu\n",
+			tcb->id, stats.jobs, stats.misses, stats.overruns, stats.worst_response_time, stats.total_tardiness);
+
+		// Histogram, one "<upper bound>:<count>" per non-empty bucket.
+		printf("  response");
+
+		for ( bucket = 0; bucket < EDF_STATS_HISTOGRAM_BUCKETS; ++bucket )
+		{
+			if ( stats.response_histogram[ bucket ] )
+			{
+				printf(" <%u:%u", 1u << bucket, stats.response_histogram[ bucket ]);
+			}
+		}
+
+		printf("\n");
+
+#if configGENERATE_RUN_TIME_STATS
+		{
+			xTaskRunTimeStats run_time_stats;
+
+			vTaskGetTaskRunTimeStats( tcb->handle, &run_time_stats );
+
+			printf("  cpu %lu cycles, switched in %lu times, longest run %lu cycles\n",
+				run_time_stats.ulRunTime, run_time_stats.ulSwitchInCount, run_time_stats.ulLongestRun);
+		}
+#endif
+	}
 }
 
 /*
@@ -270,8 +792,20 @@ void initialize_task( struct edf_scheduler_data *edf_scheduler_data, xListItem *
  */
 void initialize_edf_scheduler( struct edf_scheduler_data *edf_scheduler_data, unsigned int priority )
 {
-	xTaskCreate( edf_scheduler, "edf_scheduler", configMINIMAL_STACK_SIZE, ( void * )edf_scheduler_data, priority, NULL );
-
-	vListInitialise( &edf_scheduler_data->ready_tasks_list );
-	vListInitialise( &edf_scheduler_data->blocked_tasks_list );
+#if configSUPPORT_STATIC_ALLOCATION
+	xTaskCreateStatic( edf_scheduler, ( const signed char * )"edf_scheduler", configMINIMAL_STACK_SIZE, ( void * )edf_scheduler_data, priority, NULL, edf_scheduler_data->stack, &edf_scheduler_data->task_buffer );
+#else
+	xTaskCreate( edf_scheduler, ( const signed char * )"edf_scheduler", configMINIMAL_STACK_SIZE, ( void * )edf_scheduler_data, priority, NULL );
+#endif
+
+	edf_trace_init();
+	edf_policy_init( &edf_scheduler_data->policy, xTaskGetTickCount() );
+	edf_admission_init( &edf_scheduler_data->admission );
+	edf_scheduler_data->wake_time = xTaskGetTickCount();
+	edf_scheduler_data->num_tasks = 0;
+#if configSUPPORT_STATIC_ALLOCATION
+	edf_scheduler_data->release_queue = xQueueCreateStatic( RELEASE_QUEUE_LENGTH, sizeof( struct tcb * ), ( unsigned char * )edf_scheduler_data->release_queue_storage, &edf_scheduler_data->release_queue_buffer );
+#else
+	edf_scheduler_data->release_queue = xQueueCreate( RELEASE_QUEUE_LENGTH, sizeof( struct tcb * ) );
+#endif
 }
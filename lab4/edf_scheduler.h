@@ -3,38 +3,183 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "list.h"
+#include "queue.h"
+#include "edf_policy.h"
+#include "edf_trace.h"
+
+/*
+ * Set to 1 to have the scheduler sleep until the next task is released or the
+ * current task runs out of execution time (tasks are charged the ticks they
+ * actually ran). Set to 0 to run the scheduler every SCHEDULER_PERIOD and
+ * charge the current task a full period each time (quantum dispatch).
+ */
+#ifndef EDF_EVENT_DRIVEN_DISPATCH
+#define EDF_EVENT_DRIVEN_DISPATCH    1
+#endif
+
+/*
+ * Set to 1 to charge tasks for the CPU time they were measured to use (the
+ * kernel's run time stats, rounded to the nearest tick) rather than the ticks
+ * that passed while they were resumed, so time the scheduler task takes, or a
+ * task spends blocked, is not charged to it. Needs event driven dispatch and
+ * configGENERATE_RUN_TIME_STATS.
+ */
+#ifndef EDF_MEASURED_EXECUTION_TIME
+#define EDF_MEASURED_EXECUTION_TIME  ( EDF_EVENT_DRIVEN_DISPATCH && configGENERATE_RUN_TIME_STATS )
+#endif
+
+/*
+ * Run time counter units per tick (CPU cycles, when the counter is the DWT
+ * cycle counter).
+ */
+#ifndef EDF_RUN_TIME_PER_TICK
+#define EDF_RUN_TIME_PER_TICK        ( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+#endif
+
+/*
+ * Number of sporadic releases that can be waiting for the scheduler to pick
+ * them up.
+ */
+#ifndef RELEASE_QUEUE_LENGTH
+#define RELEASE_QUEUE_LENGTH         8
+#endif
+
+/*
+ * Most requests that can be waiting for a server when the kernel is built
+ * without a heap (configSUPPORT_STATIC_ALLOCATION), as the request queue is
+ * then part of struct edf_server.
+ */
+#ifndef EDF_SERVER_QUEUE_LENGTH
+#define EDF_SERVER_QUEUE_LENGTH      4
+#endif
 
 /*
  * Data for the EDF scheduler to function
  *
  * MEMBERS:
- *   xList ready_tasks_list
- *     - List to keep track of tasks that are ready to execute.
- *   xList blocked_tasks_list
- *     - List to keep track of tasks that are not ready to execute (wakting for a
- *       wake up time to pass).
- *   xList *current_task
- *     - Pointer to current task's list item.
+ *   struct edf_policy policy
+ *     - Ready queue, blocked wheel and system ceiling (see edf_policy.h).
+ *   struct tcb *current_task
+ *     - Task that is currently resumed, or 0.
+ *   portTickType dispatch_time
+ *     - Tick count when the current task was last resumed.
+ *   unsigned long dispatch_run_time
+ *     - Run time of the current task when it was last resumed
+ *       (EDF_MEASURED_EXECUTION_TIME).
+ *   portTickType wake_time
+ *     - Tick count when the scheduler will next run.
+ *   struct edf_admission admission
+ *     - Timing parameters of every task given to the scheduler, used to test
+ *       whether new tasks can be admitted.
+ *   struct tcb *tasks[]
+ *     - Every task given to the scheduler.
+ *   unsigned int num_tasks
+ *     - Number of tasks given to the scheduler.
+ *   xQueueHandle release_queue
+ *     - Sporadic releases (struct tcb *) waiting for the scheduler. In event
+ *       driven dispatch, the scheduler also sleeps on this queue so a release
+ *       wakes it up.
+ *   xStaticTask task_buffer, portSTACK_TYPE stack[], xStaticQueue
+ *   release_queue_buffer, struct tcb *release_queue_storage[]
+ *     - Memory for the scheduler task and release queue, when the kernel is
+ *       built without a heap.
  */
 struct edf_scheduler_data
 {
-	xList ready_tasks_list;
-	xList blocked_tasks_list;
-	xListItem *current_task;
+	struct edf_policy policy;
+	struct tcb *current_task;
+	portTickType dispatch_time;
+#if EDF_MEASURED_EXECUTION_TIME
+	unsigned long dispatch_run_time;
+#endif
+	portTickType wake_time;
+	struct edf_admission admission;
+	struct tcb *tasks[ EDF_MAX_TASKS ];
+	unsigned int num_tasks;
+	xQueueHandle release_queue;
+#if configSUPPORT_STATIC_ALLOCATION
+	xStaticTask task_buffer;
+	portSTACK_TYPE stack[ configMINIMAL_STACK_SIZE ];
+	xStaticQueue release_queue_buffer;
+	struct tcb *release_queue_storage[ RELEASE_QUEUE_LENGTH ];
+#endif
+};
+
+/*
+ * A piece of aperiodic work queued to a server.
+ *
+ * MEMBERS:
+ *   void ( *function )( void * )
+ *     - Function to call.
+ *   void *parameter
+ *     - Parameter to pass to it.
+ */
+struct edf_request
+{
+	void ( *function )( void * );
+	void *parameter;
+};
+
+/*
+ * Constant Bandwidth Server. A server task runs the requests queued to it, one
+ * after the other, and is scheduled by EDF with the server's deadline. It is
+ * only charged while it has requests to run, and it never takes more than
+ * budget / period of the CPU, so aperiodic work (display updates, logging)
+ * gets bounded latency without breaking the guarantees of the other tasks.
+ *
+ * MEMBERS:
+ *   struct tcb tcb
+ *     - The server task's tcb (execution_time is the budget). Must be the
+ *       first member, so the scheduler can get from the tcb to the server.
+ *   struct edf_cbs cbs
+ *     - Budget and deadline of the server.
+ *   xQueueHandle requests
+ *     - Requests waiting to run. A request stays at the front of the queue
+ *       while it runs, so the server has work as long as the queue is not
+ *       empty.
+ *   struct edf_scheduler_data *scheduler
+ *     - The scheduler the server belongs to.
+ *   xStaticTask task_buffer, portSTACK_TYPE stack[], xStaticQueue
+ *   requests_buffer, struct edf_request requests_storage[]
+ *     - Memory for the server task and request queue, when the kernel is
+ *       built without a heap.
+ */
+struct edf_server
+{
+	struct tcb tcb;
+	struct edf_cbs cbs;
+	xQueueHandle requests;
+	struct edf_scheduler_data *scheduler;
+#if configSUPPORT_STATIC_ALLOCATION
+	xStaticTask task_buffer;
+	portSTACK_TYPE stack[ configMINIMAL_STACK_SIZE ];
+	xStaticQueue requests_buffer;
+	struct edf_request requests_storage[ EDF_SERVER_QUEUE_LENGTH ];
+#endif
 };
 
 /*
- * Task Control Buffer.
+ * Mutex under the Stack Resource Policy (Baker). Preemption levels come from
+ * relative deadlines (shorter deadline, higher level), and the ceiling of a
+ * mutex is the shortest relative deadline of the tasks that use it. A job only
+ * starts once its level is above the ceiling of every locked mutex, so a job
+ * is blocked at most once, for one critical section of a task with a later
+ * deadline, and mutexes never have to wait or deadlock.
+ *
+ * MEMBERS:
+ *   unsigned long ceiling
+ *     - Ceiling of the mutex.
+ *   unsigned long previous_ceiling
+ *     - System ceiling before the mutex was locked.
+ *   unsigned long users
+ *     - Bitmap (by order added to the scheduler) of the tasks that use the
+ *       mutex.
  */
-struct tcb
+struct edf_mutex
 {
-	unsigned int id;
-	unsigned int execution_time;
-	unsigned int period;
-	unsigned int elapsed_time;
-	unsigned int restart_time;
-	xTaskHandle handle;
+	unsigned long ceiling;
+	unsigned long previous_ceiling;
+	unsigned long users;
 };
 
 /*
@@ -43,23 +188,353 @@ struct tcb
  * DESCRIPTION:   Initialize task info for a task.
  *
  * PARAMETERS:
- *  xListItem *list_item
- *    - Pointer to a xListItem.
  *  struct task_info *task_info
  *    - Pointer to a task_info struct.
  *  unsigned int id
  *    - ID for a task.
  *  unsigned int execution_time
  *    - Execution time of a task.
+ *  unsigned int deadline
+ *    - Deadline of a task, relative to each release (at most the period).
+ *  unsigned int period
+ *    - Period (time between restarting) of a task.
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task was added, 0 if the scheduler already has
+ *      EDF_MAX_TASKS tasks.
+ */
+int initialize_task( struct edf_scheduler_data *, struct tcb *, unsigned int, unsigned int, unsigned int, unsigned int );
+
+/*
+ * NAME:          initialize_sporadic_task
+ *
+ * DESCRIPTION:   Initialize a sporadic task. It does not run until it is
+ *                released with release_sporadic_task or
+ *                release_sporadic_task_from_isr.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
+ *    - Pointer to the task's tcb (handle must already be set).
+ *  unsigned int id
+ *    - ID for a task.
+ *  unsigned int execution_time
+ *    - Execution time of a task.
+ *  unsigned int deadline
+ *    - Deadline of a task, relative to each release.
+ *  unsigned int min_interarrival_time
+ *    - Minimum time between releases. Releases that come sooner are held
+ *      back until this time has passed.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task was added, 0 if the scheduler already has
+ *      EDF_MAX_TASKS tasks.
+ */
+int initialize_sporadic_task( struct edf_scheduler_data *, struct tcb *, unsigned int, unsigned int, unsigned int, unsigned int );
+
+/*
+ * NAME:          admit_task
+ *
+ * DESCRIPTION:   Add a task to the scheduler only if the task set stays
+ *                schedulable under EDF. The test is O(1) (total utilisation)
+ *                while every deadline equals its period, and falls back to
+ *                processor demand analysis otherwise. Can be called before or
+ *                while the scheduler is running; an admitted task is released
+ *                the next time the scheduler runs. A rejected task is left
+ *                untouched.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
+ *    - Pointer to the task's tcb (handle must already be set).
+ *  unsigned int id
+ *    - ID for a task.
+ *  unsigned int execution_time
+ *    - Execution time of a task.
+ *  unsigned int deadline
+ *    - Deadline of a task, relative to each release.
  *  unsigned int period
  *    - Period (time between restarting) of a task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task was admitted, 0 if it was rejected.
+ */
+int admit_task( struct edf_scheduler_data *, struct tcb *, unsigned int, unsigned int, unsigned int, unsigned int );
+
+/*
+ * NAME:          admit_sporadic_task
+ *
+ * DESCRIPTION:   Add a sporadic task to the scheduler only if the task set
+ *                stays schedulable under EDF (the minimum inter-arrival time
+ *                is treated as the period). An admitted task waits for its
+ *                first release.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
+ *    - Pointer to the task's tcb (handle must already be set).
+ *  unsigned int id
+ *    - ID for a task.
+ *  unsigned int execution_time
+ *    - Execution time of a task.
+ *  unsigned int deadline
+ *    - Deadline of a task, relative to each release.
+ *  unsigned int min_interarrival_time
+ *    - Minimum time between releases.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task was admitted, 0 if it was rejected.
+ */
+int admit_sporadic_task( struct edf_scheduler_data *, struct tcb *, unsigned int, unsigned int, unsigned int, unsigned int );
+
+/*
+ * NAME:          release_sporadic_task
+ *
+ * DESCRIPTION:   Release a job of a sporadic task. Its deadline is counted
+ *                from when the scheduler accepts the release (now, or once the
+ *                minimum inter-arrival time has passed). Releases made while a
+ *                job is still waiting or running are merged into one release
+ *                after that job.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
+ *    - Pointer to the sporadic task's tcb.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the release was queued, 0 if the release queue is full.
+ */
+int release_sporadic_task( struct edf_scheduler_data *, struct tcb * );
+
+/*
+ * NAME:          release_sporadic_task_from_isr
+ *
+ * DESCRIPTION:   Same as release_sporadic_task, for use in an interrupt
+ *                handler. The interrupt priority must be at or below
+ *                configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct tcb *tcb
+ *    - Pointer to the sporadic task's tcb.
+ *  signed portBASE_TYPE *higher_priority_task_woken
+ *    - Set to pdTRUE if the scheduler was woken up, in which case the
+ *      handler should end with portEND_SWITCHING_ISR.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the release was queued, 0 if the release queue is full.
+ */
+int release_sporadic_task_from_isr( struct edf_scheduler_data *, struct tcb *, signed portBASE_TYPE * );
+
+/*
+ * NAME:          initialize_server
+ *
+ * DESCRIPTION:   Initialize a Constant Bandwidth Server and create its task.
+ *                The server counts towards the admitted utilisation as a task
+ *                with execution time budget and period period.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct edf_server *server
+ *    - Pointer to the server.
+ *  unsigned int id
+ *    - ID for the server's task.
+ *  unsigned int budget
+ *    - Execution time the server can use each period.
+ *  unsigned int period
+ *    - Server period.
+ *  unsigned int queue_length
+ *    - Number of requests that can be waiting.
+ *  unsigned int priority
+ *    - FreeRTOS priority of the server's task (the same as the other tasks).
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the server was set up, 0 if the scheduler already has
+ *      EDF_MAX_TASKS tasks or the server's queue or task could not be
+ *      created.
+ */
+int initialize_server( struct edf_scheduler_data *, struct edf_server *, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int );
+
+/*
+ * NAME:          admit_server
+ *
+ * DESCRIPTION:   Same as initialize_server, but only if the task set stays
+ *                schedulable under EDF with the server's bandwidth added (see
+ *                admit_task). Can be called while the scheduler is running.
+ *
+ * PARAMETERS:
+ *  See initialize_server.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the server was admitted, 0 if it was rejected (or its task or
+ *      request queue could not be created).
+ */
+int admit_server( struct edf_scheduler_data *, struct edf_server *, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int );
+
+/*
+ * NAME:          submit_request
+ *
+ * DESCRIPTION:   Queue aperiodic work to a server. The function is called from
+ *                the server's task, so it may take as long as it needs; it
+ *                is preempted when the server runs out of budget or a task
+ *                with an earlier deadline is released.
+ *
+ * PARAMETERS:
+ *  struct edf_server *server
+ *    - Pointer to the server.
+ *  void ( *function )( void * )
+ *    - Function to call.
+ *  void *parameter
+ *    - Parameter to pass to it.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the request was queued, 0 if the server's queue is full.
+ */
+int submit_request( struct edf_server *, void ( * )( void * ), void * );
+
+/*
+ * NAME:          submit_request_from_isr
+ *
+ * DESCRIPTION:   Same as submit_request, for use in an interrupt handler
+ *                (see release_sporadic_task_from_isr).
+ *
+ * PARAMETERS:
+ *  struct edf_server *server
+ *    - Pointer to the server.
+ *  void ( *function )( void * )
+ *    - Function to call.
+ *  void *parameter
+ *    - Parameter to pass to it.
+ *  signed portBASE_TYPE *higher_priority_task_woken
+ *    - Set to pdTRUE if the scheduler was woken up.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the request was queued, 0 if the server's queue is full.
+ */
+int submit_request_from_isr( struct edf_server *, void ( * )( void * ), void *, signed portBASE_TYPE * );
+
+/*
+ * NAME:          initialize_mutex
+ *
+ * DESCRIPTION:   Initialize a mutex with no users.
+ *
+ * PARAMETERS:
+ *  struct edf_mutex *mutex
+ *    - Pointer to the mutex.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void initialize_mutex( struct edf_mutex * );
+
+/*
+ * NAME:          use_mutex
+ *
+ * DESCRIPTION:   Declare that a task locks a mutex, and for how long at most.
+ *                The task set is tested again with the blocking this can
+ *                cause (see edf_admission_test_resource), and the use is only
+ *                recorded if it stays schedulable. Should be called before the
+ *                task first runs, while the mutex is not locked.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct edf_mutex *mutex
+ *    - Pointer to the mutex.
+ *  struct tcb *tcb
+ *    - The task (already given to the scheduler).
+ *  unsigned int critical_section
+ *    - Longest time the task holds the mutex.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the use was accepted, 0 if not.
+ */
+int use_mutex( struct edf_scheduler_data *, struct edf_mutex *, struct tcb *, unsigned int );
+
+/*
+ * NAME:          lock_mutex
+ *
+ * DESCRIPTION:   Lock a mutex. Never blocks. Mutexes must be unlocked in the
+ *                opposite order to the one they were locked in, and only by
+ *                tasks that declared them with use_mutex.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct edf_mutex *mutex
+ *    - Pointer to the mutex.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void lock_mutex( struct edf_scheduler_data *, struct edf_mutex * );
+
+/*
+ * NAME:          unlock_mutex
+ *
+ * DESCRIPTION:   Unlock a mutex, and wake the scheduler up in case a job was
+ *                held back by it.
+ *
+ * PARAMETERS:
+ *  struct edf_scheduler_data *edf_scheduler_data
+ *    - Pointer to struct edf_scheduler_data.
+ *  struct edf_mutex *mutex
+ *    - Pointer to the mutex.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void unlock_mutex( struct edf_scheduler_data *, struct edf_mutex * );
+
+/*
+ * NAME:          get_task_stats
+ *
+ * DESCRIPTION:   Get a consistent copy of a task's statistics.
+ *
+ * PARAMETERS:
+ *  struct tcb *tcb
+ *    - Pointer to the task's tcb.
+ *  struct edf_task_stats *stats
+ *    - Where to copy the statistics to.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void get_task_stats( struct tcb *, struct edf_task_stats * );
+
+/*
+ * NAME:          print_task_stats
+ *
+ * DESCRIPTION:   Print the statistics of every task with printf (which goes
+ *                out over the ITM port through fputc).
+ *
+ * PARAMETERS:
  *  struct edf_scheduler_data *edf_scheduler_data
  *    - Pointer to struct edf_scheduler_data.
  *
  * RETURNS:
  *  N/A
  */
-void initialize_task( struct edf_scheduler_data *, xListItem *, struct tcb *, unsigned int, unsigned int, unsigned int );
+void print_task_stats( struct edf_scheduler_data * );
 
 /*
  * NAME:          initialize_edf_scheduler
@@ -0,0 +1,163 @@
+#include "edf_trace.h"
+
+/*
+ * Timestamps come from the DWT cycle counter, which has to be enabled through
+ * the trace enable bit in DEMCR. Other targets can define their own.
+ */
+#ifndef EDF_TRACE_TIMESTAMP
+#define EDF_TRACE_DEMCR          ( *( ( volatile unsigned long * )( 0xE000EDFC ) ) )
+#define EDF_TRACE_TRCENA         0x01000000
+#define EDF_TRACE_DWT_CTRL       ( *( ( volatile unsigned long * )( 0xE0001000 ) ) )
+#define EDF_TRACE_DWT_CYCCNT     ( *( ( volatile unsigned long * )( 0xE0001004 ) ) )
+#define EDF_TRACE_CYCCNTENA      0x00000001
+
+#define EDF_TRACE_TIMESTAMP()    EDF_TRACE_DWT_CYCCNT
+#define EDF_TRACE_START_TIMESTAMP() \
+	do { EDF_TRACE_DEMCR |= EDF_TRACE_TRCENA; EDF_TRACE_DWT_CTRL |= EDF_TRACE_CYCCNTENA; } while ( 0 )
+#endif
+
+#define EDF_TRACE_MASK           ( EDF_TRACE_SIZE - 1 )
+
+/*
+ * A slot in the ring buffer. sequence is the index the event was written at
+ * plus 1 (0 while the slot has never been used), and is written last, so the
+ * consumer can tell whether the slot holds the event it expects.
+ */
+struct edf_trace_slot
+{
+	volatile unsigned long sequence;
+	volatile unsigned long timestamp;
+	volatile unsigned long event;
+};
+
+static struct edf_trace_slot slots[ EDF_TRACE_SIZE ];
+
+// Index of the next slot to write (only ever incremented).
+static volatile unsigned long head;
+
+// Index of the next slot to read.
+static unsigned long tail;
+
+// Events overwritten since the consumer last reported them.
+static unsigned long lost;
+
+/*
+ * NAME:          reserve
+ *
+ * DESCRIPTION:   Atomically take the next write index.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - The index.
+ */
+static unsigned long reserve( void )
+{
+	unsigned long index;
+
+#if defined( __CC_ARM )
+	// Retried if anything (an interrupt, or the same code in one) touched
+	// head in between.
+	do
+	{
+		index = __ldrex( &head );
+	} while ( __strex( index + 1, &head ) );
+#else
+	index = __sync_fetch_and_add( &head, 1 );
+#endif
+
+	return index;
+}
+
+/*
+ * See edf_trace.h for comments.
+ */
+void edf_trace_init( void )
+{
+	unsigned int i;
+
+	for ( i = 0; i < EDF_TRACE_SIZE; ++i )
+	{
+		slots[ i ].sequence = 0;
+	}
+
+	head = 0;
+	tail = 0;
+	lost = 0;
+
+	EDF_TRACE_START_TIMESTAMP();
+}
+
+/*
+ * See edf_trace.h for comments.
+ */
+void edf_trace_record( unsigned int event, unsigned int task )
+{
+	unsigned long index = reserve();
+	struct edf_trace_slot *slot = &slots[ index & EDF_TRACE_MASK ];
+
+	slot->timestamp = EDF_TRACE_TIMESTAMP();
+	slot->event = ( ( unsigned long )event << 16 ) | ( task & 0xFFFF );
+	slot->sequence = index + 1;
+}
+
+/*
+ * See edf_trace.h for comments.
+ */
+unsigned int edf_trace_read( struct edf_trace_record *records, unsigned int max_records )
+{
+	unsigned int count = 0;
+
+	while ( count < max_records )
+	{
+		struct edf_trace_slot *slot = &slots[ tail & EDF_TRACE_MASK ];
+		unsigned long sequence;
+		long ahead;
+
+		// Skip what the writers have already overwritten.
+		if ( head - tail > EDF_TRACE_SIZE )
+		{
+			lost += head - EDF_TRACE_SIZE - tail;
+			tail = head - EDF_TRACE_SIZE;
+			continue;
+		}
+
+		if ( lost )
+		{
+			// Stamped with the time of the first event kept.
+			records[ count ].timestamp = slot->timestamp;
+			records[ count ].event = ( ( unsigned long )EDF_TRACE_LOST << 16 ) | ( lost > 0xFFFF ? 0xFFFF : lost );
+			lost = 0;
+			++count;
+			continue;
+		}
+
+		sequence = slot->sequence;
+		ahead = ( long )( sequence - ( tail + 1 ) );
+
+		if ( ahead < 0 )
+		{
+			// Not written yet (or still being written).
+			break;
+		}
+
+		// Copy the event, then check the slot was not written again meanwhile.
+		records[ count ].timestamp = slot->timestamp;
+		records[ count ].event = slot->event;
+
+		if ( ahead > 0 || slot->sequence != sequence )
+		{
+			// Overwritten before it could be read.
+			++lost;
+			++tail;
+			continue;
+		}
+
+		++tail;
+		++count;
+	}
+
+	return count;
+}
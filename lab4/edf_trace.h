@@ -0,0 +1,119 @@
+#ifndef __EDF_TRACE__
+#define __EDF_TRACE__
+
+/*
+ * Binary event trace. Events are written to a fixed-size ring buffer with a
+ * few stores (no locks, no printf), so they can be recorded from any task or
+ * interrupt handler without adding jitter, and are read back later by a
+ * single low priority consumer (the idle hook in main.c sends them out over
+ * ITM stimulus port 1). When the consumer falls behind, the oldest events are
+ * overwritten and an EDF_TRACE_LOST event reports how many.
+ *
+ * host/edf_trace_decoder.c turns a dump of the records into a Chrome trace /
+ * Perfetto JSON timeline.
+ */
+
+/*
+ * Set to 0 to compile the EDF_TRACE calls out.
+ */
+#ifndef EDF_TRACE_ENABLED
+#define EDF_TRACE_ENABLED      1
+#endif
+
+/*
+ * Number of events the ring buffer holds (must be a power of 2). Each event
+ * takes 12 bytes.
+ */
+#ifndef EDF_TRACE_SIZE
+#define EDF_TRACE_SIZE         128
+#endif
+
+/*
+ * Events. The task is the tcb ID, or EDF_TRACE_NO_TASK. EDF_TRACE_PREEMPT to
+ * EDF_TRACE_MISS are in the order of the EDF_JOB_ results (edf_policy.h).
+ */
+#define EDF_TRACE_SCHEDULER    1    // Scheduler task woke up.
+#define EDF_TRACE_RESUME       2    // Task resumed.
+#define EDF_TRACE_PREEMPT      3    // Task suspended before its job completed.
+#define EDF_TRACE_COMPLETE     4    // Job completed by its deadline.
+#define EDF_TRACE_MISS         5    // Job completed after its deadline.
+#define EDF_TRACE_RELEASE      6    // Sporadic release or server request queued.
+#define EDF_TRACE_LOST         7    // Events overwritten (task is the count).
+
+#define EDF_TRACE_NO_TASK      0xFFFF
+
+/*
+ * A recorded event, as read back by edf_trace_read and sent to the host (two
+ * 32-bit little-endian words).
+ *
+ * MEMBERS:
+ *   unsigned long timestamp
+ *     - Cycle count (DWT CYCCNT) when the event was recorded.
+ *   unsigned long event
+ *     - Event in the upper 16 bits, task in the lower 16 bits.
+ */
+struct edf_trace_record
+{
+	unsigned long timestamp;
+	unsigned long event;
+};
+
+/*
+ * NAME:          edf_trace_init
+ *
+ * DESCRIPTION:   Empty the ring buffer and start the cycle counter used for
+ *                timestamps.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_trace_init( void );
+
+/*
+ * NAME:          edf_trace_record
+ *
+ * DESCRIPTION:   Record an event. Can be called from tasks and interrupt
+ *                handlers at any priority; a slot is reserved with LDREX/STREX
+ *                and filled in with three stores, the last of which makes it
+ *                visible to the consumer.
+ *
+ * PARAMETERS:
+ *  unsigned int event
+ *    - One of the EDF_TRACE_ events.
+ *  unsigned int task
+ *    - Task ID, or EDF_TRACE_NO_TASK.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void edf_trace_record( unsigned int, unsigned int );
+
+/*
+ * NAME:          edf_trace_read
+ *
+ * DESCRIPTION:   Take recorded events out of the ring buffer, oldest first.
+ *                Stops at the first event that is still being written. Must
+ *                only be called from one task.
+ *
+ * PARAMETERS:
+ *  struct edf_trace_record *records
+ *    - Where to copy the events to.
+ *  unsigned int max_records
+ *    - Most events to take.
+ *
+ * RETURNS:
+ *  unsigned int
+ *    - Number of events taken.
+ */
+unsigned int edf_trace_read( struct edf_trace_record *, unsigned int );
+
+#if EDF_TRACE_ENABLED
+#define EDF_TRACE( event, task )    edf_trace_record( ( event ), ( task ) )
+#else
+#define EDF_TRACE( event, task )    do { ( void )( event ); ( void )( task ); } while ( 0 )
+#endif
+
+#endif // __EDF_TRACE__
@@ -0,0 +1,145 @@
+/*
+ * Reporting for lab4 when it runs on the host with the POSIX port
+ * (FreeRTOS-Source/portable/GCC/Posix). Linked in place of a debugger: when
+ * the program exits (FREERTOS_RUN_TICKS) the statistics of every task are
+ * printed to stdout, and if EDF_TRACE_FILE is set the binary trace is written
+ * to that file in the same format as ITM stimulus port 1, for
+ * edf_trace_decoder.
+ *
+ * Usage (from lab4):
+ *   FREERTOS_RUN_TICKS=3600000 EDF_TRACE_FILE=trace.bin ./lab4_host
+ *   host/edf_trace_decoder trace.bin > trace.json
+ *
+ * Build: see FreeRTOS-Source/portable/GCC/Posix/port.c.
+ */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "edf_scheduler.h"
+
+/*
+ * Events taken out of the ring buffer per tick. More than the scheduler can
+ * record in one tick, so the buffer never overflows.
+ */
+#define DRAIN_RECORDS        ( EDF_TRACE_SIZE / 2 )
+
+extern struct edf_scheduler_data edf_scheduler_data;
+
+// Trace output file, or -1.
+static int trace_file = -1;
+
+/*
+ * NAME:          drain_trace
+ *
+ * DESCRIPTION:   Write the recorded trace events to the trace file, as pairs
+ *                of 32-bit little-endian words.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void drain_trace( void )
+{
+	struct edf_trace_record records[ DRAIN_RECORDS ];
+	unsigned char bytes[ DRAIN_RECORDS * 8 ];
+	unsigned int count;
+	unsigned int i;
+	unsigned int j;
+
+	while ( ( count = edf_trace_read( records, DRAIN_RECORDS ) ) != 0 )
+	{
+		for ( i = 0; i < count; ++i )
+		{
+			for ( j = 0; j < 4; ++j )
+			{
+				bytes[ i * 8 + j ] = records[ i ].timestamp >> ( 8 * j );
+				bytes[ i * 8 + 4 + j ] = records[ i ].event >> ( 8 * j );
+			}
+		}
+
+		// write() rather than stdio, as this runs in the tick handler.
+		if ( write( trace_file, bytes, count * 8 ) != ( ssize_t )( count * 8 ) )
+		{
+			close( trace_file );
+			trace_file = -1;
+			return;
+		}
+	}
+}
+
+/*
+ * NAME:          vApplicationHostTickHook
+ *
+ * DESCRIPTION:   Called by the port on every tick. Drains the trace.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+void vApplicationHostTickHook( void )
+{
+	if ( trace_file >= 0 )
+	{
+		drain_trace();
+	}
+}
+
+/*
+ * NAME:          report
+ *
+ * DESCRIPTION:   Print the task statistics and finish the trace at exit.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void report( void )
+{
+	print_task_stats( &edf_scheduler_data );
+
+	if ( trace_file >= 0 )
+	{
+		drain_trace();
+		close( trace_file );
+	}
+}
+
+/*
+ * NAME:          start_report
+ *
+ * DESCRIPTION:   Open the trace file and register the exit report. Runs
+ *                before main().
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void __attribute__( ( constructor ) ) start_report( void )
+{
+	const char *path = getenv( "EDF_TRACE_FILE" );
+
+	if ( path )
+	{
+		trace_file = open( path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+		if ( trace_file < 0 )
+		{
+			perror( path );
+		}
+	}
+
+	atexit( report );
+}
@@ -0,0 +1,690 @@
+/*
+ * Host-side simulation of a task set on several cores, using the same EDF
+ * policy as the scheduler (edf_policy.c).
+ *
+ * Three ways of using m cores are compared:
+ *   - Partitioned, first-fit: tasks are taken in decreasing utilisation and
+ *     each goes to the first core whose admission test (edf_admission_test)
+ *     still passes with it.
+ *   - Partitioned, worst-fit: each task goes to the least utilised core that
+ *     still passes the admission test.
+ *   - Global: all tasks share one policy, and the m earliest deadlines run.
+ *     A task keeps its core while it stays in the m earliest, and counts a
+ *     migration when it resumes on another core.
+ * Partitioned cores never interact, so each core is simulated on its own.
+ *
+ * Time jumps from event to event (a release, or a running job using up its
+ * execution time) as in the event driven scheduler, so long runs with many
+ * tasks take little time. Every job runs for exactly its execution time.
+ *
+ * The task set is either read from a file, one "C D T" line per task (lines
+ * starting with # are skipped), or generated with UUniFast for a given number
+ * of tasks and total utilisation, with periods spread log-uniformly between
+ * 10 and 1000 ticks and deadlines equal to periods.
+ *
+ * Usage:
+ *   edf_multicore_simulator [-c cores] [-n tasks] [-u utilisation]
+ *                           [-t ticks] [-s seed] [task set file]
+ *
+ * Build (from lab4/host):
+ *   gcc -O2 -DEDF_MAX_TASKS=256 -I.. ../edf_policy.c ../edf_ready_queue.c \
+ *       ../edf_release_wheel.c ../edf_admission.c ../edf_cbs.c \
+ *       edf_multicore_simulator.c -o edf_multicore_simulator -lm
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+
+#include "edf_policy.h"
+
+/*
+ * Largest number of simulated cores.
+ */
+#define MAX_CORES            16
+
+/*
+ * Defaults for the command line options.
+ */
+#define DEFAULT_CORES        4
+#define DEFAULT_TASKS        32
+#define DEFAULT_UTILISATION  2.8
+#define DEFAULT_TICKS        1000000UL
+
+/*
+ * Ways of using the cores.
+ */
+#define MODE_FIRST_FIT       0
+#define MODE_WORST_FIT       1
+#define MODE_GLOBAL          2
+
+/*
+ * Task set to simulate.
+ */
+struct sim_task_set
+{
+	struct edf_task_params params[ EDF_MAX_TASKS ];
+	unsigned int num_tasks;
+};
+
+/*
+ * Totals for one simulation.
+ */
+struct sim_result
+{
+	unsigned long jobs;
+	unsigned long misses;
+	unsigned long worst_tardiness;
+	unsigned long preemptions;
+	unsigned long migrations;
+};
+
+static struct sim_task_set task_set;
+static struct tcb tcbs[ EDF_MAX_TASKS ];
+static int last_core[ EDF_MAX_TASKS ];
+static unsigned int assignment[ EDF_MAX_TASKS ];
+static struct edf_policy policies[ MAX_CORES ];
+static struct edf_admission admissions[ MAX_CORES ];
+
+/*
+ * NAME:          now_ns
+ *
+ * DESCRIPTION:   Read the monotonic clock.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  double
+ *    - Current time.
+ */
+static double now_ns( void )
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * NAME:          random_unit
+ *
+ * DESCRIPTION:   Random number in [0, 1).
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  double
+ *    - The number.
+ */
+static double random_unit( void )
+{
+	return rand() / ( RAND_MAX + 1.0 );
+}
+
+/*
+ * NAME:          utilisation
+ *
+ * DESCRIPTION:   Utilisation of a task.
+ *
+ * PARAMETERS:
+ *  const struct edf_task_params *params
+ *    - The task.
+ *
+ * RETURNS:
+ *  double
+ *    - C / T.
+ */
+static double utilisation( const struct edf_task_params *params )
+{
+	return ( double )params->execution_time / params->period;
+}
+
+/*
+ * NAME:          generate_task_set
+ *
+ * DESCRIPTION:   Generate a random implicit deadline task set with UUniFast,
+ *                discarding sets where a task would need more than one core.
+ *
+ * PARAMETERS:
+ *  unsigned int num_tasks
+ *    - Number of tasks.
+ *  double total
+ *    - Total utilisation.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void generate_task_set( unsigned int num_tasks, double total )
+{
+	unsigned int i;
+	int valid;
+
+	do
+	{
+		double sum = total;
+
+		valid = 1;
+
+		for ( i = 0; i < num_tasks; ++i )
+		{
+			double share;
+			double period = exp( log( 10.0 ) + random_unit() * ( log( 1000.0 ) - log( 10.0 ) ) );
+			struct edf_task_params *params = &task_set.params[ i ];
+
+			if ( i < num_tasks - 1 )
+			{
+				double next = sum * pow( random_unit(), 1.0 / ( num_tasks - 1 - i ) );
+
+				share = sum - next;
+				sum = next;
+			}
+			else
+			{
+				share = sum;
+			}
+
+			params->period = ( unsigned long )period;
+			params->deadline = params->period;
+			params->execution_time = ( unsigned long )( share * params->period + 0.5 );
+			params->critical_section = 0;
+			params->ceiling = EDF_NO_CEILING;
+
+			if ( params->execution_time == 0 )
+			{
+				params->execution_time = 1;
+			}
+
+			if ( params->execution_time > params->period )
+			{
+				valid = 0;
+			}
+		}
+	} while ( !valid );
+
+	task_set.num_tasks = num_tasks;
+}
+
+/*
+ * NAME:          load_task_set
+ *
+ * DESCRIPTION:   Read a task set from a file, one "C D T" line per task.
+ *
+ * PARAMETERS:
+ *  const char *path
+ *    - File to read.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task set was read, 0 if not.
+ */
+static int load_task_set( const char *path )
+{
+	FILE *file = fopen( path, "r" );
+	char line[ 128 ];
+
+	if ( !file )
+	{
+		perror( path );
+		return 0;
+	}
+
+	task_set.num_tasks = 0;
+
+	while ( fgets( line, sizeof( line ), file ) && task_set.num_tasks < EDF_MAX_TASKS )
+	{
+		struct edf_task_params *params = &task_set.params[ task_set.num_tasks ];
+
+		if ( line[ 0 ] == '#' ||
+		     sscanf( line, "%lu %lu %lu", &params->execution_time, &params->deadline, &params->period ) != 3 )
+		{
+			continue;
+		}
+
+		if ( params->execution_time == 0 || params->execution_time > params->deadline || params->deadline > params->period )
+		{
+			fprintf( stderr, "%s: skipping task with C %lu D %lu T %lu (need 0 < C <= D <= T)\n",
+				path, params->execution_time, params->deadline, params->period );
+			continue;
+		}
+
+		params->critical_section = 0;
+		params->ceiling = EDF_NO_CEILING;
+		++task_set.num_tasks;
+	}
+
+	fclose( file );
+
+	return task_set.num_tasks != 0;
+}
+
+/*
+ * NAME:          by_utilisation
+ *
+ * DESCRIPTION:   qsort comparison of task indexes, highest utilisation first.
+ *
+ * PARAMETERS:
+ *  const void *a, const void *b
+ *    - Task indexes.
+ *
+ * RETURNS:
+ *  int
+ *    - Negative, zero or positive.
+ */
+static int by_utilisation( const void *a, const void *b )
+{
+	double ua = utilisation( &task_set.params[ *( const unsigned int * )a ] );
+	double ub = utilisation( &task_set.params[ *( const unsigned int * )b ] );
+
+	return ( ua < ub ) - ( ua > ub );
+}
+
+/*
+ * NAME:          partition
+ *
+ * DESCRIPTION:   Assign every task to a core (see MODE_FIRST_FIT and
+ *                MODE_WORST_FIT), using the admission test of each core.
+ *
+ * PARAMETERS:
+ *  unsigned int cores
+ *    - Number of cores.
+ *  int mode
+ *    - MODE_FIRST_FIT or MODE_WORST_FIT.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if every task was assigned, 0 if one did not fit anywhere.
+ */
+static int partition( unsigned int cores, int mode )
+{
+	unsigned int order[ EDF_MAX_TASKS ];
+	unsigned int i;
+	unsigned int core;
+
+	for ( core = 0; core < cores; ++core )
+	{
+		edf_admission_init( &admissions[ core ] );
+	}
+
+	for ( i = 0; i < task_set.num_tasks; ++i )
+	{
+		order[ i ] = i;
+	}
+
+	qsort( order, task_set.num_tasks, sizeof( order[ 0 ] ), by_utilisation );
+
+	for ( i = 0; i < task_set.num_tasks; ++i )
+	{
+		const struct edf_task_params *params = &task_set.params[ order[ i ] ];
+		unsigned int chosen = cores;
+
+		for ( core = 0; core < cores; ++core )
+		{
+			if ( chosen < cores && admissions[ core ].utilisation >= admissions[ chosen ].utilisation )
+			{
+				continue;
+			}
+
+			if ( edf_admission_test( &admissions[ core ], params ) )
+			{
+				chosen = core;
+
+				if ( mode == MODE_FIRST_FIT )
+				{
+					break;
+				}
+			}
+		}
+
+		if ( chosen == cores )
+		{
+			return 0;
+		}
+
+		edf_admission_add( &admissions[ chosen ], params );
+		assignment[ order[ i ] ] = chosen;
+	}
+
+	return 1;
+}
+
+/*
+ * NAME:          run
+ *
+ * DESCRIPTION:   Simulate one policy on a number of cores from tick 0 until
+ *                the given tick. Jobs still running at the end are not
+ *                counted.
+ *
+ * PARAMETERS:
+ *  struct edf_policy *policy
+ *    - The policy, with its tasks released at 0.
+ *  unsigned int cores
+ *    - Number of cores sharing the policy.
+ *  unsigned int first_core
+ *    - Number of the first core (for counting migrations).
+ *  unsigned long ticks
+ *    - Ticks to simulate.
+ *  struct sim_result *result
+ *    - Totals to add to.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void run( struct edf_policy *policy, unsigned int cores, unsigned int first_core, unsigned long ticks, struct sim_result *result )
+{
+	struct tcb *running[ MAX_CORES ] = { 0 };
+	struct tcb *previous[ MAX_CORES ];
+	struct tcb *picked[ MAX_CORES ];
+	unsigned long now = 0;
+	unsigned long last = 0;
+	unsigned int core;
+	unsigned int i;
+	unsigned int num_picked;
+
+	for ( ;; )
+	{
+		unsigned long wake_time = EDF_NO_EVENT;
+
+		edf_policy_advance( policy, now );
+
+		// Stop every running task, and charge it for the time since the last
+		// event.
+		for ( core = 0; core < cores; ++core )
+		{
+			struct tcb *tcb = running[ core ];
+			unsigned long deadline;
+
+			previous[ core ] = 0;
+
+			if ( !tcb )
+			{
+				continue;
+			}
+
+			deadline = tcb->absolute_deadline;
+
+			switch ( edf_policy_stop( policy, tcb, now - last, now ) )
+			{
+				case EDF_JOB_PREEMPTED:
+					previous[ core ] = tcb;
+					break;
+
+				case EDF_JOB_MISSED:
+					++result->misses;
+
+					if ( now - deadline > result->worst_tardiness )
+					{
+						result->worst_tardiness = now - deadline;
+					}
+
+					// Fall through.
+				default:
+					++result->jobs;
+					break;
+			}
+		}
+
+		for ( num_picked = 0; num_picked < cores; ++num_picked )
+		{
+			picked[ num_picked ] = edf_policy_next( policy );
+
+			if ( !picked[ num_picked ] )
+			{
+				break;
+			}
+		}
+
+		// Tasks that keep running stay on their core.
+		for ( core = 0; core < cores; ++core )
+		{
+			struct tcb *tcb = running[ core ];
+
+			running[ core ] = 0;
+
+			for ( i = 0; tcb && i < num_picked; ++i )
+			{
+				if ( picked[ i ] == tcb )
+				{
+					running[ core ] = tcb;
+					picked[ i ] = 0;
+				}
+			}
+
+			if ( previous[ core ] && !running[ core ] )
+			{
+				++result->preemptions;
+			}
+		}
+
+		// The others go to the free cores.
+		for ( i = 0, core = 0; i < num_picked; ++i )
+		{
+			struct tcb *tcb = picked[ i ];
+			int *last_on;
+
+			if ( !tcb )
+			{
+				continue;
+			}
+
+			last_on = &last_core[ tcb - tcbs ];
+
+			while ( running[ core ] )
+			{
+				++core;
+			}
+
+			running[ core ] = tcb;
+
+			if ( *last_on >= 0 && *last_on != ( int )( first_core + core ) )
+			{
+				++result->migrations;
+			}
+
+			*last_on = first_core + core;
+		}
+
+		for ( core = 0; core < cores; ++core )
+		{
+			unsigned long wake = edf_policy_wake_time( policy, running[ core ], now );
+
+			if ( wake < wake_time )
+			{
+				wake_time = wake;
+			}
+		}
+
+		if ( wake_time == EDF_NO_EVENT || wake_time > ticks )
+		{
+			break;
+		}
+
+		last = now;
+		now = wake_time;
+	}
+}
+
+/*
+ * NAME:          simulate
+ *
+ * DESCRIPTION:   Simulate the task set on a number of cores.
+ *
+ * PARAMETERS:
+ *  unsigned int cores
+ *    - Number of cores.
+ *  int mode
+ *    - MODE_FIRST_FIT, MODE_WORST_FIT or MODE_GLOBAL.
+ *  unsigned long ticks
+ *    - Ticks to simulate.
+ *  struct sim_result *result
+ *    - Where to put the totals.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void simulate( unsigned int cores, int mode, unsigned long ticks, struct sim_result *result )
+{
+	unsigned int i;
+	unsigned int core;
+	unsigned int num_policies = ( mode == MODE_GLOBAL ) ? 1 : cores;
+
+	result->jobs = 0;
+	result->misses = 0;
+	result->worst_tardiness = 0;
+	result->preemptions = 0;
+	result->migrations = 0;
+
+	for ( core = 0; core < num_policies; ++core )
+	{
+		edf_policy_init( &policies[ core ], 0 );
+	}
+
+	for ( i = 0; i < task_set.num_tasks; ++i )
+	{
+		struct edf_policy *policy = &policies[ ( mode == MODE_GLOBAL ) ? 0 : assignment[ i ] ];
+
+		edf_policy_setup_task( &tcbs[ i ], &task_set.params[ i ], i, 0, 0 );
+		edf_policy_release( policy, &tcbs[ i ], 0, 0 );
+		last_core[ i ] = -1;
+	}
+
+	if ( mode == MODE_GLOBAL )
+	{
+		run( &policies[ 0 ], cores, 0, ticks, result );
+	}
+	else
+	{
+		for ( core = 0; core < cores; ++core )
+		{
+			run( &policies[ core ], 1, core, ticks, result );
+		}
+	}
+}
+
+/*
+ * NAME:          global_bound
+ *
+ * DESCRIPTION:   Goossens, Funk and Baruah utilisation bound for global EDF
+ *                with implicit deadlines: U <= m - (m - 1) * u_max.
+ *
+ * PARAMETERS:
+ *  unsigned int cores
+ *    - Number of cores.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the task set is within the bound, 0 if not (it may still be
+ *      schedulable).
+ */
+static int global_bound( unsigned int cores )
+{
+	double total = 0;
+	double largest = 0;
+	unsigned int i;
+
+	for ( i = 0; i < task_set.num_tasks; ++i )
+	{
+		double u = utilisation( &task_set.params[ i ] );
+
+		if ( task_set.params[ i ].deadline != task_set.params[ i ].period )
+		{
+			return 0;
+		}
+
+		total += u;
+		largest = ( u > largest ) ? u : largest;
+	}
+
+	return total <= cores - ( cores - 1 ) * largest;
+}
+
+int main( int argc, char *argv[] )
+{
+	static const char *mode_names[] = { "first-fit", "worst-fit", "global" };
+	unsigned int max_cores = DEFAULT_CORES;
+	unsigned int num_tasks = DEFAULT_TASKS;
+	double total = DEFAULT_UTILISATION;
+	unsigned long ticks = DEFAULT_TICKS;
+	unsigned int seed = 1;
+	unsigned int cores;
+	unsigned int i;
+	int mode;
+	int option;
+
+	while ( ( option = getopt( argc, argv, "c:n:u:t:s:" ) ) != -1 )
+	{
+		switch ( option )
+		{
+			case 'c': max_cores = atoi( optarg ); break;
+			case 'n': num_tasks = atoi( optarg ); break;
+			case 'u': total = atof( optarg ); break;
+			case 't': ticks = strtoul( optarg, 0, 0 ); break;
+			case 's': seed = atoi( optarg ); break;
+			default:
+				fprintf( stderr, "usage: %s [-c cores] [-n tasks] [-u utilisation] [-t ticks] [-s seed] [task set file]\n", argv[ 0 ] );
+				return 1;
+		}
+	}
+
+	if ( max_cores < 1 || max_cores > MAX_CORES || num_tasks < 1 || num_tasks > EDF_MAX_TASKS )
+	{
+		fprintf( stderr, "need 1 to %d cores and 1 to %d tasks\n", MAX_CORES, EDF_MAX_TASKS );
+		return 1;
+	}
+
+	if ( optind < argc )
+	{
+		if ( !load_task_set( argv[ optind ] ) )
+		{
+			return 1;
+		}
+	}
+	else
+	{
+		srand( seed );
+		generate_task_set( num_tasks, total );
+	}
+
+	for ( i = 0, total = 0; i < task_set.num_tasks; ++i )
+	{
+		total += utilisation( &task_set.params[ i ] );
+	}
+
+	printf("%u tasks, utilisation %.3f, %lu ticks\n\n", task_set.num_tasks, total, ticks);
+	printf("%-10s %5s %6s %10s %8s %10s %11s %10s %8s\n",
+		"mode", "cores", "test", "jobs", "misses", "tardiness", "preemptions", "migrations", "Mjobs/s");
+
+	for ( cores = 1; cores <= max_cores; ++cores )
+	{
+		for ( mode = MODE_FIRST_FIT; mode <= MODE_GLOBAL; ++mode )
+		{
+			struct sim_result result;
+			double start;
+			double elapsed;
+			int passed;
+
+			// Partitioned: every task fits on a core. Global: the task set is
+			// within the GFB bound.
+			passed = ( mode == MODE_GLOBAL ) ? global_bound( cores ) : partition( cores, mode );
+
+			if ( mode != MODE_GLOBAL && !passed )
+			{
+				printf("%-10s %5u %6s\n", mode_names[ mode ], cores, "no");
+				continue;
+			}
+
+			start = now_ns();
+			simulate( cores, mode, ticks, &result );
+			elapsed = now_ns() - start;
+
+			printf("%-10s %5u %6s %10lu %8lu %10lu %11lu %10lu %8.2f\n",
+				mode_names[ mode ], cores, passed ? "yes" : "no", result.jobs, result.misses,
+				result.worst_tardiness, result.preemptions, result.migrations, result.jobs / elapsed * 1e3);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * Host-side benchmark comparing the per-tick cost of the EDF ready queue
+ * (binary heap) against the sorted xList it replaced.
+ *
+ * Each simulated scheduler tick takes the earliest deadline task out of the
+ * ready queue and puts it back with its next deadline, which is the work the
+ * scheduler does every time a task is preempted or re-released.
+ *
+ * Build (from lab4/host):
+ *   gcc -O2 -DEDF_MAX_TASKS=1024 -I.. -I../FreeRTOS-Source/include \
+ *       -I../FreeRTOS-Source/portable/RVDS/ARM_CM3 \
+ *       ../edf_ready_queue.c ../FreeRTOS-Source/list.c \
+ *       edf_ready_queue_benchmark.c -o edf_ready_queue_benchmark
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "list.h"
+#include "edf_ready_queue.h"
+
+#define _listGET_LIST_ITEM_OWNER( pxListItem ) ( ( pxListItem )->pvOwner )
+
+/*
+ * Number of simulated scheduler ticks per measurement.
+ */
+#define NUM_TICKS            200000
+
+/*
+ * Task counts to measure.
+ */
+static const unsigned int task_counts[] = { 3, 32, 256, 1024 };
+
+/*
+ * Minimal stand-in for struct tcb (only what the ready queue looks at).
+ */
+struct bench_tcb
+{
+	unsigned int id;
+	unsigned int period;
+};
+
+static struct bench_tcb tcbs[ EDF_MAX_TASKS ];
+static xListItem list_items[ EDF_MAX_TASKS ];
+
+/*
+ * NAME:          now_ns
+ *
+ * DESCRIPTION:   Monotonic time in nanoseconds.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  double
+ *    - Current time.
+ */
+static double now_ns( void )
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * NAME:          init_tasks
+ *
+ * DESCRIPTION:   Give every task a period. Periods repeat often so that many
+ *                tasks share a deadline and the tie-break path is exercised.
+ *
+ * PARAMETERS:
+ *  unsigned int num_tasks
+ *    - Number of tasks.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void init_tasks( unsigned int num_tasks )
+{
+	unsigned int i;
+
+	for ( i = 0; i < num_tasks; ++i )
+	{
+		tcbs[ i ].id = i;
+		tcbs[ i ].period = 4000 + 1000 * ( i % 5 );
+	}
+}
+
+/*
+ * NAME:          list_get_next_task
+ *
+ * DESCRIPTION:   Original get_next_task: walk the run of equal deadlines at
+ *                the front of the sorted list and pick the lowest ID.
+ *
+ * PARAMETERS:
+ *  xList *list
+ *    - Sorted ready list.
+ *
+ * RETURNS:
+ *  xListItem *
+ *    - Task to run.
+ */
+static xListItem *list_get_next_task( xList *list )
+{
+	int i;
+	volatile xListItem *list_item;
+	xListItem *next_list_item;
+
+	list_item = list->xListEnd.pxNext;
+	next_list_item = ( xListItem * )list_item;
+
+	for ( i = listCURRENT_LIST_LENGTH( list ); i != 0; --i )
+	{
+		if ( listGET_LIST_ITEM_VALUE( list_item ) == listGET_LIST_ITEM_VALUE( next_list_item ) )
+		{
+			struct bench_tcb *tcb_li = ( struct bench_tcb * )_listGET_LIST_ITEM_OWNER( list_item );
+			struct bench_tcb *tcb_nli = ( struct bench_tcb * )_listGET_LIST_ITEM_OWNER( next_list_item );
+
+			if ( tcb_li->id < tcb_nli->id )
+			{
+				next_list_item = ( xListItem * )list_item;
+			}
+		}
+		else
+		{
+			break;
+		}
+
+		list_item = list_item->pxNext;
+	}
+
+	return next_list_item;
+}
+
+/*
+ * NAME:          bench_list
+ *
+ * DESCRIPTION:   Measure the sorted xList ready list.
+ *
+ * PARAMETERS:
+ *  unsigned int num_tasks
+ *    - Number of tasks.
+ *
+ * RETURNS:
+ *  double
+ *    - Nanoseconds per tick.
+ */
+static double bench_list( unsigned int num_tasks )
+{
+	xList ready_tasks_list;
+	unsigned int i;
+	double start;
+
+	vListInitialise( &ready_tasks_list );
+
+	for ( i = 0; i < num_tasks; ++i )
+	{
+		vListInitialiseItem( &list_items[ i ] );
+		listSET_LIST_ITEM_OWNER( &list_items[ i ], &tcbs[ i ] );
+		listSET_LIST_ITEM_VALUE( &list_items[ i ], tcbs[ i ].period );
+		vListInsert( &ready_tasks_list, &list_items[ i ] );
+	}
+
+	start = now_ns();
+
+	for ( i = 0; i < NUM_TICKS; ++i )
+	{
+		xListItem *task = list_get_next_task( &ready_tasks_list );
+		struct bench_tcb *tcb = ( struct bench_tcb * )_listGET_LIST_ITEM_OWNER( task );
+
+		vListRemove( task );
+		listSET_LIST_ITEM_VALUE( task, listGET_LIST_ITEM_VALUE( task ) + tcb->period );
+		vListInsert( &ready_tasks_list, task );
+	}
+
+	return ( now_ns() - start ) / NUM_TICKS;
+}
+
+/*
+ * NAME:          bench_heap
+ *
+ * DESCRIPTION:   Measure the heap based ready queue.
+ *
+ * PARAMETERS:
+ *  unsigned int num_tasks
+ *    - Number of tasks.
+ *
+ * RETURNS:
+ *  double
+ *    - Nanoseconds per tick.
+ */
+static double bench_heap( unsigned int num_tasks )
+{
+	static struct edf_ready_queue ready_tasks;
+	unsigned int i;
+	double start;
+
+	edf_ready_queue_init( &ready_tasks );
+
+	for ( i = 0; i < num_tasks; ++i )
+	{
+		listSET_LIST_ITEM_OWNER( &list_items[ i ], &tcbs[ i ] );
+		listSET_LIST_ITEM_VALUE( &list_items[ i ], tcbs[ i ].period );
+		edf_ready_queue_insert( &ready_tasks, tcbs[ i ].period, tcbs[ i ].id, &list_items[ i ] );
+	}
+
+	start = now_ns();
+
+	for ( i = 0; i < NUM_TICKS; ++i )
+	{
+		xListItem *task = ( xListItem * )edf_ready_queue_pop( &ready_tasks );
+		struct bench_tcb *tcb = ( struct bench_tcb * )_listGET_LIST_ITEM_OWNER( task );
+
+		listSET_LIST_ITEM_VALUE( task, listGET_LIST_ITEM_VALUE( task ) + tcb->period );
+		edf_ready_queue_insert( &ready_tasks, listGET_LIST_ITEM_VALUE( task ), tcb->id, task );
+	}
+
+	return ( now_ns() - start ) / NUM_TICKS;
+}
+
+int main( void )
+{
+	unsigned int i;
+
+	printf( "%8s %16s %16s\n", "tasks", "xList ns/tick", "heap ns/tick" );
+
+	for ( i = 0; i < sizeof( task_counts ) / sizeof( task_counts[ 0 ] ); ++i )
+	{
+		unsigned int num_tasks = task_counts[ i ];
+
+		if ( num_tasks > EDF_MAX_TASKS )
+		{
+			printf( "%8u (skipped, build with -DEDF_MAX_TASKS=%u)\n", num_tasks, num_tasks );
+			continue;
+		}
+
+		init_tasks( num_tasks );
+		printf( "%8u %16.1f %16.1f\n", num_tasks, bench_list( num_tasks ), bench_heap( num_tasks ) );
+	}
+
+	return 0;
+}
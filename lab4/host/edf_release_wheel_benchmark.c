@@ -0,0 +1,261 @@
+/*
+ * Host-side benchmark comparing the cost of releasing periodic tasks with the
+ * timing wheel against the blocked xList walk it replaced.
+ *
+ * Every task sits blocked with a period of a few seconds. Each simulated tick
+ * releases the tasks that are due and immediately blocks them again until
+ * their next restart time, as the scheduler would for tasks that complete
+ * straight away.
+ *
+ * Build (from lab4/host):
+ *   gcc -O2 -I.. -I../FreeRTOS-Source/include \
+ *       -I../FreeRTOS-Source/portable/RVDS/ARM_CM3 \
+ *       ../edf_release_wheel.c ../FreeRTOS-Source/list.c \
+ *       edf_release_wheel_benchmark.c -o edf_release_wheel_benchmark
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "list.h"
+#include "edf_release_wheel.h"
+
+#define _listGET_LIST_ITEM_OWNER( pxListItem ) ( ( pxListItem )->pvOwner )
+
+/*
+ * Number of simulated ticks per measurement.
+ */
+#define NUM_TICKS            100000
+
+/*
+ * Largest task count measured.
+ */
+#define MAX_TASKS            1024
+
+/*
+ * Task counts to measure.
+ */
+static const unsigned int task_counts[] = { 3, 32, 256, 1024 };
+
+/*
+ * Minimal stand-in for struct tcb.
+ */
+struct bench_tcb
+{
+	unsigned int period;
+	unsigned long restart_time;
+	struct edf_wheel_node release_node;
+};
+
+static struct bench_tcb tcbs[ MAX_TASKS ];
+static xListItem list_items[ MAX_TASKS ];
+
+/*
+ * Number of releases seen by the last measurement (so both versions can be
+ * checked to do the same work).
+ */
+static unsigned long releases;
+
+/*
+ * NAME:          now_ns
+ *
+ * DESCRIPTION:   Monotonic time in nanoseconds.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  double
+ *    - Current time.
+ */
+static double now_ns( void )
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * NAME:          init_tasks
+ *
+ * DESCRIPTION:   Give every task a period between 1 s and 10 s and a first
+ *                restart time somewhere within that period.
+ *
+ * PARAMETERS:
+ *  unsigned int num_tasks
+ *    - Number of tasks.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void init_tasks( unsigned int num_tasks )
+{
+	unsigned int i;
+
+	srand( 1 );
+
+	for ( i = 0; i < num_tasks; ++i )
+	{
+		tcbs[ i ].period = 1000 + rand() % 9000;
+		tcbs[ i ].restart_time = 1 + rand() % tcbs[ i ].period;
+	}
+}
+
+/*
+ * NAME:          bench_list
+ *
+ * DESCRIPTION:   Measure the original check_blocked_tasks list walk. The
+ *                blocked list is sorted by the next deadline, so every
+ *                blocked task's restart time is compared on every tick.
+ *
+ * PARAMETERS:
+ *  unsigned int num_tasks
+ *    - Number of tasks.
+ *
+ * RETURNS:
+ *  double
+ *    - Nanoseconds per tick.
+ */
+static double bench_list( unsigned int num_tasks )
+{
+	xList blocked_tasks_list;
+	unsigned long tick_count;
+	unsigned int i;
+	double start;
+
+	vListInitialise( &blocked_tasks_list );
+	releases = 0;
+
+	for ( i = 0; i < num_tasks; ++i )
+	{
+		vListInitialiseItem( &list_items[ i ] );
+		listSET_LIST_ITEM_OWNER( &list_items[ i ], &tcbs[ i ] );
+		listSET_LIST_ITEM_VALUE( &list_items[ i ], tcbs[ i ].restart_time + tcbs[ i ].period );
+		vListInsert( &blocked_tasks_list, &list_items[ i ] );
+	}
+
+	start = now_ns();
+
+	for ( tick_count = 1; tick_count <= NUM_TICKS; ++tick_count )
+	{
+		volatile xListItem *list_item = blocked_tasks_list.xListEnd.pxNext;
+		xListItem *due = NULL;
+		int j;
+
+		for ( j = listCURRENT_LIST_LENGTH( &blocked_tasks_list ); j != 0; --j )
+		{
+			struct bench_tcb *tcb = ( struct bench_tcb * )_listGET_LIST_ITEM_OWNER( list_item );
+			volatile xListItem *next = list_item->pxNext;
+
+			if ( tcb->restart_time <= tick_count )
+			{
+				// Collect the due tasks so they can be re-blocked after the
+				// walk (pxPrevious is free while the item is out of a list).
+				vListRemove( ( xListItem * )list_item );
+				list_item->pxPrevious = due;
+				due = ( xListItem * )list_item;
+			}
+
+			list_item = next;
+		}
+
+		while ( due )
+		{
+			xListItem *next = ( xListItem * )due->pxPrevious;
+			struct bench_tcb *tcb = ( struct bench_tcb * )_listGET_LIST_ITEM_OWNER( due );
+
+			tcb->restart_time += tcb->period;
+			listSET_LIST_ITEM_VALUE( due, tcb->restart_time + tcb->period );
+			vListInsert( &blocked_tasks_list, due );
+			++releases;
+			due = next;
+		}
+	}
+
+	return ( now_ns() - start ) / NUM_TICKS;
+}
+
+/*
+ * NAME:          bench_wheel
+ *
+ * DESCRIPTION:   Measure the timing wheel.
+ *
+ * PARAMETERS:
+ *  unsigned int num_tasks
+ *    - Number of tasks.
+ *
+ * RETURNS:
+ *  double
+ *    - Nanoseconds per tick.
+ */
+static double bench_wheel( unsigned int num_tasks )
+{
+	static struct edf_release_wheel blocked_tasks;
+	unsigned long tick_count;
+	unsigned int i;
+	double start;
+
+	edf_release_wheel_init( &blocked_tasks, 1 );
+	releases = 0;
+
+	for ( i = 0; i < num_tasks; ++i )
+	{
+		tcbs[ i ].release_node.owner = &tcbs[ i ];
+		edf_release_wheel_insert( &blocked_tasks, &tcbs[ i ].release_node, tcbs[ i ].restart_time );
+	}
+
+	start = now_ns();
+
+	for ( tick_count = 1; tick_count <= NUM_TICKS; ++tick_count )
+	{
+		struct edf_wheel_node *node = edf_release_wheel_advance( &blocked_tasks, tick_count );
+
+		while ( node )
+		{
+			struct edf_wheel_node *next = node->next;
+			struct bench_tcb *tcb = ( struct bench_tcb * )node->owner;
+
+			tcb->restart_time += tcb->period;
+			edf_release_wheel_insert( &blocked_tasks, node, tcb->restart_time );
+			++releases;
+			node = next;
+		}
+	}
+
+	return ( now_ns() - start ) / NUM_TICKS;
+}
+
+int main( void )
+{
+	unsigned int i;
+
+	printf( "%8s %16s %16s %10s\n", "tasks", "xList ns/tick", "wheel ns/tick", "releases" );
+
+	for ( i = 0; i < sizeof( task_counts ) / sizeof( task_counts[ 0 ] ); ++i )
+	{
+		unsigned int num_tasks = task_counts[ i ];
+		double list_ns;
+		double wheel_ns;
+		unsigned long list_releases;
+
+		init_tasks( num_tasks );
+		list_ns = bench_list( num_tasks );
+		list_releases = releases;
+
+		init_tasks( num_tasks );
+		wheel_ns = bench_wheel( num_tasks );
+
+		if ( releases != list_releases )
+		{
+			printf( "release count mismatch: %lu vs %lu\n", list_releases, releases );
+			return 1;
+		}
+
+		printf( "%8u %16.1f %16.1f %10lu\n", num_tasks, list_ns, wheel_ns, releases );
+	}
+
+	return 0;
+}
@@ -0,0 +1,666 @@
+/*
+ * Host-side simulation of tasks sharing one resource (for example the SSP1 bus
+ * used by the GLCD) under EDF, comparing a plain mutex with the Stack Resource
+ * Policy used by lock_mutex / unlock_mutex.
+ *
+ * Time is simulated one tick at a time, and each job holds the resource for a
+ * fixed part of its execution. The priority inversion of a job is the number
+ * of ticks it had the earliest deadline of the ready jobs but another job
+ * ran.
+ *
+ * With a plain mutex, a job that needs the resource waits for its holder, and
+ * every job with a deadline between the two can run in the meantime, so the
+ * inversion grows with the work of unrelated tasks. The plain mutex is
+ * modelled here on the real EDF ready queue (edf_ready_queue_pop_if).
+ *
+ * With SRP, the jobs are run by the scheduler's own policy (edf_policy.c):
+ * released and picked with edf_policy_advance and edf_policy_next, charged
+ * with edf_policy_stop, and locking raises the system ceiling the way
+ * lock_mutex does. The scheduler can also run twice in one tick (a sporadic
+ * release, or a measured run time that rounds to 0), so in the random trials
+ * a job is sometimes dispatched, takes the resource and is preempted again
+ * at once, charged 0 ticks. The inversion of a job never exceeds one
+ * critical section of a task with a later relative deadline. The second part
+ * checks that bound, that the policy always has a job to run while jobs are
+ * ready, and that task sets accepted by the admission test
+ * (edf_admission_test_resource) never miss a deadline, on random task sets.
+ *
+ * Build (from lab4/host):
+ *   gcc -O2 -I.. ../edf_ready_queue.c ../edf_release_wheel.c ../edf_admission.c \
+ *       ../edf_cbs.c ../edf_policy.c edf_srp_simulation.c -o edf_srp_simulation
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "edf_policy.h"
+
+/*
+ * Largest number of tasks in a simulated task set.
+ */
+#define MAX_SIM_TASKS        6
+
+/*
+ * Number of random task sets checked.
+ */
+#define NUM_TRIALS           20000
+
+/*
+ * Ticks simulated per task set.
+ */
+#define SIM_TICKS            4000
+
+/*
+ * In the random trials, 1 in this many ticks starts with a job that is
+ * dispatched and preempted again without being charged.
+ */
+#define ZERO_CHARGE          4
+
+/*
+ * A simulated task and its current job. The tcb comes first, so the policy's
+ * tcb pointers are also pointers to the task.
+ */
+struct sim_task
+{
+	struct tcb tcb;
+
+	// Parameters.
+	unsigned int id;
+	unsigned long execution_time;
+	unsigned long deadline;
+	unsigned long period;
+	unsigned long phase;
+	unsigned long cs_start;
+	unsigned long cs_length;
+
+	// Current job.
+	int active;
+	unsigned long progress;
+	unsigned long absolute_deadline;
+	unsigned long inversion;
+
+	// Results.
+	unsigned long worst_inversion;
+	unsigned int misses;
+};
+
+/*
+ * A simulated task set with one shared resource.
+ */
+struct sim
+{
+	struct sim_task tasks[ MAX_SIM_TASKS ];
+	unsigned int num_tasks;
+	unsigned long ceiling;
+	struct sim_task *holder;
+	struct edf_ready_queue ready;
+	struct edf_policy policy;
+};
+
+/*
+ * NAME:          wants_resource
+ *
+ * DESCRIPTION:   Check if a job's next tick is inside its critical section.
+ *
+ * PARAMETERS:
+ *  struct sim_task *task
+ *    - The task.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if it is, 0 if not.
+ */
+static int wants_resource( struct sim_task *task )
+{
+	return task->cs_length && task->progress >= task->cs_start && task->progress < task->cs_start + task->cs_length;
+}
+
+/*
+ * NAME:          not_waiting
+ *
+ * DESCRIPTION:   Check if a ready job can run with a plain mutex (it is not
+ *                waiting for a resource someone else holds).
+ *
+ * PARAMETERS:
+ *  void *owner
+ *    - The job's task.
+ *  void *context
+ *    - The simulation.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if it can, 0 if not.
+ */
+static int not_waiting( void *owner, void *context )
+{
+	struct sim_task *task = ( struct sim_task * )owner;
+	struct sim *sim = ( struct sim * )context;
+
+	return !( wants_resource( task ) && sim->holder && sim->holder != task );
+}
+
+/*
+ * NAME:          run_plain
+ *
+ * DESCRIPTION:   Simulate a task set with a plain mutex.
+ *
+ * PARAMETERS:
+ *  struct sim *sim
+ *    - The simulation (task parameters must be filled in).
+ *  unsigned long ticks
+ *    - Number of ticks to simulate.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void run_plain( struct sim *sim, unsigned long ticks )
+{
+	unsigned long t;
+	unsigned int i;
+
+	sim->holder = 0;
+	edf_ready_queue_init( &sim->ready );
+
+	for ( i = 0; i < sim->num_tasks; ++i )
+	{
+		struct sim_task *task = &sim->tasks[ i ];
+
+		task->active = 0;
+		task->worst_inversion = 0;
+		task->misses = 0;
+	}
+
+	for ( t = 0; t < ticks; ++t )
+	{
+		struct sim_task *first;
+		struct sim_task *running;
+
+		// Release new jobs. A job still running at its next release has
+		// missed its deadline, and the simulation stops there.
+		for ( i = 0; i < sim->num_tasks; ++i )
+		{
+			struct sim_task *task = &sim->tasks[ i ];
+
+			if ( t < task->phase || ( t - task->phase ) % task->period != 0 )
+			{
+				continue;
+			}
+
+			if ( task->active )
+			{
+				++task->misses;
+				return;
+			}
+
+			task->active = 1;
+			task->progress = 0;
+			task->inversion = 0;
+			task->absolute_deadline = t + task->deadline;
+			edf_ready_queue_insert( &sim->ready, task->absolute_deadline, task->id, task );
+		}
+
+		first = ( struct sim_task * )edf_ready_queue_peek( &sim->ready );
+		running = ( struct sim_task * )edf_ready_queue_pop_if( &sim->ready, not_waiting, sim );
+
+		if ( !running )
+		{
+			continue;
+		}
+
+		if ( wants_resource( running ) && running->progress == running->cs_start )
+		{
+			sim->holder = running;
+		}
+
+		// The job with the earliest deadline is being held up.
+		if ( first != running )
+		{
+			++first->inversion;
+		}
+
+		++running->progress;
+
+		if ( running->cs_length && running->progress == running->cs_start + running->cs_length )
+		{
+			sim->holder = 0;
+		}
+
+		if ( running->progress == running->execution_time )
+		{
+			running->active = 0;
+
+			if ( t + 1 > running->absolute_deadline )
+			{
+				++running->misses;
+			}
+
+			if ( running->inversion > running->worst_inversion )
+			{
+				running->worst_inversion = running->inversion;
+			}
+		}
+		else
+		{
+			edf_ready_queue_insert( &sim->ready, running->absolute_deadline, running->id, running );
+		}
+	}
+}
+
+/*
+ * NAME:          srp_dispatch
+ *
+ * DESCRIPTION:   Give the CPU to the job the policy picks, as the scheduler
+ *                does with edf_policy_next and resume_task. A job that is at
+ *                the start of its critical section locks the resource first,
+ *                raising the system ceiling as lock_mutex does.
+ *
+ * PARAMETERS:
+ *  struct sim *sim
+ *    - The simulation.
+ *
+ * RETURNS:
+ *  struct sim_task *
+ *    - The job's task, or 0 if the policy picked none.
+ */
+static struct sim_task *srp_dispatch( struct sim *sim )
+{
+	struct sim_task *running = ( struct sim_task * )edf_policy_next( &sim->policy );
+
+	if ( running && sim->holder != running && wants_resource( running ) && running->progress == running->cs_start )
+	{
+		sim->holder = running;
+		sim->policy.system_ceiling = sim->ceiling;
+	}
+
+	return running;
+}
+
+/*
+ * NAME:          srp_stop
+ *
+ * DESCRIPTION:   Take the CPU back from a job and charge it, as the scheduler
+ *                does with edf_policy_stop. A job that completes ends its
+ *                inversion count, and the next one starts from scratch.
+ *
+ * PARAMETERS:
+ *  struct sim *sim
+ *    - The simulation.
+ *  struct sim_task *running
+ *    - The job's task.
+ *  unsigned long ran
+ *    - Ticks charged.
+ *  unsigned long now
+ *    - Current tick count.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void srp_stop( struct sim *sim, struct sim_task *running, unsigned long ran, unsigned long now )
+{
+	if ( edf_policy_stop( &sim->policy, &running->tcb, ran, now ) != EDF_JOB_PREEMPTED )
+	{
+		if ( running->inversion > running->worst_inversion )
+		{
+			running->worst_inversion = running->inversion;
+		}
+
+		running->progress = 0;
+		running->inversion = 0;
+	}
+}
+
+/*
+ * NAME:          run_srp
+ *
+ * DESCRIPTION:   Simulate a task set with SRP, on the scheduler's policy.
+ *
+ * PARAMETERS:
+ *  struct sim *sim
+ *    - The simulation (task parameters must be filled in).
+ *  unsigned long ticks
+ *    - Number of ticks to simulate.
+ *  unsigned int zero_charge
+ *    - 1 in zero_charge ticks starts with a job that is dispatched and
+ *      preempted again without being charged (0 for never).
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the simulation was consistent, 0 if a job that had started found
+ *      the resource locked, or jobs were ready but the policy picked none
+ *      (which SRP should both rule out).
+ */
+static int run_srp( struct sim *sim, unsigned long ticks, unsigned int zero_charge )
+{
+	unsigned long t;
+	unsigned int i;
+
+	sim->holder = 0;
+	sim->ceiling = EDF_NO_CEILING;
+	edf_policy_init( &sim->policy, 0 );
+
+	for ( i = 0; i < sim->num_tasks; ++i )
+	{
+		struct sim_task *task = &sim->tasks[ i ];
+		struct edf_task_params params;
+
+		params.execution_time = task->execution_time;
+		params.deadline = task->deadline;
+		params.period = task->period;
+		params.critical_section = task->cs_length;
+		params.ceiling = EDF_NO_CEILING;
+
+		edf_policy_setup_task( &task->tcb, &params, task->id, 0, 0 );
+		edf_policy_release( &sim->policy, &task->tcb, task->phase, 0 );
+
+		task->progress = 0;
+		task->inversion = 0;
+		task->worst_inversion = 0;
+
+		if ( task->cs_length && task->deadline < sim->ceiling )
+		{
+			sim->ceiling = task->deadline;
+		}
+	}
+
+	for ( t = 0; t < ticks; ++t )
+	{
+		struct sim_task *first;
+		struct sim_task *running;
+
+		edf_policy_advance( &sim->policy, t );
+
+		if ( zero_charge && rand() % zero_charge == 0 && ( running = srp_dispatch( sim ) ) )
+		{
+			srp_stop( sim, running, 0, t );
+		}
+
+		first = ( struct sim_task * )edf_ready_queue_peek( &sim->policy.ready_tasks );
+		running = srp_dispatch( sim );
+
+		if ( !running )
+		{
+			if ( first )
+			{
+				return 0;
+			}
+
+			continue;
+		}
+
+		if ( wants_resource( running ) && sim->holder != running )
+		{
+			return 0;
+		}
+
+		// The job with the earliest deadline is being held up.
+		if ( first != running )
+		{
+			++first->inversion;
+		}
+
+		++running->progress;
+
+		if ( sim->holder == running && running->progress == running->cs_start + running->cs_length )
+		{
+			// Unlocking puts the ceiling back, as unlock_mutex does.
+			sim->holder = 0;
+			sim->policy.system_ceiling = EDF_NO_CEILING;
+		}
+
+		srp_stop( sim, running, 1, t + 1 );
+	}
+
+	for ( i = 0; i < sim->num_tasks; ++i )
+	{
+		sim->tasks[ i ].misses = sim->tasks[ i ].tcb.stats.misses;
+	}
+
+	return 1;
+}
+
+/*
+ * NAME:          srp_bound
+ *
+ * DESCRIPTION:   Longest SRP blocking of a task: the longest critical section
+ *                of a task with a later relative deadline, if the resource's
+ *                ceiling is at or before the task's deadline.
+ *
+ * PARAMETERS:
+ *  struct sim *sim
+ *    - The simulation.
+ *  struct sim_task *task
+ *    - The task.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - The bound in ticks.
+ */
+static unsigned long srp_bound( struct sim *sim, struct sim_task *task )
+{
+	unsigned long bound = 0;
+	unsigned int i;
+
+	if ( sim->ceiling > task->deadline )
+	{
+		return 0;
+	}
+
+	for ( i = 0; i < sim->num_tasks; ++i )
+	{
+		struct sim_task *other = &sim->tasks[ i ];
+
+		if ( other->deadline > task->deadline && other->cs_length > bound )
+		{
+			bound = other->cs_length;
+		}
+	}
+
+	return bound;
+}
+
+/*
+ * NAME:          set_task
+ *
+ * DESCRIPTION:   Fill in the parameters of a simulated task.
+ *
+ * PARAMETERS:
+ *  struct sim_task *task
+ *    - The task.
+ *  unsigned int id
+ *    - Task ID.
+ *  unsigned long execution_time, deadline, period, phase
+ *    - Timing parameters.
+ *  unsigned long cs_start, cs_length
+ *    - Critical section (cs_length 0 for none).
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void set_task( struct sim_task *task, unsigned int id, unsigned long execution_time, unsigned long deadline, unsigned long period,
+                      unsigned long phase, unsigned long cs_start, unsigned long cs_length )
+{
+	task->id = id;
+	task->execution_time = execution_time;
+	task->deadline = deadline;
+	task->period = period;
+	task->phase = phase;
+	task->cs_start = cs_start;
+	task->cs_length = cs_length;
+}
+
+/*
+ * NAME:          scenario
+ *
+ * DESCRIPTION:   The classic inversion: a long task L holds the bus, the short
+ *                task H needs it, and a medium task M with no critical section
+ *                is released in between. Prints the worst inversion of H for
+ *                growing M.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void scenario( void )
+{
+	static struct sim sim;
+	unsigned long m;
+
+	printf("Inversion of H (C=2 D=T=20, bus for 1 tick) with L holding the bus for 4 ticks:\n");
+	printf("%10s %14s %14s %10s\n", "M C", "plain mutex", "SRP", "SRP bound");
+
+	for ( m = 2; m <= 14; m += 4 )
+	{
+		unsigned long plain;
+
+		sim.num_tasks = 3;
+		set_task( &sim.tasks[ 0 ], 0, 2, 20, 20, 2, 0, 1 );     // H
+		set_task( &sim.tasks[ 1 ], 1, m, 40, 40, 3, 0, 0 );     // M
+		set_task( &sim.tasks[ 2 ], 2, 6, 80, 80, 0, 1, 4 );     // L
+
+		run_plain( &sim, 80 );
+		plain = sim.tasks[ 0 ].worst_inversion;
+		run_srp( &sim, 80, 0 );
+
+		printf("%10lu %14lu %14lu %10lu\n", m, plain, sim.tasks[ 0 ].worst_inversion, srp_bound( &sim, &sim.tasks[ 0 ] ));
+	}
+}
+
+/*
+ * NAME:          random_trials
+ *
+ * DESCRIPTION:   Check the SRP bound and the admission test on random task
+ *                sets.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  int
+ *    - Number of failures.
+ */
+static int random_trials( void )
+{
+	static const unsigned long periods[] = { 10, 20, 25, 40, 50, 100 };
+	static struct sim sim;
+	unsigned long worst_plain_excess = 0;
+	unsigned int admitted = 0;
+	int failures = 0;
+	unsigned int trial;
+
+	srand( 1 );
+
+	for ( trial = 0; trial < NUM_TRIALS; ++trial )
+	{
+		struct edf_admission admission;
+		struct edf_resource_use use;
+		unsigned long ceiling = EDF_NO_CEILING;
+		unsigned long users = 0;
+		int schedulable = 1;
+		unsigned int i;
+
+		sim.num_tasks = 2 + rand() % ( MAX_SIM_TASKS - 1 );
+		edf_admission_init( &admission );
+
+		for ( i = 0; i < sim.num_tasks; ++i )
+		{
+			unsigned long period = periods[ rand() % 6 ];
+			unsigned long deadline = period / 2 + rand() % ( period / 2 + 1 );
+			unsigned long execution_time = 1 + rand() % ( deadline / 4 );
+			unsigned long cs_length = ( rand() % 2 ) ? 1 + rand() % execution_time : 0;
+			struct edf_task_params params;
+
+			set_task( &sim.tasks[ i ], i, execution_time, deadline, period, rand() % period,
+			          cs_length ? rand() % ( execution_time - cs_length + 1 ) : 0, cs_length );
+
+			params.execution_time = execution_time;
+			params.deadline = deadline;
+			params.period = period;
+			params.critical_section = 0;
+			params.ceiling = EDF_NO_CEILING;
+
+			if ( !edf_admission_test( &admission, &params ) )
+			{
+				schedulable = 0;
+			}
+
+			edf_admission_add( &admission, &params );
+		}
+
+		// Declare the resource uses the same way use_mutex does.
+		for ( i = 0; i < sim.num_tasks && schedulable; ++i )
+		{
+			struct sim_task *task = &sim.tasks[ i ];
+
+			if ( !task->cs_length )
+			{
+				continue;
+			}
+
+			use.task = i;
+			use.critical_section = task->cs_length;
+			use.ceiling = ( task->deadline < ceiling ) ? task->deadline : ceiling;
+			use.users = users;
+
+			if ( !edf_admission_test_resource( &admission, &use ) )
+			{
+				schedulable = 0;
+				break;
+			}
+
+			edf_admission_add_resource( &admission, &use );
+			ceiling = use.ceiling;
+			users |= 1UL << i;
+		}
+
+		if ( !run_srp( &sim, SIM_TICKS, ZERO_CHARGE ) )
+		{
+			printf("trial %u: a job found the resource locked, or none could run, under SRP\n", trial);
+			++failures;
+		}
+
+		for ( i = 0; i < sim.num_tasks; ++i )
+		{
+			struct sim_task *task = &sim.tasks[ i ];
+
+			if ( task->worst_inversion > srp_bound( &sim, task ) )
+			{
+				printf("trial %u: task %u inversion %lu above bound %lu\n", trial, i, task->worst_inversion, srp_bound( &sim, task ));
+				++failures;
+			}
+
+			if ( schedulable && task->misses )
+			{
+				printf("trial %u: admitted task %u missed %u deadlines\n", trial, i, task->misses);
+				++failures;
+			}
+		}
+
+		admitted += schedulable;
+
+		// How far past the SRP bound a plain mutex goes on the same set.
+		run_plain( &sim, SIM_TICKS );
+
+		for ( i = 0; i < sim.num_tasks; ++i )
+		{
+			unsigned long bound = srp_bound( &sim, &sim.tasks[ i ] );
+
+			if ( sim.tasks[ i ].worst_inversion > bound && sim.tasks[ i ].worst_inversion - bound > worst_plain_excess )
+			{
+				worst_plain_excess = sim.tasks[ i ].worst_inversion - bound;
+			}
+		}
+	}
+
+	printf("\n%u random task sets (%u admitted): %d failures\n", NUM_TRIALS, admitted, failures);
+	printf("Worst plain mutex inversion beyond the SRP bound: %lu ticks\n", worst_plain_excess);
+
+	return failures;
+}
+
+int main( void )
+{
+	scenario();
+
+	return random_trials() ? 1 : 0;
+}
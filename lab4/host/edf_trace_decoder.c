@@ -0,0 +1,268 @@
+/*
+ * Host-side decoder for the binary EDF trace (edf_trace.h).
+ *
+ * The input is the raw data from ITM stimulus port 1 (for example saved from
+ * the debugger's SWO viewer, or by "orbcat -c 1"), which is a sequence of
+ * records of two 32-bit little-endian words: the DWT cycle count, then the
+ * event in the upper 16 bits and the task in the lower 16 bits. The output is
+ * a JSON timeline in the Chrome trace event format, which can be opened in
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Each task gets its own track, with a slice from each resume to the next
+ * preemption or completion. Scheduler runs, releases, completions, deadline
+ * misses and lost events are shown as instant events. The cycle counter wraps
+ * every 2^32 cycles, which is undone as long as no gap between events is
+ * longer than half of that.
+ *
+ * Usage:
+ *   edf_trace_decoder [-f cpu_hz] trace.bin > trace.json
+ *
+ * Build (from lab4/host):
+ *   gcc -O2 -I.. edf_trace_decoder.c -o edf_trace_decoder
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "edf_trace.h"
+
+/*
+ * Default clock rate of the cycle counter (configCPU_CLOCK_HZ).
+ */
+#define DEFAULT_CPU_HZ       12000000.0
+
+/*
+ * Largest task ID that gets its own track.
+ */
+#define MAX_TRACKS           256
+
+/*
+ * Track used for the scheduler and for events without a task.
+ */
+#define SCHEDULER_TRACK      0
+
+static int first_event = 1;
+
+/*
+ * NAME:          read_word
+ *
+ * DESCRIPTION:   Read a 32-bit little-endian word.
+ *
+ * PARAMETERS:
+ *  FILE *file
+ *    - File to read from.
+ *  unsigned long *word
+ *    - Where to put the word.
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if a whole word was read, 0 at the end of the file.
+ */
+static int read_word( FILE *file, unsigned long *word )
+{
+	unsigned char bytes[ 4 ];
+
+	if ( fread( bytes, 1, sizeof( bytes ), file ) != sizeof( bytes ) )
+	{
+		return 0;
+	}
+
+	*word = bytes[ 0 ] | ( bytes[ 1 ] << 8 ) | ( bytes[ 2 ] << 16 ) | ( ( unsigned long )bytes[ 3 ] << 24 );
+
+	return 1;
+}
+
+/*
+ * NAME:          emit
+ *
+ * DESCRIPTION:   Print one trace event object.
+ *
+ * PARAMETERS:
+ *  const char *name
+ *    - Event name.
+ *  char phase
+ *    - 'B' (slice begins), 'E' (slice ends) or 'i' (instant).
+ *  unsigned int track
+ *    - Track (thread ID) of the event.
+ *  double us
+ *    - Time in microseconds.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void emit( const char *name, char phase, unsigned int track, double us )
+{
+	printf("%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f%s}",
+		first_event ? "" : ",", name, phase, track, us, ( phase == 'i' ) ? ",\"s\":\"t\"" : "");
+	first_event = 0;
+}
+
+/*
+ * NAME:          name_track
+ *
+ * DESCRIPTION:   Print the metadata event that names a track.
+ *
+ * PARAMETERS:
+ *  unsigned int track
+ *    - Track to name.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void name_track( unsigned int track )
+{
+	if ( track == SCHEDULER_TRACK )
+	{
+		printf("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Scheduler\"}}",
+			first_event ? "" : ",");
+	}
+	else
+	{
+		printf("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Task #%u\"}}",
+			first_event ? "" : ",", track, track - 1);
+	}
+
+	first_event = 0;
+}
+
+int main( int argc, char *argv[] )
+{
+	static unsigned char named[ MAX_TRACKS + 1 ];
+	static unsigned char running[ MAX_TRACKS + 1 ];
+	double cpu_hz = DEFAULT_CPU_HZ;
+	unsigned long long time = 0;
+	unsigned long last_timestamp = 0;
+	unsigned long timestamp;
+	unsigned long word;
+	unsigned long records = 0;
+	double us = 0;
+	char name[ 32 ];
+	unsigned int track;
+	FILE *file;
+	int option;
+
+	while ( ( option = getopt( argc, argv, "f:" ) ) != -1 )
+	{
+		if ( option != 'f' )
+		{
+			fprintf( stderr, "usage: %s [-f cpu_hz] trace.bin > trace.json\n", argv[ 0 ] );
+			return 1;
+		}
+
+		cpu_hz = atof( optarg );
+	}
+
+	if ( optind >= argc )
+	{
+		fprintf( stderr, "usage: %s [-f cpu_hz] trace.bin > trace.json\n", argv[ 0 ] );
+		return 1;
+	}
+
+	file = fopen( argv[ optind ], "rb" );
+
+	if ( !file )
+	{
+		perror( argv[ optind ] );
+		return 1;
+	}
+
+	printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	while ( read_word( file, &timestamp ) && read_word( file, &word ) )
+	{
+		unsigned int event = word >> 16;
+		unsigned int task = word & 0xFFFF;
+		unsigned long delta = ( timestamp - last_timestamp ) & 0xFFFFFFFFUL;
+
+		// Events from interrupts can be slightly out of order; only a big
+		// step back is taken as the counter wrapping.
+		if ( records == 0 )
+		{
+			time = timestamp;
+		}
+		else if ( delta < 0x80000000UL )
+		{
+			time += delta;
+		}
+		else
+		{
+			time -= 0x100000000ULL - delta;
+		}
+
+		last_timestamp = timestamp;
+		++records;
+		us = time * 1e6 / cpu_hz;
+
+		// The task field of a lost event is the number of events lost.
+		track = ( event == EDF_TRACE_LOST || task == EDF_TRACE_NO_TASK || task >= MAX_TRACKS ) ? SCHEDULER_TRACK : task + 1;
+
+		if ( !named[ track ] )
+		{
+			name_track( track );
+			named[ track ] = 1;
+		}
+
+		switch ( event )
+		{
+			case EDF_TRACE_SCHEDULER:
+				emit( "scheduler", 'i', SCHEDULER_TRACK, us );
+				break;
+
+			case EDF_TRACE_RESUME:
+				if ( !running[ track ] )
+				{
+					emit( "running", 'B', track, us );
+					running[ track ] = 1;
+				}
+				break;
+
+			case EDF_TRACE_PREEMPT:
+			case EDF_TRACE_COMPLETE:
+			case EDF_TRACE_MISS:
+				if ( running[ track ] )
+				{
+					emit( "running", 'E', track, us );
+					running[ track ] = 0;
+				}
+
+				if ( event == EDF_TRACE_COMPLETE )
+				{
+					emit( "complete", 'i', track, us );
+				}
+				else if ( event == EDF_TRACE_MISS )
+				{
+					emit( "deadline miss", 'i', track, us );
+				}
+				break;
+
+			case EDF_TRACE_RELEASE:
+				emit( "release", 'i', track, us );
+				break;
+
+			case EDF_TRACE_LOST:
+				snprintf( name, sizeof( name ), "lost %u events", task );
+				emit( name, 'i', SCHEDULER_TRACK, us );
+				break;
+
+			default:
+				fprintf( stderr, "record %lu: unknown event %u\n", records - 1, event );
+				break;
+		}
+	}
+
+	// Close the slices of tasks still running at the end of the trace.
+	for ( track = 1; track <= MAX_TRACKS; ++track )
+	{
+		if ( running[ track ] )
+		{
+			emit( "running", 'E', track, us );
+		}
+	}
+
+	printf("\n]}\n");
+	fclose( file );
+
+	fprintf( stderr, "%lu events\n", records );
+
+	return 0;
+}
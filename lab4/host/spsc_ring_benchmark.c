@@ -0,0 +1,340 @@
+/*
+ * Host-side benchmark comparing interrupt-to-task streaming through the SPSC
+ * ring buffer (spsc_ring.c) against a FreeRTOS queue, on the POSIX port.
+ *
+ * The tick interrupt stands in for a high rate producer such as the ADC
+ * conversion handler: on every tick it puts a burst of BURST_ITEMS words,
+ * with xQueueSendFromISR in the first phase and spsc_ring_put_from_isr in the
+ * second. A consumer task sleeps until there is data, then takes everything
+ * there is. For each phase the benchmark reports the time the interrupt
+ * handler spends per item, the time the consumer spends per item once it is
+ * awake, and how often the consumer had to be woken up.
+ *
+ * Build (from lab4):
+ *   gcc -O2 -I. -IFreeRTOS-Source/include -IFreeRTOS-Source/portable/GCC/Posix \
+ *       FreeRTOS-Source/tasks.c FreeRTOS-Source/queue.c FreeRTOS-Source/list.c \
+ *       FreeRTOS-Source/timers.c FreeRTOS-Source/portable/GCC/Posix/port.c \
+ *       spsc_ring.c host/spsc_ring_benchmark.c -o spsc_ring_benchmark
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "spsc_ring.h"
+
+/*
+ * Items the interrupt puts per tick, and ticks per phase.
+ */
+#define BURST_ITEMS          16
+#define PHASE_TICKS          20000
+
+/*
+ * Items the queue and the ring hold.
+ */
+#define BUFFER_SIZE          64
+
+/*
+ * Host stack words for each task (the stack is only used by the port to
+ * point at the host context).
+ */
+#define STACK_SIZE           configMINIMAL_STACK_SIZE
+
+enum phase
+{
+	PHASE_QUEUE,
+	PHASE_RING,
+	PHASE_DONE
+};
+
+/*
+ * Measurements for a phase.
+ *
+ * MEMBERS:
+ *   double isr_ns, consumer_ns
+ *     - Time spent putting and taking items.
+ *   unsigned long put, taken, wakeups, dropped
+ *     - Items put and taken, times the consumer was woken, items that did
+ *       not fit.
+ *   unsigned long errors
+ *     - Items taken out of order.
+ */
+struct phase_stats
+{
+	double isr_ns;
+	double consumer_ns;
+	unsigned long put;
+	unsigned long taken;
+	unsigned long wakeups;
+	unsigned long dropped;
+	unsigned long errors;
+};
+
+static const char *phase_names[] = { "xQueueSendFromISR", "spsc_ring" };
+
+static volatile enum phase phase = PHASE_QUEUE;
+static unsigned long phase_ticks;
+static unsigned long next_item;
+static struct phase_stats stats[ PHASE_DONE ];
+
+static xQueueHandle queue;
+static struct spsc_ring ring;
+static unsigned long ring_items[ BUFFER_SIZE ];
+
+#if configSUPPORT_STATIC_ALLOCATION
+static xStaticQueue queue_buffer;
+static unsigned long queue_storage[ BUFFER_SIZE ];
+static xStaticTask consumer_buffer;
+static portSTACK_TYPE consumer_stack[ STACK_SIZE ];
+static xStaticTask idle_task_buffer;
+static portSTACK_TYPE idle_task_stack[ STACK_SIZE ];
+#endif
+
+static xTaskHandle consumer_handle;
+
+unsigned long ulTaskNumber[ configEXPECTED_NO_RUNNING_TASKS ];
+
+/*
+ * NAME:          now_ns
+ *
+ * DESCRIPTION:   Monotonic time in nanoseconds.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  double
+ *    - Current time.
+ */
+static double now_ns( void )
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * NAME:          vApplicationHostTickHook
+ *
+ * DESCRIPTION:   The producer interrupt. Puts a burst of items on the queue or
+ *                the ring, and moves on to the next phase once the current
+ *                one has run its ticks and the consumer has caught up.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+void vApplicationHostTickHook( void )
+{
+	struct phase_stats *s;
+	signed portBASE_TYPE woken = pdFALSE;
+	double start;
+	unsigned int i;
+
+	if ( phase == PHASE_DONE )
+	{
+		return;
+	}
+
+	s = &stats[ phase ];
+
+	if ( phase_ticks == PHASE_TICKS )
+	{
+		if ( s->taken == s->put )
+		{
+			next_item = 0;
+			phase_ticks = 0;
+			phase = ( enum phase )( phase + 1 );
+
+			// Wake the consumer if it is asleep on the ring, so it sees the
+			// phase change. The item is not counted.
+			if ( phase == PHASE_DONE )
+			{
+				spsc_ring_put_from_isr( &ring, 0, &woken );
+			}
+		}
+
+		return;
+	}
+
+	start = now_ns();
+
+	for ( i = 0; i < BURST_ITEMS; ++i )
+	{
+		if ( phase == PHASE_QUEUE )
+		{
+			if ( xQueueSendFromISR( queue, &next_item, &woken ) != pdPASS )
+			{
+				++s->dropped;
+				continue;
+			}
+		}
+		else if ( !spsc_ring_put_from_isr( &ring, next_item, &woken ) )
+		{
+			++s->dropped;
+			continue;
+		}
+
+		++next_item;
+		++s->put;
+	}
+
+	s->isr_ns += now_ns() - start;
+	++phase_ticks;
+
+	// The port switches tasks after every tick, so woken needs no action.
+	( void )woken;
+}
+
+/*
+ * NAME:          consumer
+ *
+ * DESCRIPTION:   Sleep until there are items, then take all of them.
+ *
+ * PARAMETERS:
+ *  void *parameters
+ *    - Not used.
+ *
+ * RETURNS:
+ *  N/A
+ */
+static void consumer( void *parameters )
+{
+	unsigned long items[ BUFFER_SIZE ];
+	unsigned long expected = 0;
+	enum phase current = PHASE_QUEUE;
+	struct phase_stats *s;
+	unsigned long count;
+	unsigned long i;
+	double start;
+
+	( void )parameters;
+
+	for ( ;; )
+	{
+		if ( phase != current )
+		{
+			current = phase;
+			expected = 0;
+
+			if ( current == PHASE_DONE )
+			{
+				break;
+			}
+		}
+
+		s = &stats[ current ];
+
+		// Wait for the first item (not timed), then take the rest.
+		if ( current == PHASE_QUEUE )
+		{
+			if ( xQueueReceive( queue, &items[ 0 ], 1 ) != pdPASS )
+			{
+				continue;
+			}
+
+			++s->wakeups;
+			count = 1;
+			start = now_ns();
+
+			while ( count < BUFFER_SIZE && xQueueReceive( queue, &items[ count ], 0 ) == pdPASS )
+			{
+				++count;
+			}
+		}
+		else
+		{
+			if ( ring.head == ring.tail )
+			{
+				spsc_ring_wait( &ring );
+
+				if ( phase != current )
+				{
+					continue;
+				}
+
+				++s->wakeups;
+			}
+
+			start = now_ns();
+			count = spsc_ring_get( &ring, items, BUFFER_SIZE );
+		}
+
+		s->consumer_ns += now_ns() - start;
+
+		for ( i = 0; i < count; ++i )
+		{
+			if ( items[ i ] != expected++ )
+			{
+				++s->errors;
+				expected = items[ i ] + 1;
+			}
+		}
+
+		s->taken += count;
+	}
+
+	vTaskSuspendAll();
+
+	printf( "%-18s %12s %12s %10s %10s %8s %7s\n", "path", "isr ns/item", "task ns/item", "items", "wakeups", "dropped", "errors" );
+
+	for ( i = 0; i < PHASE_DONE; ++i )
+	{
+		s = &stats[ i ];
+		printf( "%-18s %12.1f %12.1f %10lu %10lu %8lu %7lu\n", phase_names[ i ],
+		        s->isr_ns / s->put, s->consumer_ns / s->taken, s->taken, s->wakeups, s->dropped, s->errors );
+	}
+
+	exit( 0 );
+}
+
+#if configSUPPORT_STATIC_ALLOCATION
+/*
+ * NAME:          vApplicationGetIdleTaskMemory
+ *
+ * DESCRIPTION:   Give the kernel the memory for the idle task.
+ *
+ * PARAMETERS:
+ *  xStaticTask **task_buffer
+ *    - Where to put the idle task's TCB memory.
+ *  portSTACK_TYPE **stack
+ *    - Where to put the idle task's stack.
+ *  unsigned short *stack_size
+ *    - Where to put the size of the stack, in words.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void vApplicationGetIdleTaskMemory( xStaticTask **task_buffer, portSTACK_TYPE **stack, unsigned short *stack_size )
+{
+	*task_buffer = &idle_task_buffer;
+	*stack = idle_task_stack;
+	*stack_size = STACK_SIZE;
+}
+#endif
+
+void vApplicationIdleHook( void )
+{
+}
+
+int main( void )
+{
+#if configSUPPORT_STATIC_ALLOCATION
+	queue = xQueueCreateStatic( BUFFER_SIZE, sizeof( unsigned long ), ( unsigned char * )queue_storage, &queue_buffer );
+	xTaskCreateStatic( consumer, ( const signed char * )"consumer", STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &consumer_handle, consumer_stack, &consumer_buffer );
+#else
+	queue = xQueueCreate( BUFFER_SIZE, sizeof( unsigned long ) );
+	xTaskCreate( consumer, ( const signed char * )"consumer", STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &consumer_handle );
+#endif
+
+	spsc_ring_init( &ring, ring_items, BUFFER_SIZE, consumer_handle );
+
+	vTaskStartScheduler();
+
+	return 1;
+}
@@ -14,6 +14,13 @@ the Keil simulator IDE. */
 #define mainITM_Port32(n)    ( *( ( volatile unsigned long * )( 0xE0000000 + 4 * n ) ) )
 #define mainDEMCR            ( *( ( volatile unsigned long * )( 0xE000EDFC ) ) )
 #define mainTRCENA           0x01000000
+#define mainITM_TER          ( *( ( volatile unsigned long * )( 0xE0000E00 ) ) )
+
+/*
+ * ITM stimulus port the binary trace (edf_trace.h) is sent on, so it does not
+ * mix with the printf() output on port 0.
+ */
+#define TRACE_ITM_PORT       1
 
 #define NUM_TASKS            3
 
@@ -40,6 +47,14 @@ the Keil simulator IDE. */
 #define TASK0_PERIOD         ( 4000 / portTICK_RATE_MS ) // 4 s before restarting
 #define TASK1_PERIOD         ( 6000 / portTICK_RATE_MS ) // 6 s before restarting
 #define TASK2_PERIOD         ( 8000 / portTICK_RATE_MS ) // 8 s before restarting
+
+/*
+ * Deadline for tasks (time after each restart by which a task should have
+ * completed). Can be shorter than the period.
+ */
+#define TASK0_DEADLINE       TASK0_PERIOD
+#define TASK1_DEADLINE       TASK1_PERIOD
+#define TASK2_DEADLINE       TASK2_PERIOD
 /*-----------------------------------------------------------*/
 
 /*
@@ -52,10 +67,15 @@ struct edf_scheduler_data edf_scheduler_data;
  */
 struct tcb tcbs[ NUM_TASKS ];
 
+#if configSUPPORT_STATIC_ALLOCATION
 /*
- * Array to keep track of task list items.
+ * Memory for the tasks and the idle task, so the kernel needs no heap.
  */
-xListItem list_items[ NUM_TASKS ];
+static xStaticTask task_buffers[ NUM_TASKS ];
+static portSTACK_TYPE task_stacks[ NUM_TASKS ][ configMINIMAL_STACK_SIZE ];
+static xStaticTask idle_task_buffer;
+static portSTACK_TYPE idle_task_stack[ configMINIMAL_STACK_SIZE ];
+#endif
 
 /* One array position is used for each task created by this demo.  The
 variables in this array are set and cleared by the trace macros within
@@ -83,6 +103,61 @@ int fputc( int iChar, FILE *pxNotUsed )
   	return( iChar );
 }
 
+/*
+ * NAME:          vApplicationIdleHook
+ *
+ * DESCRIPTION:   Send recorded trace events out over ITM while the CPU is
+ *                idle. Only waits on the ITM FIFO between the two words of an
+ *                event, so the idle task stays responsive.
+ *
+ * PARAMETERS:
+ *  N/A
+ *
+ * RETURNS:
+ *  N/A
+ */
+void vApplicationIdleHook( void )
+{
+	struct edf_trace_record record;
+
+	if( !( mainDEMCR & mainTRCENA ) || !( mainITM_TER & ( 1 << TRACE_ITM_PORT ) ) )
+	{
+		return;
+	}
+
+	while( mainITM_Port32( TRACE_ITM_PORT ) != 0 && edf_trace_read( &record, 1 ) )
+	{
+		mainITM_Port32( TRACE_ITM_PORT ) = record.timestamp;
+		while( mainITM_Port32( TRACE_ITM_PORT ) == 0 );
+		mainITM_Port32( TRACE_ITM_PORT ) = record.event;
+	}
+}
+
+#if configSUPPORT_STATIC_ALLOCATION
+/*
+ * NAME:          vApplicationGetIdleTaskMemory
+ *
+ * DESCRIPTION:   Give the kernel the memory for the idle task.
+ *
+ * PARAMETERS:
+ *  xStaticTask **task_buffer
+ *    - Where to put the idle task's TCB memory.
+ *  portSTACK_TYPE **stack
+ *    - Where to put the idle task's stack.
+ *  unsigned short *stack_size
+ *    - Where to put the size of the stack, in words.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void vApplicationGetIdleTaskMemory( xStaticTask **task_buffer, portSTACK_TYPE **stack, unsigned short *stack_size )
+{
+	*task_buffer = &idle_task_buffer;
+	*stack = idle_task_stack;
+	*stack_size = configMINIMAL_STACK_SIZE;
+}
+#endif
+
 /*
  * NAME:          task
  *
@@ -97,6 +172,8 @@ int fputc( int iChar, FILE *pxNotUsed )
  */
 void task( void *parameters )
 {
+	( void )parameters;
+
 	for( ;; );
 }
 
@@ -105,20 +182,27 @@ int main( void )
 	initialize_edf_scheduler( &edf_scheduler_data, SCHEDULER_PRIORITY );
 
 	// Create 3 tasks.
-	xTaskCreate( task, "task0", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[0].handle );
-	xTaskCreate( task, "task1", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[1].handle );
-	xTaskCreate( task, "task2", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[2].handle );
+#if configSUPPORT_STATIC_ALLOCATION
+	xTaskCreateStatic( task, ( const signed char * )"task0", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[0].handle, task_stacks[0], &task_buffers[0] );
+	xTaskCreateStatic( task, ( const signed char * )"task1", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[1].handle, task_stacks[1], &task_buffers[1] );
+	xTaskCreateStatic( task, ( const signed char * )"task2", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[2].handle, task_stacks[2], &task_buffers[2] );
+#else
+	xTaskCreate( task, ( const signed char * )"task0", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[0].handle );
+	xTaskCreate( task, ( const signed char * )"task1", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[1].handle );
+	xTaskCreate( task, ( const signed char * )"task2", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &tcbs[2].handle );
+#endif
 
 	// Initialize task info for each of the tasks.
-	initialize_task( &edf_scheduler_data, &list_items[0], &tcbs[0], 0, TASK0_EXECUTION_TIME, TASK0_PERIOD );
-	initialize_task( &edf_scheduler_data, &list_items[1], &tcbs[1], 1, TASK1_EXECUTION_TIME, TASK1_PERIOD );
-	initialize_task( &edf_scheduler_data, &list_items[2], &tcbs[2], 2, TASK2_EXECUTION_TIME, TASK2_PERIOD );
+	initialize_task( &edf_scheduler_data, &tcbs[0], 0, TASK0_EXECUTION_TIME, TASK0_DEADLINE, TASK0_PERIOD );
+	initialize_task( &edf_scheduler_data, &tcbs[1], 1, TASK1_EXECUTION_TIME, TASK1_DEADLINE, TASK1_PERIOD );
+	initialize_task( &edf_scheduler_data, &tcbs[2], 2, TASK2_EXECUTION_TIME, TASK2_DEADLINE, TASK2_PERIOD );
 
 	vTaskStartScheduler();
 
 	/* If all is well we will never reach here as the scheduler will now be
 	running.  If we do reach here then it is likely that there was insufficient
-	heap available for the idle task to be created. */
+	heap available for the idle task to be created (only possible with
+	configSUPPORT_DYNAMIC_ALLOCATION). */
 	for( ;; );
 
 	return 0;
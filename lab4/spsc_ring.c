@@ -0,0 +1,111 @@
+#include "spsc_ring.h"
+
+/*
+ * Orders the item store before the head store (producer), and the head load
+ * before the item load (consumer). The Cortex-M3 has a single core, so this
+ * only has to stop the compiler reordering; the DMB makes it safe for DMA or
+ * a second bus master as well.
+ */
+#if defined( __CC_ARM )
+#define SPSC_RING_BARRIER()    __dmb( 0xF )
+#else
+#define SPSC_RING_BARRIER()    __asm volatile( "" ::: "memory" )
+#endif
+
+/*
+ * See spsc_ring.h for comments.
+ */
+void spsc_ring_init( struct spsc_ring *ring, unsigned long *items, unsigned long size, xTaskHandle consumer )
+{
+	configASSERT( size != 0 && ( size & ( size - 1 ) ) == 0 );
+
+	ring->items = items;
+	ring->mask = size - 1;
+	ring->head = 0;
+	ring->tail = 0;
+	ring->consumer = consumer;
+	ring->waiting = 0;
+	ring->dropped = 0;
+}
+
+/*
+ * See spsc_ring.h for comments.
+ */
+int spsc_ring_put_from_isr( struct spsc_ring *ring, unsigned long item, signed portBASE_TYPE *higher_priority_task_woken )
+{
+	unsigned long head = ring->head;
+
+	if ( head - ring->tail > ring->mask )
+	{
+		++ring->dropped;
+		return 0;
+	}
+
+	ring->items[ head & ring->mask ] = item;
+	SPSC_RING_BARRIER();
+	ring->head = head + 1;
+
+	// Only the put that finds the consumer waiting sends a notification, so a
+	// burst of items costs one kernel call at most.
+	if ( ring->waiting )
+	{
+		ring->waiting = 0;
+		vTaskNotifyGiveFromISR( ring->consumer, higher_priority_task_woken );
+	}
+
+	return 1;
+}
+
+/*
+ * See spsc_ring.h for comments.
+ */
+unsigned long spsc_ring_get( struct spsc_ring *ring, unsigned long *items, unsigned long max_items )
+{
+	unsigned long tail = ring->tail;
+	unsigned long count = ring->head - tail;
+	unsigned long i;
+
+	if ( count > max_items )
+	{
+		count = max_items;
+	}
+
+	SPSC_RING_BARRIER();
+
+	for ( i = 0; i < count; ++i )
+	{
+		items[ i ] = ring->items[ ( tail + i ) & ring->mask ];
+	}
+
+	// Only hand the slots back once the items have been copied out.
+	SPSC_RING_BARRIER();
+	ring->tail = tail + count;
+
+	return count;
+}
+
+/*
+ * See spsc_ring.h for comments.
+ */
+void spsc_ring_wait( struct spsc_ring *ring )
+{
+	// waiting is set before the ring is checked, so an item put after the
+	// check always sends a notification. The notification is latched until it
+	// is taken, so it cannot be missed between the check and the take, and a
+	// stale one (sent for an item that was seen by the check) only costs one
+	// more time round the loop.
+	for ( ;; )
+	{
+		ring->waiting = 1;
+		SPSC_RING_BARRIER();
+
+		if ( ring->head != ring->tail )
+		{
+			break;
+		}
+
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+
+	ring->waiting = 0;
+}
@@ -0,0 +1,132 @@
+#ifndef __SPSC_RING__
+#define __SPSC_RING__
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Single-producer, single-consumer ring buffer for streaming words (samples,
+ * event codes, or pointers to blocks from a pool) from one interrupt handler
+ * to one task, such as the ADC conversion handler from lab2 (thermostat) or
+ * the debounce timer handler from lab3.
+ *
+ * The producer only writes head and the consumer only writes tail, so neither
+ * side needs a lock or a critical section to move data, and putting a word
+ * takes a bounded handful of instructions. The kernel is only called when the
+ * consumer has gone to sleep on an empty ring, in which case the producer
+ * wakes it with a task notification (no semaphore or event list is
+ * involved), so a burst of items costs one wake-up at most.
+ *
+ * The producer's interrupt priority must be at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, as it calls the kernel to wake the
+ * consumer. The ring uses the consumer's notification value, so the consumer
+ * must not use notifications for anything else.
+ *
+ * MEMBERS:
+ *   unsigned long *items
+ *     - Storage for the items.
+ *   unsigned long mask
+ *     - Number of items the ring holds, minus 1 (the size is a power of 2).
+ *   volatile unsigned long head
+ *     - Count of items put (only written by the producer).
+ *   volatile unsigned long tail
+ *     - Count of items taken (only written by the consumer).
+ *   xTaskHandle consumer
+ *     - Task that takes the items.
+ *   volatile unsigned long waiting
+ *     - 1 while the consumer is waiting for an item (set by the consumer,
+ *       cleared by the producer when it sends the wake-up).
+ *   volatile unsigned long dropped
+ *     - Items the producer could not put because the ring was full.
+ */
+struct spsc_ring
+{
+	unsigned long *items;
+	unsigned long mask;
+	volatile unsigned long head;
+	volatile unsigned long tail;
+	xTaskHandle consumer;
+	volatile unsigned long waiting;
+	volatile unsigned long dropped;
+};
+
+/*
+ * NAME:          spsc_ring_init
+ *
+ * DESCRIPTION:   Initialize an empty ring.
+ *
+ * PARAMETERS:
+ *  struct spsc_ring *ring
+ *    - Pointer to the ring.
+ *  unsigned long *items
+ *    - Storage for the items.
+ *  unsigned long size
+ *    - Number of items in the storage (must be a power of 2).
+ *  xTaskHandle consumer
+ *    - Task that takes the items.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void spsc_ring_init( struct spsc_ring *, unsigned long *, unsigned long, xTaskHandle );
+
+/*
+ * NAME:          spsc_ring_put_from_isr
+ *
+ * DESCRIPTION:   Put an item on the ring from the producer interrupt handler,
+ *                and wake the consumer if it is asleep on the empty ring.
+ *                Never blocks; if the ring is full the item is counted in
+ *                dropped.
+ *
+ * PARAMETERS:
+ *  struct spsc_ring *ring
+ *    - Pointer to the ring.
+ *  unsigned long item
+ *    - Item to put.
+ *  signed portBASE_TYPE *higher_priority_task_woken
+ *    - Set to pdTRUE if waking the consumer means a context switch should be
+ *      requested before the interrupt handler exits (portEND_SWITCHING_ISR).
+ *
+ * RETURNS:
+ *  int
+ *    - 1 if the item was put, 0 if the ring was full.
+ */
+int spsc_ring_put_from_isr( struct spsc_ring *, unsigned long, signed portBASE_TYPE * );
+
+/*
+ * NAME:          spsc_ring_get
+ *
+ * DESCRIPTION:   Take up to max_items items off the ring, oldest first,
+ *                without blocking. Must only be called by the consumer.
+ *
+ * PARAMETERS:
+ *  struct spsc_ring *ring
+ *    - Pointer to the ring.
+ *  unsigned long *items
+ *    - Where to copy the items to.
+ *  unsigned long max_items
+ *    - Most items to take.
+ *
+ * RETURNS:
+ *  unsigned long
+ *    - Number of items taken.
+ */
+unsigned long spsc_ring_get( struct spsc_ring *, unsigned long *, unsigned long );
+
+/*
+ * NAME:          spsc_ring_wait
+ *
+ * DESCRIPTION:   Sleep until the ring has an item in it. Returns straight
+ *                away if it already has one. Must only be called by the
+ *                consumer.
+ *
+ * PARAMETERS:
+ *  struct spsc_ring *ring
+ *    - Pointer to the ring.
+ *
+ * RETURNS:
+ *  N/A
+ */
+void spsc_ring_wait( struct spsc_ring * );
+
+#endif // __SPSC_RING__